@@ -40,15 +40,266 @@ extern "C" {
 #define PULSE_CFG_SATURATE_ELAPSED (1u)
 #endif
 
+/* Release backend used by pulse_tick_isr():
+ *   PULSE_RELEASE_SCAN:  per-task elapsed counters, the ISR visits every task.
+ *   PULSE_RELEASE_HEAP:  one global tick counter plus a min-heap of absolute
+ *                        release times; a tick with nothing due costs one
+ *                        compare against the heap head.
+ *   PULSE_RELEASE_WHEEL: hierarchical timing wheel; per-tick cost depends on
+ *                        the tasks expiring, not on the total task count.
+ */
+#define PULSE_RELEASE_SCAN  (0u)
+#define PULSE_RELEASE_HEAP  (1u)
+#define PULSE_RELEASE_WHEEL (2u)
+
+#ifndef PULSE_CFG_RELEASE_BACKEND
+#define PULSE_CFG_RELEASE_BACKEND PULSE_RELEASE_SCAN
+#endif
+
+/* Timing wheel geometry: PULSE_CFG_WHEEL_LEVELS wheels of
+ * 2^PULSE_CFG_WHEEL_BITS slots each. The innermost wheel is tick-granular;
+ * each outer wheel is 2^PULSE_CFG_WHEEL_BITS times coarser. Releases further
+ * out than the whole wheel span are parked in the outermost wheel and
+ * re-filed until they come in range.
+ */
+#ifndef PULSE_CFG_WHEEL_BITS
+#define PULSE_CFG_WHEEL_BITS (6u)
+#endif
+
+#ifndef PULSE_CFG_WHEEL_LEVELS
+#define PULSE_CFG_WHEEL_LEVELS (3u)
+#endif
+
+/* If 1, keep the ready set as a two-level bitmap (uC/OS style): one summary
+ * bit per group of 8 tasks plus one byte per group. Selecting the next task is
+ * two table lookups regardless of PULSE_MAX_TASKS, using 8-bit operations
+ * only. Required above 64 tasks; default for those builds.
+ */
+#ifndef PULSE_CFG_READY_BITMAP
+#if (PULSE_MAX_TASKS > 64u)
+#define PULSE_CFG_READY_BITMAP (1u)
+#else
+#define PULSE_CFG_READY_BITMAP (0u)
+#endif
+#endif
+
+/* If 1, pulse_poll() claims the whole ready set in one critical section and
+ * dispatches it in priority order, then retires the batch in a second one.
+ * Releases that arrive while a batch runs wait for the next batch, even if
+ * they outrank the remaining tasks of the current one; a task of the batch
+ * stays marked running until the whole batch has returned.
+ */
+#ifndef PULSE_CFG_BATCH_DISPATCH
+#define PULSE_CFG_BATCH_DISPATCH (0u)
+#endif
+
+/* If 1, store tasks as a struct of arrays inside pulse_kernel_t: the
+ * ISR-hot counters and periods are contiguous, `running` becomes a bitmask
+ * next to the ready set, and state/tick live in separate cold arrays. Removes
+ * per-task padding and keeps the tick ISR's working set small.
+ */
+#ifndef PULSE_CFG_TASK_SOA
+#define PULSE_CFG_TASK_SOA (0u)
+#endif
+
+/* If 1, pulse_start() idles through pulse_idle(): the ready set is checked
+ * with interrupts disabled and the port enables interrupts and sleeps in one
+ * atomic step, so a release can never slip in between the check and the sleep.
+ */
+#ifndef PULSE_CFG_IDLE_SLEEP
+#define PULSE_CFG_IDLE_SLEEP (0u)
+#endif
+
+/* If 1, record per-task execution time and release-to-start latency using
+ * the port's PULSE_PORT_TIMESTAMP() counter. Read with pulse_get_task_stats().
+ */
+#ifndef PULSE_CFG_STATS
+#define PULSE_CFG_STATS (0u)
+#endif
+
+/* If 1, count missed releases per task and let each task choose what a late
+ * dispatch does with them (see pulse_set_overrun_policy()).
+ */
+#ifndef PULSE_CFG_OVERRUN
+#define PULSE_CFG_OVERRUN (0u)
+#endif
+
+/* If 1, pulse_start() spreads the release phases of tasks that were added
+ * without an explicit offset so the number of releases per tick peaks as low
+ * as possible over the hyperperiod (see pulse_auto_stagger()). The hyperperiod
+ * is capped at PULSE_CFG_STAGGER_HORIZON ticks, which is also the size of the
+ * temporary load table on the stack.
+ */
+#ifndef PULSE_CFG_AUTO_STAGGER
+#define PULSE_CFG_AUTO_STAGGER (0u)
+#endif
+
+#ifndef PULSE_CFG_STAGGER_HORIZON
+#define PULSE_CFG_STAGGER_HORIZON (256u)
+#endif
+
+/* If 1, tasks come from a compile-time table instead of pulse_add_task().
+ * Define PULSE_TASK_TABLE(X) before including this header, one entry per task
+ * in priority order:
+ *
+ *   #define PULSE_TASK_TABLE(X) \
+ *       X(imu, 10u,  imu_tick, 0) \
+ *       X(log, 100u, log_tick, 0)
+ *
+ * as X(name, period_ticks, tick_fn, init_state). This header declares the
+ * tick functions, so they need external linkage. pulse_init() registers the
+ * whole table, task ids are PULSE_TASK_ID_<name>, and periods and tick
+ * functions live in code instead of RAM. With the scan backend the tick ISR
+ * is unrolled into one constant-folded release check per task.
+ *
+ * Front ends that generate the task set some other way (pulse.hpp) define
+ * PULSE_STATIC_TASKS_EXTERN instead of the table and provide the
+ * pulse_static_*() functions declared below.
+ */
+#ifndef PULSE_CFG_STATIC_TASKS
+#define PULSE_CFG_STATIC_TASKS (0u)
+#endif
+
+/* If 1, pulse_add_sporadic() registers event-triggered tasks that have no
+ * period and are released by pulse_signal_isr() instead, optionally no
+ * sooner than a minimum gap after their previous dispatch.
+ */
+#ifndef PULSE_CFG_SPORADIC
+#define PULSE_CFG_SPORADIC (0u)
+#endif
+
+/* Cross-kernel signal channels pulse_kernel_poll() watches per kernel (see
+ * pulse_xsignal_t); 0 = none. Channels release sporadic tasks, so a non-zero
+ * value needs PULSE_CFG_SPORADIC.
+ */
+#ifndef PULSE_CFG_XSIGNAL_MAX
+#define PULSE_CFG_XSIGNAL_MAX (0u)
+#endif
+
+/* If 1, every task has a dispatch priority of its own, set with
+ * pulse_set_priority() (0 = highest), instead of taking it from its id.
+ * pulse_start() sorts the tasks by priority once and moves them to matching
+ * ready-set positions, so dispatch stays a find-first-set; equal priorities
+ * keep registration order.
+ */
+#ifndef PULSE_CFG_PRIORITY
+#define PULSE_CFG_PRIORITY (0u)
+#endif
+
+/* If 1, tasks of equal priority are ordered rate-monotonic instead: shorter
+ * period first, registration order among equal periods. With no explicit
+ * priorities that is plain rate-monotonic order. Needs PULSE_CFG_PRIORITY.
+ */
+#ifndef PULSE_CFG_AUTO_RM
+#define PULSE_CFG_AUTO_RM (0u)
+#endif
+
+/* If 1, pulse_poll_budget() is available: it dispatches ready tasks until a
+ * budget of PULSE_PORT_TIMESTAMP() units has been used. pulse_poll_bounded(),
+ * which counts tasks instead, needs no flag.
+ */
+#ifndef PULSE_CFG_POLL_BUDGET
+#define PULSE_CFG_POLL_BUDGET (0u)
+#endif
+
+/* If 1, the kernel logs releases, dispatch start and end, overruns and idle
+ * sleeps as fixed-size records into a ring of PULSE_CFG_TRACE_DEPTH entries
+ * per kernel, stamped with the tick and PULSE_PORT_SUBTICK(). A task drains
+ * it with pulse_trace_read(); tools/pulse_trace.c turns the byte stream from
+ * pulse_trace_encode() into Chrome trace JSON. PULSE_CFG_TRACE_DEPTH must be a
+ * power of two.
+ */
+#ifndef PULSE_CFG_TRACE
+#define PULSE_CFG_TRACE (0u)
+#endif
+
+#ifndef PULSE_CFG_TRACE_DEPTH
+#define PULSE_CFG_TRACE_DEPTH (32u)
+#endif
+
+/* If non-zero, the tick length in microseconds that the application passes
+ * to pulse_init_us(). It is then checked at compile time against the range
+ * the port's timer can program (PULSE_PORT_TICK_US_MIN/MAX); at run time the
+ * port clamps an out-of-range tick instead. 0 leaves the tick unchecked.
+ */
+#ifndef PULSE_CFG_TICK_US
+#define PULSE_CFG_TICK_US (0u)
+#endif
+
+/* If 1, tasks can be switched off and retimed at run time, from any context:
+ * pulse_suspend() and pulse_resume(), and (without PULSE_CFG_STATIC_TASKS,
+ * whose periods are constants) pulse_set_period(). A suspended task is a bit
+ * in a per-kernel mask; the tick ISR tests it only for a task that is due.
+ */
+#ifndef PULSE_CFG_TASK_CONTROL
+#define PULSE_CFG_TASK_CONTROL (0u)
+#endif
+
+/* If 1, pulse_set_mode() switches the kernel between operating modes: const
+ * tables that give each task its period, or mark it inactive. The switch
+ * takes effect at the next tick. Inactive tasks are suspended, so this needs
+ * PULSE_CFG_TASK_CONTROL; it is not available with PULSE_CFG_STATIC_TASKS.
+ */
+#ifndef PULSE_CFG_MODES
+#define PULSE_CFG_MODES (0u)
+#endif
+
+/* If 1, a task can split a long job into slices with the PULSE_BEGIN() /
+ * PULSE_YIELD() / PULSE_WAIT_TICKS() / PULSE_END() macros, which keep the
+ * resume point in its state. A wait replaces the task's next release, so
+ * the slices are paced by the release queue. The scan backend keeps the
+ * wait in period_ticks, so it is not available there with
+ * PULSE_CFG_STATIC_TASKS.
+ */
+#ifndef PULSE_CFG_COROUTINES
+#define PULSE_CFG_COROUTINES (0u)
+#endif
+
+/* If 1, the tick ISR and pulse_poll() share the ready set through the
+ * port's atomic read-modify-write hooks (PULSE_PORT_ATOMIC_*) instead of
+ * masking interrupts: the ISR only sets bits and pulse_poll() only clears
+ * them, after marking the task running. Covers the periodic dispatch path
+ * of the scan backend with a flat ready mask and a tick interrupt; not
+ * available with overrun handling, sporadic tasks, task control or
+ * coroutines, whose updates span several fields.
+ */
+#ifndef PULSE_CFG_LOCK_FREE
+#define PULSE_CFG_LOCK_FREE (0u)
+#endif
+
+/* Unsigned type of the tick counters: periods, elapsed counts and release
+ * times. uint16_t halves the tick ISR's arithmetic on 8-bit parts and the
+ * RAM per task, and limits periods to PULSE_PERIOD_MAX (32767 ticks). At most
+ * 32 bits.
+ */
+#ifndef PULSE_CFG_TICK_T
+#define PULSE_CFG_TICK_T uint32_t
+#endif
+
+/* Integer type of a task's state value. int8_t or int16_t saves RAM for
+ * state machines with few states.
+ */
+#ifndef PULSE_CFG_STATE_T
+#define PULSE_CFG_STATE_T int32_t
+#endif
+
+/* If 1, build the tickless kernel: instead of interrupting every tick, the
+ * port programs a one-shot compare for the earliest pending release and the
+ * kernel catches up elapsed ticks from the hardware counter when it wakes.
+ */
+#ifndef PULSE_CFG_TICKLESS
+#define PULSE_CFG_TICKLESS (0u)
+#endif
+
 /* -------------------------- Compile-time guards -------------------------- */
 
 #if (PULSE_MAX_TASKS < 1u)
 #error "PULSE_MAX_TASKS must be >= 1"
 #endif
 
-/* ready_mask uses 64-bit bitset */
-#if (PULSE_MAX_TASKS > 64u)
-#error "PULSE_MAX_TASKS too large for this kernel; pick <= 64"
+/* task ids and task_count are uint8_t; 0xFF is reserved as "no task" */
+#if (PULSE_MAX_TASKS > 255u)
+#error "PULSE_MAX_TASKS too large for this kernel; pick <= 255"
 #endif
 
 #if ((PULSE_CFG_RUN_IMMEDIATELY != 0u) && (PULSE_CFG_RUN_IMMEDIATELY != 1u))
@@ -63,6 +314,155 @@ extern "C" {
 #error "PULSE_CFG_SATURATE_ELAPSED must be 0 or 1"
 #endif
 
+#if ((PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN) && \
+     (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_HEAP) && \
+     (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_WHEEL))
+#error "PULSE_CFG_RELEASE_BACKEND must be PULSE_RELEASE_SCAN, PULSE_RELEASE_HEAP or PULSE_RELEASE_WHEEL"
+#endif
+
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+#if ((PULSE_CFG_WHEEL_BITS < 1u) || (PULSE_CFG_WHEEL_BITS > 8u))
+#error "PULSE_CFG_WHEEL_BITS must be in 1..8"
+#endif
+#if ((PULSE_CFG_WHEEL_LEVELS < 1u) || ((PULSE_CFG_WHEEL_BITS * PULSE_CFG_WHEEL_LEVELS) > 31u))
+#error "PULSE_CFG_WHEEL_LEVELS must be >= 1 and the wheel span must stay below 2^31 ticks"
+#endif
+#endif
+
+#if ((PULSE_CFG_READY_BITMAP != 0u) && (PULSE_CFG_READY_BITMAP != 1u))
+#error "PULSE_CFG_READY_BITMAP must be 0 or 1"
+#endif
+
+/* the flat ready_mask is at most a uint64_t */
+#if ((PULSE_MAX_TASKS > 64u) && (PULSE_CFG_READY_BITMAP == 0u))
+#error "PULSE_MAX_TASKS > 64 requires PULSE_CFG_READY_BITMAP"
+#endif
+
+#if ((PULSE_CFG_BATCH_DISPATCH != 0u) && (PULSE_CFG_BATCH_DISPATCH != 1u))
+#error "PULSE_CFG_BATCH_DISPATCH must be 0 or 1"
+#endif
+
+#if ((PULSE_CFG_TASK_SOA != 0u) && (PULSE_CFG_TASK_SOA != 1u))
+#error "PULSE_CFG_TASK_SOA must be 0 or 1"
+#endif
+
+#if ((PULSE_CFG_IDLE_SLEEP != 0u) && (PULSE_CFG_IDLE_SLEEP != 1u))
+#error "PULSE_CFG_IDLE_SLEEP must be 0 or 1"
+#endif
+
+#if ((PULSE_CFG_STATS != 0u) && (PULSE_CFG_STATS != 1u))
+#error "PULSE_CFG_STATS must be 0 or 1"
+#endif
+
+#if ((PULSE_CFG_OVERRUN != 0u) && (PULSE_CFG_OVERRUN != 1u))
+#error "PULSE_CFG_OVERRUN must be 0 or 1"
+#endif
+
+#if ((PULSE_CFG_STATIC_TASKS != 0u) && (PULSE_CFG_STATIC_TASKS != 1u))
+#error "PULSE_CFG_STATIC_TASKS must be 0 or 1"
+#endif
+
+#if ((PULSE_CFG_STATIC_TASKS == 1u) && !defined(PULSE_TASK_TABLE) && !defined(PULSE_STATIC_TASKS_EXTERN))
+#error "PULSE_CFG_STATIC_TASKS requires PULSE_TASK_TABLE(X)"
+#endif
+
+#if ((PULSE_CFG_SPORADIC != 0u) && (PULSE_CFG_SPORADIC != 1u))
+#error "PULSE_CFG_SPORADIC must be 0 or 1"
+#endif
+
+#if ((PULSE_CFG_SPORADIC == 1u) && (PULSE_CFG_STATIC_TASKS == 1u))
+#error "PULSE_CFG_SPORADIC needs runtime registration (PULSE_CFG_STATIC_TASKS=0)"
+#endif
+
+#if ((PULSE_CFG_AUTO_STAGGER != 0u) && (PULSE_CFG_AUTO_STAGGER != 1u))
+#error "PULSE_CFG_AUTO_STAGGER must be 0 or 1"
+#endif
+
+#if ((PULSE_CFG_STAGGER_HORIZON < 1u) || (PULSE_CFG_STAGGER_HORIZON > 4096u))
+#error "PULSE_CFG_STAGGER_HORIZON must be in 1..4096"
+#endif
+
+#if (PULSE_CFG_XSIGNAL_MAX > 32u)
+#error "PULSE_CFG_XSIGNAL_MAX must be in range 0..32"
+#endif
+
+#if ((PULSE_CFG_XSIGNAL_MAX > 0u) && (PULSE_CFG_SPORADIC == 0u))
+#error "PULSE_CFG_XSIGNAL_MAX requires PULSE_CFG_SPORADIC=1"
+#endif
+
+#if ((PULSE_CFG_PRIORITY != 0u) && (PULSE_CFG_PRIORITY != 1u))
+#error "PULSE_CFG_PRIORITY must be 0 or 1"
+#endif
+
+#if ((PULSE_CFG_PRIORITY == 1u) && (PULSE_CFG_STATIC_TASKS == 1u))
+#error "PULSE_CFG_PRIORITY needs runtime registration (PULSE_CFG_STATIC_TASKS=0); order the table instead"
+#endif
+
+#if ((PULSE_CFG_AUTO_RM != 0u) && (PULSE_CFG_AUTO_RM != 1u))
+#error "PULSE_CFG_AUTO_RM must be 0 or 1"
+#endif
+
+#if ((PULSE_CFG_AUTO_RM == 1u) && (PULSE_CFG_PRIORITY == 0u))
+#error "PULSE_CFG_AUTO_RM requires PULSE_CFG_PRIORITY=1"
+#endif
+
+#if ((PULSE_CFG_POLL_BUDGET != 0u) && (PULSE_CFG_POLL_BUDGET != 1u))
+#error "PULSE_CFG_POLL_BUDGET must be 0 or 1"
+#endif
+
+#if ((PULSE_CFG_TRACE != 0u) && (PULSE_CFG_TRACE != 1u))
+#error "PULSE_CFG_TRACE must be 0 or 1"
+#endif
+
+#if ((PULSE_CFG_TRACE == 1u) && ((PULSE_CFG_TRACE_DEPTH < 2u) || (PULSE_CFG_TRACE_DEPTH > 32768u) || \
+                                  ((PULSE_CFG_TRACE_DEPTH & (PULSE_CFG_TRACE_DEPTH - 1u)) != 0u)))
+#error "PULSE_CFG_TRACE_DEPTH must be a power of two in range 2..32768"
+#endif
+
+#if ((PULSE_CFG_TASK_CONTROL != 0u) && (PULSE_CFG_TASK_CONTROL != 1u))
+#error "PULSE_CFG_TASK_CONTROL must be 0 or 1"
+#endif
+
+#if ((PULSE_CFG_MODES != 0u) && (PULSE_CFG_MODES != 1u))
+#error "PULSE_CFG_MODES must be 0 or 1"
+#endif
+
+#if ((PULSE_CFG_MODES == 1u) && (PULSE_CFG_TASK_CONTROL == 0u))
+#error "PULSE_CFG_MODES requires PULSE_CFG_TASK_CONTROL"
+#endif
+
+#if ((PULSE_CFG_MODES == 1u) && (PULSE_CFG_STATIC_TASKS == 1u))
+#error "PULSE_CFG_MODES is not supported with PULSE_CFG_STATIC_TASKS"
+#endif
+
+#if ((PULSE_CFG_COROUTINES != 0u) && (PULSE_CFG_COROUTINES != 1u))
+#error "PULSE_CFG_COROUTINES must be 0 or 1"
+#endif
+
+#if ((PULSE_CFG_COROUTINES == 1u) && (PULSE_CFG_STATIC_TASKS == 1u) && \
+     (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_SCAN))
+#error "PULSE_CFG_COROUTINES with PULSE_CFG_STATIC_TASKS needs the heap or wheel backend"
+#endif
+
+#if ((PULSE_CFG_TICKLESS != 0u) && (PULSE_CFG_TICKLESS != 1u))
+#error "PULSE_CFG_TICKLESS must be 0 or 1"
+#endif
+
+#if ((PULSE_CFG_LOCK_FREE != 0u) && (PULSE_CFG_LOCK_FREE != 1u))
+#error "PULSE_CFG_LOCK_FREE must be 0 or 1"
+#endif
+
+#if (PULSE_CFG_LOCK_FREE == 1u)
+#if ((PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN) || (PULSE_CFG_TICKLESS == 1u) || \
+     (PULSE_CFG_READY_BITMAP == 1u))
+#error "PULSE_CFG_LOCK_FREE needs the scan backend with a tick interrupt and a flat ready mask"
+#endif
+#if ((PULSE_CFG_OVERRUN == 1u) || (PULSE_CFG_SPORADIC == 1u) || (PULSE_CFG_TASK_CONTROL == 1u) || \
+     (PULSE_CFG_COROUTINES == 1u))
+#error "PULSE_CFG_LOCK_FREE is not supported with PULSE_CFG_OVERRUN, PULSE_CFG_SPORADIC, PULSE_CFG_TASK_CONTROL or PULSE_CFG_COROUTINES"
+#endif
+#endif
+
 /* -------------------------- Port contract -------------------------- */
 /* A port header MUST define these. */
 #ifndef PULSE_PORT_ENTER_CRITICAL
@@ -71,259 +471,3988 @@ extern "C" {
 #ifndef PULSE_PORT_EXIT_CRITICAL
 #error "Pulse port missing: PULSE_PORT_EXIT_CRITICAL()"
 #endif
+/* PULSE_PORT_TIMER_INIT_US(tick_us) starts the tick timer. A port written
+ * for whole milliseconds may define PULSE_PORT_TIMER_INIT(tick_ms) instead;
+ * it gets the tick rounded to the nearest millisecond, at least 1.
+ */
+#ifndef PULSE_PORT_TIMER_INIT_US
 #ifndef PULSE_PORT_TIMER_INIT
-#error "Pulse port missing: PULSE_PORT_TIMER_INIT(tick_ms)"
+#error "Pulse port missing: PULSE_PORT_TIMER_INIT_US(tick_us)"
+#endif
+#define PULSE_PORT_TIMER_INIT_US(tick_us) \
+    PULSE_PORT_TIMER_INIT(((tick_us) < 1500u) ? 1u : (((tick_us) / 1000u) + ((((tick_us) % 1000u) >= 500u) ? 1u : 0u)))
 #endif
 #ifndef PULSE_PORT_ENABLE_GLOBAL_IRQ
 #error "Pulse port missing: PULSE_PORT_ENABLE_GLOBAL_IRQ()"
 #endif
-#ifndef PULSE_PORT_DISABLE_GLOBAL_IRQ
-#error "Pulse port missing: PULSE_PORT_DISABLE_GLOBAL_IRQ()"
+#ifndef PULSE_PORT_DISABLE_GLOBAL_IRQ
+#error "Pulse port missing: PULSE_PORT_DISABLE_GLOBAL_IRQ()"
+#endif
+
+#ifndef PULSE_PORT_IDLE_HOOK
+#define PULSE_PORT_IDLE_HOOK() do { } while (0)
+#endif
+
+/* Optional: PULSE_PORT_TICK_US_MIN and PULSE_PORT_TICK_US_MAX, preprocessor
+ * constants bounding the tick the timer can program, which PULSE_CFG_TICK_US
+ * is checked against.
+ */
+#if (PULSE_CFG_TICK_US != 0u) && defined(PULSE_PORT_TICK_US_MIN) && defined(PULSE_PORT_TICK_US_MAX)
+#if ((PULSE_CFG_TICK_US < PULSE_PORT_TICK_US_MIN) || (PULSE_CFG_TICK_US > PULSE_PORT_TICK_US_MAX))
+#error "PULSE_CFG_TICK_US is outside the range of the port's tick timer (PULSE_PORT_TICK_US_MIN..MAX)"
+#endif
+#endif
+
+/* Optional: PULSE_PORT_CTZ(x) returns the index of the lowest set bit of a
+ * non-zero unsigned value no wider than 64 bits (e.g. __builtin_ctzll, or
+ * RBIT+CLZ on Cortex-M). Without it the kernel resolves the bit a byte at a
+ * time through a de Bruijn table.
+ */
+
+/* Tickless builds additionally need a free-running counter with a one-shot
+ * compare:
+ *   PULSE_PORT_TIMER_ELAPSED()      -> uint32_t whole ticks since the previous
+ *                                      call; the port keeps the sub-tick rest.
+ *   PULSE_PORT_TIMER_SET_NEXT(ticks) program the compare to fire `ticks` ticks
+ *                                      after the last whole tick returned by
+ *                                      PULSE_PORT_TIMER_ELAPSED(); the port
+ *                                      clamps to its hardware range.
+ * Both are called with interrupts disabled.
+ */
+#if (PULSE_CFG_TICKLESS == 1u)
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+#error "PULSE_CFG_TICKLESS is not supported with PULSE_RELEASE_WHEEL"
+#endif
+#ifndef PULSE_PORT_TIMER_ELAPSED
+#error "Pulse port missing: PULSE_PORT_TIMER_ELAPSED() (required by PULSE_CFG_TICKLESS)"
+#endif
+#ifndef PULSE_PORT_TIMER_SET_NEXT
+#error "Pulse port missing: PULSE_PORT_TIMER_SET_NEXT(ticks) (required by PULSE_CFG_TICKLESS)"
+#endif
+#endif
+
+/* Idle-sleep builds need:
+ *   PULSE_PORT_SLEEP_ENABLE_IRQ()   called with interrupts disabled; enables
+ *                                   them and enters sleep atomically (e.g.
+ *                                   `sei; sleep` on AVR), and returns after
+ *                                   the wake-up interrupt has run.
+ */
+#if (PULSE_CFG_IDLE_SLEEP == 1u)
+#ifndef PULSE_PORT_SLEEP_ENABLE_IRQ
+#error "Pulse port missing: PULSE_PORT_SLEEP_ENABLE_IRQ() (required by PULSE_CFG_IDLE_SLEEP)"
+#endif
+#endif
+
+/* Cross-kernel signal builds (PULSE_CFG_XSIGNAL_MAX > 0) use:
+ *   PULSE_PORT_WORD_T               unsigned type the target loads and
+ *                                   stores in one instruction (default
+ *                                   uint8_t).
+ *   PULSE_PORT_MEMORY_BARRIER()     orders the data handed over with a
+ *                                   signal against the signal itself; must
+ *                                   be a hardware fence (`dmb`) when the
+ *                                   kernels run on different cores.
+ *   PULSE_PORT_XSIGNAL_NOTIFY(ch)   optional: wake the receiving kernel, e.g.
+ *                                   raise an inter-core interrupt. Without
+ *                                   it a sleeping receiver sees the signal
+ *                                   after its next tick.
+ */
+#if (PULSE_CFG_XSIGNAL_MAX > 0u)
+#ifndef PULSE_PORT_WORD_T
+#define PULSE_PORT_WORD_T uint8_t
+#endif
+#ifndef PULSE_PORT_MEMORY_BARRIER
+#if defined(__GNUC__)
+#define PULSE_PORT_MEMORY_BARRIER() do { __asm volatile ("" ::: "memory"); } while (0)
+#else
+#error "Pulse port missing: PULSE_PORT_MEMORY_BARRIER() (required by PULSE_CFG_XSIGNAL_MAX)"
+#endif
+#endif
+#ifndef PULSE_PORT_XSIGNAL_NOTIFY
+#define PULSE_PORT_XSIGNAL_NOTIFY(ch) do { (void)(ch); } while (0)
+#endif
+#endif
+
+/* Lock-free builds (PULSE_CFG_LOCK_FREE) need atomic access to one word
+ * shared by the tick ISR and main context:
+ *   PULSE_PORT_ATOMIC_T             type of the word (e.g. `volatile
+ *                                   uint32_t`, or `atomic_uint_least32_t`).
+ *   PULSE_PORT_ATOMIC_BITS          its width, at least PULSE_MAX_TASKS.
+ *   PULSE_PORT_ATOMIC_LOAD(p)       -> value of *p.
+ *   PULSE_PORT_ATOMIC_STORE(p, v)   *p = v.
+ *   PULSE_PORT_ATOMIC_FETCH_OR(p, v)   *p |= v as one indivisible step
+ *   PULSE_PORT_ATOMIC_FETCH_AND(p, v)  and *p &= v; both return the old
+ *                                      value (LDREX/STREX on Cortex-M).
+ * FETCH_OR and FETCH_AND are also compiler barriers. The ISR and
+ * pulse_poll() share a core, so no hardware fence is needed.
+ */
+#if (PULSE_CFG_LOCK_FREE == 1u)
+#if !defined(PULSE_PORT_ATOMIC_T) || !defined(PULSE_PORT_ATOMIC_BITS) || !defined(PULSE_PORT_ATOMIC_LOAD) || \
+    !defined(PULSE_PORT_ATOMIC_STORE) || !defined(PULSE_PORT_ATOMIC_FETCH_OR) || !defined(PULSE_PORT_ATOMIC_FETCH_AND)
+#error "Pulse port missing: PULSE_PORT_ATOMIC_* (required by PULSE_CFG_LOCK_FREE)"
+#elif (PULSE_MAX_TASKS > PULSE_PORT_ATOMIC_BITS)
+#error "PULSE_CFG_LOCK_FREE needs PULSE_MAX_TASKS <= PULSE_PORT_ATOMIC_BITS"
+#endif
+#endif
+
+/* Statistics and poll-budget builds need:
+ *   PULSE_PORT_TIMESTAMP()          -> free-running counter of type
+ *                                      PULSE_PORT_STAMP_T (default uint32_t)
+ *                                      that wraps modulo its width; callable
+ *                                      from both the ISR and main context.
+ */
+#if (PULSE_CFG_STATS == 1u) || (PULSE_CFG_POLL_BUDGET == 1u)
+#ifndef PULSE_PORT_TIMESTAMP
+#error "Pulse port missing: PULSE_PORT_TIMESTAMP() (required by PULSE_CFG_STATS and PULSE_CFG_POLL_BUDGET)"
+#endif
+#ifndef PULSE_PORT_STAMP_T
+#define PULSE_PORT_STAMP_T uint32_t
+#endif
+#endif
+
+/* Trace builds may define:
+ *   PULSE_PORT_SUBTICK()            -> uint16_t timer count since the current
+ *                                      tick began, so events inside one tick
+ *                                      can be placed in time (default 0).
+ */
+#if (PULSE_CFG_TRACE == 1u)
+#ifndef PULSE_PORT_SUBTICK
+#define PULSE_PORT_SUBTICK() (0u)
+#endif
+#endif
+
+/* -------------------------- Types -------------------------- */
+
+typedef PULSE_CFG_STATE_T pulse_state_t;
+
+typedef PULSE_CFG_TICK_T pulse_tick_t;
+
+/* Largest tick value, and the longest period (or guard) every backend
+ * accepts: the heap and wheel compare release times by the sign of their
+ * difference, so they need half the range. The scan backend takes periods
+ * up to PULSE_TICK_MAX at run time.
+ */
+#define PULSE_TICK_MAX   ((pulse_tick_t)~(pulse_tick_t)0)
+#define PULSE_PERIOD_MAX ((pulse_tick_t)(PULSE_TICK_MAX >> 1u))
+#define PULSE_TICK_SIGN  ((pulse_tick_t)(PULSE_PERIOD_MAX + 1u))
+
+typedef char pulse_cfg_tick_t_must_be_unsigned_and_at_most_32_bits[
+    ((PULSE_TICK_MAX > 0u) && (sizeof(pulse_tick_t) <= sizeof(uint32_t))) ? 1 : -1];
+
+/* Fails to compile if a constant period does not fit in pulse_tick_t on
+ * every backend. For periods passed to pulse_add_task() and friends, which
+ * check only at run time; `name` makes the check unique.
+ */
+#define PULSE_PERIOD_CHECK(name, period) \
+    typedef char pulse_period_fits_##name[(((period) > 0u) && ((period) <= PULSE_PERIOD_MAX)) ? 1 : -1]
+
+typedef pulse_state_t (*pulse_tick_f)(pulse_state_t state);
+
+#if ((PULSE_CFG_STATIC_TASKS == 1u) && defined(PULSE_TASK_TABLE))
+/* Task ids of the static table, in table order. */
+#define PULSE_X_TASK_ID(name, period, tick, init) PULSE_TASK_ID_##name,
+enum
+{
+    PULSE_TASK_TABLE(PULSE_X_TASK_ID)
+    PULSE_STATIC_TASK_COUNT
+};
+#undef PULSE_X_TASK_ID
+
+/* Fail to compile if the table does not fit in PULSE_MAX_TASKS or a period
+ * is out of the range pulse_add_task() accepts.
+ */
+typedef char pulse_static_tasks_fit_t[(PULSE_STATIC_TASK_COUNT <= PULSE_MAX_TASKS) ? 1 : -1];
+
+#define PULSE_X_TASK_CHECK(name, period, tick, init) \
+    typedef char pulse_static_period_ok_##name[(((period) > 0u) && ((period) <= PULSE_PERIOD_MAX)) ? 1 : -1];
+PULSE_TASK_TABLE(PULSE_X_TASK_CHECK)
+#undef PULSE_X_TASK_CHECK
+
+/* Tick functions of the table, with external linkage. */
+#define PULSE_X_TASK_DECL(name, period, tick, init) pulse_state_t tick(pulse_state_t state);
+PULSE_TASK_TABLE(PULSE_X_TASK_DECL)
+#undef PULSE_X_TASK_DECL
+#elif (PULSE_CFG_STATIC_TASKS == 1u)
+/* Task set provided by the includer, ids 0..pulse_static_count()-1. */
+uint8_t pulse_static_count(void);
+pulse_tick_t pulse_static_period(uint8_t id);
+pulse_state_t pulse_static_dispatch(uint8_t id, pulse_state_t state);
+pulse_state_t pulse_static_init_state(uint8_t id);
+#endif
+
+#if (PULSE_CFG_STATS == 1u) || (PULSE_CFG_POLL_BUDGET == 1u)
+typedef PULSE_PORT_STAMP_T pulse_stamp_t;
+#endif
+
+#if (PULSE_CFG_STATS == 1u)
+/* Per-task measurements, in PULSE_PORT_TIMESTAMP() units. */
+typedef struct
+{
+    uint32_t      runs;        /* completed dispatches */
+    pulse_stamp_t exec_min;    /* shortest tick() call */
+    pulse_stamp_t exec_max;    /* longest tick() call */
+    uint64_t      exec_total;  /* sum of all tick() calls */
+    pulse_stamp_t latency_max; /* longest delay from release to start */
+} pulse_task_stats_t;
+#endif
+
+#if (PULSE_CFG_OVERRUN == 1u)
+/* What a dispatch does with the releases it missed:
+ *   PULSE_OVERRUN_SKIP:    drop them; the next period counts from this
+ *                          dispatch (the default, same as without overrun
+ *                          tracking).
+ *   PULSE_OVERRUN_PHASE:   drop them but stay on the original release grid,
+ *                          so the next release is not shifted by the delay.
+ *   PULSE_OVERRUN_CATCHUP: stay on the grid and run up to `catchup_max` of
+ *                          the missed releases back-to-back.
+ */
+#define PULSE_OVERRUN_SKIP    (0u)
+#define PULSE_OVERRUN_PHASE   (1u)
+#define PULSE_OVERRUN_CATCHUP (2u)
+#endif
+
+#if (PULSE_CFG_TRACE == 1u)
+/* Trace events. Events that take no time carry a value in `sub` instead of
+ * the sub-tick count.
+ */
+#define PULSE_TRACE_START   (0u) /* pulse_start(); sub = tick length, see below */
+#define PULSE_TRACE_RELEASE (1u) /* task became ready */
+#define PULSE_TRACE_RUN     (2u) /* tick() called */
+#define PULSE_TRACE_DONE    (3u) /* tick() returned */
+#define PULSE_TRACE_OVERRUN (4u) /* sub = releases missed by this dispatch */
+#define PULSE_TRACE_IDLE    (5u) /* about to sleep */
+#define PULSE_TRACE_WAKE    (6u) /* sleep ended */
+#define PULSE_TRACE_LOST    (7u) /* sub = records dropped on a full ring */
+
+#define PULSE_TRACE_NO_TASK   (0xFFu)
+#define PULSE_TRACE_WIRE_SIZE (8u)
+
+/* The START record's tick length: microseconds below 32768, otherwise
+ * PULSE_TRACE_TICK_MS | milliseconds (saturating at 32767 ms).
+ */
+#define PULSE_TRACE_TICK_MS (0x8000u)
+
+typedef struct
+{
+    uint32_t tick;  /* tick the event happened in */
+    uint16_t sub;   /* PULSE_PORT_SUBTICK(), or the event's value */
+    uint8_t  event; /* PULSE_TRACE_* */
+    uint8_t  id;    /* task id, PULSE_TRACE_NO_TASK for kernel events */
+} pulse_trace_rec_t;
+#endif
+
+#if (PULSE_CFG_PRIORITY == 1u)
+/* Priority of a task nobody has called pulse_set_priority() for. */
+#define PULSE_PRIO_DEFAULT (128u)
+#endif
+
+#if (PULSE_CFG_MODES == 1u)
+/* Special entries in a mode's period table. */
+#define PULSE_MODE_OFF  (0u)          /* inactive in this mode */
+#define PULSE_MODE_KEEP (0xFFFFFFFFu) /* active, period left as it is */
+
+/* One operating mode: the period of each task, indexed by task id. Ids at
+ * or past `count` are inactive. The kernel keeps a pointer to the mode, so
+ * it is normally a const table that lives for the whole program.
+ */
+typedef struct
+{
+    const uint32_t *periods;
+    uint8_t         count;
+} pulse_mode_t;
+#endif
+
+#if (((PULSE_CFG_TASK_CONTROL == 1u) || (PULSE_CFG_COROUTINES == 1u)) && \
+     (PULSE_CFG_STATIC_TASKS == 0u) && (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_SCAN))
+/* The scan backend measures a period from the last dispatch, so a new one
+ * waits in period_next until the next dispatch. A coroutine wait borrows
+ * period_ticks the same way.
+ */
+#define PULSE_PERIOD_DEFERRED (1u)
+#else
+#define PULSE_PERIOD_DEFERRED (0u)
+#endif
+
+/* Per-task record. With PULSE_CFG_TASK_SOA the same fields are stored as
+ * parallel arrays in pulse_kernel_t instead.
+ */
+typedef struct
+{
+    uint8_t       running;       /* 0 = not running, 1 = running */
+    pulse_state_t state;         /* task state for state-machine style tasks */
+#if (PULSE_CFG_STATIC_TASKS == 0u)
+    pulse_tick_t  period_ticks;  /* task period in ticks (must be > 0) */
+#endif
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    pulse_tick_t  next_release;  /* absolute tick of the next release */
+#else
+    pulse_tick_t  elapsed_ticks; /* elapsed ticks since last run */
+#endif
+#if (PULSE_CFG_STATIC_TASKS == 0u)
+    pulse_tick_f  tick;          /* tick function */
+#endif
+#if (PULSE_PERIOD_DEFERRED == 1u)
+    pulse_tick_t  period_next;   /* period_ticks from the next dispatch on */
+#endif
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+    uint8_t       wheel_next;    /* next task in the same wheel slot, 0xFF = end */
+#endif
+#if (PULSE_CFG_SPORADIC == 1u)
+    uint8_t       kind;          /* PULSE_KIND_*; period is the guard if sporadic */
+#endif
+#if (PULSE_CFG_OVERRUN == 1u)
+    uint32_t      overruns;      /* missed releases, saturating */
+    uint8_t       overrun_policy;
+    uint8_t       catchup_max;
+    uint8_t       catchup_pending; /* catch-up runs still owed */
+#endif
+} pulse_task_t;
+
+/* Flat ready mask: bit i set => task i ready. Natively sized so small task
+ * sets never pay for 64-bit arithmetic on 8/16-bit cores.
+ */
+#if (PULSE_MAX_TASKS <= 8u)
+typedef uint8_t  pulse_mask_t;
+#elif (PULSE_MAX_TASKS <= 16u)
+typedef uint16_t pulse_mask_t;
+#elif (PULSE_MAX_TASKS <= 32u)
+typedef uint32_t pulse_mask_t;
+#else
+typedef uint64_t pulse_mask_t;
+#endif
+
+#if (PULSE_CFG_READY_BITMAP == 1u)
+#define PULSE_READY_GROUPS ((PULSE_MAX_TASKS + 7u) / 8u)
+
+/* Summary word: one bit per group of 8 tasks. */
+#if (PULSE_READY_GROUPS <= 8u)
+typedef uint8_t  pulse_ready_grp_t;
+#elif (PULSE_READY_GROUPS <= 16u)
+typedef uint16_t pulse_ready_grp_t;
+#else
+typedef uint32_t pulse_ready_grp_t;
+#endif
+#endif
+
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+#define PULSE_WHEEL_SLOTS (1u << PULSE_CFG_WHEEL_BITS)
+#endif
+
+#if (PULSE_CFG_XSIGNAL_MAX > 0u)
+/* One-way signal into a sporadic task of another kernel. The sender only
+ * ever writes `sent` and the receiving kernel only `seen`, so neither side
+ * takes a lock or masks the other's interrupts. Signals sent before the
+ * receiver looks are merged, as with pulse_signal_isr().
+ */
+typedef struct
+{
+    volatile PULSE_PORT_WORD_T sent;    /* bumped by the sender */
+    PULSE_PORT_WORD_T          seen;    /* last count the receiver acted on */
+    uint8_t                    task_id; /* receiving task */
+} pulse_xsignal_t;
+#endif
+
+typedef struct
+{
+#if (PULSE_CFG_TASK_SOA == 1u)
+    /* Hot: touched by pulse_tick_isr() */
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    pulse_tick_t next_release[PULSE_MAX_TASKS];
+#else
+    pulse_tick_t elapsed_ticks[PULSE_MAX_TASKS];
+#endif
+#if (PULSE_CFG_STATIC_TASKS == 0u)
+    pulse_tick_t period_ticks[PULSE_MAX_TASKS];
+#endif
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+    uint8_t      wheel_next[PULSE_MAX_TASKS];
+#endif
+#if (PULSE_CFG_SPORADIC == 1u)
+    uint8_t      kind[PULSE_MAX_TASKS];
+#endif
+
+    /* Cold: touched only when a task is dispatched */
+    pulse_state_t state[PULSE_MAX_TASKS];
+#if (PULSE_CFG_STATIC_TASKS == 0u)
+    pulse_tick_f tick[PULSE_MAX_TASKS];
+#endif
+#if (PULSE_PERIOD_DEFERRED == 1u)
+    pulse_tick_t period_next[PULSE_MAX_TASKS];
+#endif
+#if (PULSE_CFG_OVERRUN == 1u)
+    uint32_t     overruns[PULSE_MAX_TASKS];
+    uint8_t      overrun_policy[PULSE_MAX_TASKS];
+    uint8_t      catchup_max[PULSE_MAX_TASKS];
+    uint8_t      catchup_pending[PULSE_MAX_TASKS];
+#endif
+#else
+    pulse_task_t tasks[PULSE_MAX_TASKS];
+#endif
+#if (PULSE_CFG_STATIC_TASKS == 0u)
+    uint8_t      task_count;
+#endif
+
+    /* Ready bitmask: bit i set => task i is ready to run.
+     * ISR sets bits; pulse_poll() clears and runs tasks.
+     */
+#if (PULSE_CFG_READY_BITMAP == 1u)
+    /* Two-level form: bit g of ready_grp set => ready_tbl[g] != 0. */
+    pulse_ready_grp_t ready_grp;
+    uint8_t      ready_tbl[PULSE_READY_GROUPS];
+#elif (PULSE_CFG_LOCK_FREE == 1u)
+    PULSE_PORT_ATOMIC_T ready_mask;
+#else
+    pulse_mask_t ready_mask;
+#endif
+
+#if (PULSE_CFG_TASK_SOA == 1u)
+    /* Running bitmask, same bit layout as the ready set. */
+#if (PULSE_CFG_READY_BITMAP == 1u)
+    uint8_t      running_tbl[PULSE_READY_GROUPS];
+#else
+    pulse_mask_t running_mask;
+#endif
+#endif
+
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    /* Global tick counter: the last tick processed by pulse_tick_isr(). */
+    pulse_tick_t now;
+#endif
+
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+    /* Min-heap of task ids keyed by next_release. A task is in the heap only
+     * while it waits for its next release.
+     */
+    uint8_t      release_heap[PULSE_MAX_TASKS];
+    uint8_t      release_count;
+#endif
+
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+    /* Slot list heads, 0xFF = empty. A task is filed in exactly one slot
+     * while it waits for its next release.
+     */
+    uint8_t      wheel[PULSE_CFG_WHEEL_LEVELS][PULSE_WHEEL_SLOTS];
+#endif
+
+#if (PULSE_CFG_STATS == 1u)
+    pulse_stamp_t      release_stamp[PULSE_MAX_TASKS];
+    pulse_task_stats_t stats[PULSE_MAX_TASKS];
+#endif
+
+#if (PULSE_CFG_AUTO_STAGGER == 1u)
+    /* Bit per task: phase given explicitly, leave it alone. */
+    uint8_t      phase_fixed[(PULSE_MAX_TASKS + 7u) / 8u];
+#endif
+
+#if (PULSE_CFG_TASK_CONTROL == 1u)
+    /* Bit per task: suspended. On the heap and wheel backends, also a
+     * release that fell due while suspended and is delivered on resume; the
+     * scan backend keeps that in elapsed_ticks.
+     */
+    uint8_t      suspended[(PULSE_MAX_TASKS + 7u) / 8u];
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    uint8_t      held[(PULSE_MAX_TASKS + 7u) / 8u];
+#endif
+#endif
+
+#if (PULSE_CFG_MODES == 1u)
+    const pulse_mode_t *mode;      /* last mode switched to, NULL before any */
+    const pulse_mode_t *mode_next; /* requested, taken by the next tick */
+#endif
+
+#if (PULSE_CFG_COROUTINES == 1u)
+    /* Bit per task: between two slices of a job, released by its wait
+     * rather than its period. Sporadic tasks wait as signalled instead.
+     */
+    uint8_t      waiting[(PULSE_MAX_TASKS + 7u) / 8u];
+    uint8_t      current;          /* task being run, 0xFF = none */
+#endif
+
+#if (PULSE_CFG_XSIGNAL_MAX > 0u)
+    pulse_xsignal_t *xsignal[PULSE_CFG_XSIGNAL_MAX];
+    uint8_t      xsignal_count;
+#endif
+
+#if (PULSE_CFG_TRACE == 1u)
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_SCAN)
+    uint32_t          trace_now;  /* ticks seen; the other backends keep `now` */
+#endif
+    pulse_trace_rec_t trace[PULSE_CFG_TRACE_DEPTH];
+    uint16_t          trace_head; /* records written, free-running */
+    uint16_t          trace_tail; /* records read, free-running */
+    uint16_t          trace_lost; /* dropped since the last LOST record */
+#endif
+
+#if (PULSE_CFG_PRIORITY == 1u)
+    /* Every per-task field above is indexed by ready-set position. Positions
+     * equal ids until pulse_apply_priorities() sorts them; the API takes ids.
+     */
+    uint8_t      task_pos[PULSE_MAX_TASKS]; /* id -> position */
+    uint8_t      pos_task[PULSE_MAX_TASKS]; /* position -> id */
+    uint8_t      priority[PULSE_MAX_TASKS]; /* by id */
+#endif
+
+    uint8_t      started;
+
+    uint32_t     tick_us;
+} pulse_kernel_t;
+
+/* -------------------------- API -------------------------- */
+
+/* With PULSE_CFG_STATIC_TASKS, also registers every task of the table. */
+void pulse_init(uint32_t tick_ms);
+
+/* As pulse_init(), with the tick in microseconds. The port picks the timer
+ * prescaler and compare value; a tick the timer cannot reach is clamped to
+ * its range (see PULSE_CFG_TICK_US for a compile-time check).
+ */
+void pulse_init_us(uint32_t tick_us);
+
+#if (PULSE_CFG_STATIC_TASKS == 0u)
+int32_t pulse_add_task(pulse_state_t init_state,
+                       uint32_t period_ticks,
+                       pulse_tick_f tick);
+
+/* As pulse_add_task(), with the first release `offset_ticks` ticks from now
+ * (0 = release immediately, period_ticks = after one full period).
+ * Returns -1 if offset_ticks > period_ticks, otherwise as pulse_add_task().
+ */
+int32_t pulse_add_task_ex(pulse_state_t init_state,
+                          uint32_t period_ticks,
+                          uint32_t offset_ticks,
+                          pulse_tick_f tick);
+
+#if (PULSE_CFG_SPORADIC == 1u)
+/* Registers an event-triggered task. It is released only by
+ * pulse_signal_isr(), and at the earliest `min_gap_ticks` after its previous
+ * dispatch (0 = no guard). Signals that arrive inside the guard, or while the
+ * task is already ready, are merged into one release. Dispatch priority
+ * follows registration order as for periodic tasks.
+ * Returns as pulse_add_task(); min_gap_ticks may be 0.
+ */
+int32_t pulse_add_sporadic(pulse_state_t init_state,
+                           uint32_t min_gap_ticks,
+                           pulse_tick_f tick);
+
+/* Releases sporadic task `id`. Constant time apart from one heap insertion
+ * on the heap backend; callable from any interrupt that may use the kernel's
+ * critical sections, and from main context.
+ * Returns 0, or -1 if `id` is not a sporadic task.
+ */
+int32_t pulse_signal_isr(uint8_t id);
+#endif
+#endif
+
+#if (PULSE_CFG_AUTO_STAGGER == 1u)
+/* Assigns release phases to every task added through pulse_add_task() so the
+ * peak number of releases per tick is minimised; pulse_add_task_ex() phases
+ * are kept. Called by pulse_start(); custom main loops call it once before
+ * their first pulse_poll().
+ */
+void pulse_auto_stagger(void);
+#endif
+
+#if (PULSE_CFG_PRIORITY == 1u)
+/* Sets the dispatch priority of task `id`: 0 runs first, and tasks start at
+ * PULSE_PRIO_DEFAULT. Takes effect at the next pulse_apply_priorities().
+ * Returns 0, or -1 if `id` is not a registered task.
+ */
+int32_t pulse_set_priority(uint8_t id, uint8_t priority);
+
+/* Moves the tasks to ready-set positions in priority order; ids are not
+ * affected. Called by pulse_start(); custom main loops call it once before
+ * their first pulse_poll(). Tasks added later rank below all sorted tasks
+ * until it runs again. Main context only, never from inside a task.
+ */
+void pulse_apply_priorities(void);
+#endif
+
+#if (PULSE_CFG_TASK_CONTROL == 1u)
+/* Stops releasing task `id`. A release that is already pending, or that
+ * falls due while suspended, is held and delivered once by pulse_resume();
+ * catch-up runs still owed are dropped. A task that is already dispatched
+ * finishes that run. Callable from any context, including the task itself.
+ * Returns 0, or -1 if `id` is not a registered task.
+ */
+int32_t pulse_suspend(uint8_t id);
+
+/* Lets task `id` be released again. A held release is made ready at once,
+ * counts no overruns, and restarts the period; otherwise the task keeps its
+ * phase. Callable from any context; resuming a task that is not suspended
+ * does nothing. Returns as pulse_suspend().
+ */
+int32_t pulse_resume(uint8_t id);
+
+#if (PULSE_CFG_STATIC_TASKS == 0u)
+/* Changes the period of task `id` (the guard of a sporadic task) from the
+ * next release boundary on: the pending release keeps its time, and the one
+ * after it comes `period_ticks` later. Callable from any context.
+ * Returns 0, or -1 if `id` is not a registered task or the period is out of
+ * range as for pulse_add_task().
+ */
+int32_t pulse_set_period(uint8_t id, uint32_t period_ticks);
+#endif
+#endif
+
+#if (PULSE_CFG_MODES == 1u)
+/* Requests a switch to `mode`, taken in one step at the next tick: tasks
+ * active in it take its periods and the others are suspended. A task that
+ * stays active keeps its phase and changes period as with pulse_set_period();
+ * one that becomes active starts as if just added, dropping any held
+ * release. A second request before that tick replaces the first. Callable
+ * from any context. Returns 0, or -1 if `mode` is NULL, has more entries than
+ * PULSE_MAX_TASKS, or holds a period out of range for pulse_add_task().
+ */
+int32_t pulse_set_mode(const pulse_mode_t *mode);
+
+/* The mode last switched to, or NULL before the first switch. */
+const pulse_mode_t *pulse_get_mode(void);
+#endif
+
+#if (PULSE_CFG_COROUTINES == 1u)
+/* Called from a task body: the task's next release comes `ticks` after this
+ * call instead of one period after its dispatch, and the period counts again
+ * from the dispatch that ends the wait. 0 makes it ready again as soon as it
+ * returns, behind any ready task of higher priority. A wait drops owed
+ * catch-up runs and is not an overrun; on a sporadic task it acts as a
+ * signal that the guard does not hold back. Normally used through
+ * PULSE_WAIT_TICKS() and PULSE_YIELD(). Returns 0, or -1 if no task is
+ * running or `ticks` is longer than a period may be.
+ */
+int32_t pulse_wait_ticks(uint32_t ticks);
+#endif
+
+void pulse_start(void);
+
+/* Call from your timer ISR: marks tasks ready only.
+ * In tickless builds it also catches up the elapsed ticks and reprograms the
+ * one-shot compare for the next release.
+ */
+void pulse_tick_isr(void);
+
+/* Run all ready tasks (highest priority first) in main/thread context. */
+void pulse_poll(void);
+
+/* Like pulse_poll(), but runs at most max_tasks tasks and then returns, so a
+ * super-loop keeps a bound on how long it is away. Returns the number of
+ * tasks still ready; the next call picks them up in priority order. Tasks
+ * are claimed one at a time, also with PULSE_CFG_BATCH_DISPATCH.
+ */
+uint8_t pulse_poll_bounded(uint8_t max_tasks);
+
+#if (PULSE_CFG_POLL_BUDGET == 1u)
+/* Like pulse_poll_bounded(), but starts no further task once `budget`
+ * PULSE_PORT_TIMESTAMP() units have passed since the call. A task that is
+ * already running is never cut short, so the call can overshoot by one tick()
+ * call. A zero budget runs nothing and just reports what is ready.
+ */
+uint8_t pulse_poll_budget(pulse_stamp_t budget);
+#endif
+
+#if (PULSE_CFG_IDLE_SLEEP == 1u)
+/* Sleep until the next interrupt unless a task is already ready. For custom
+ * main loops: call right after pulse_poll().
+ */
+void pulse_idle(void);
+#endif
+
+#if (PULSE_CFG_STATS == 1u)
+/* Copies the measurements of task `id` into *out. Call from main context.
+ * Returns 0, or -1 if `id` is not a registered task or `out` is NULL.
+ */
+int32_t pulse_get_task_stats(uint8_t id, pulse_task_stats_t *out);
+
+/* Clears the measurements of task `id`; the next run starts a new window. */
+void pulse_reset_task_stats(uint8_t id);
+#endif
+
+#if (PULSE_CFG_OVERRUN == 1u)
+/* Selects the overrun policy of task `id`. `catchup_max` caps the burst of
+ * back-to-back runs under PULSE_OVERRUN_CATCHUP and is ignored otherwise.
+ * Returns 0, or -1 for an unknown task or policy.
+ */
+int32_t pulse_set_overrun_policy(uint8_t id, uint8_t policy, uint8_t catchup_max);
+
+/* Releases task `id` has missed since it was added (saturates). */
+uint32_t pulse_get_overruns(uint8_t id);
+#endif
+
+#if (PULSE_CFG_TRACE == 1u)
+/* Moves up to `max` of the oldest trace records to `out` and returns how
+ * many. The copy runs with interrupts masked, so keep `max` small. Call from
+ * one task only, normally the lowest-priority one.
+ */
+uint16_t pulse_trace_read(pulse_trace_rec_t *out, uint16_t max);
+
+/* Writes one record as PULSE_TRACE_WIRE_SIZE little-endian bytes, the format
+ * tools/pulse_trace.c reads.
+ */
+void pulse_trace_encode(const pulse_trace_rec_t *rec, uint8_t *out);
+#endif
+
+uint8_t pulse_is_started(void);
+
+/* The tick length as given to pulse_init() or pulse_init_us(). The _ms form
+ * rounds down, so a sub-millisecond tick reads as 0.
+ */
+uint32_t pulse_tick_period_ms(void);
+
+uint32_t pulse_tick_period_us(void);
+
+/* -------------------------- Instance API -------------------------- */
+
+/* Every function above works on a default kernel. These take the kernel
+ * explicitly, so one image can run several independent schedulers: one per
+ * core, or a fast and a slow one on separate timers. Each instance is
+ * driven by its own pulse_kernel_tick_isr() and pulse_kernel_poll() calls,
+ * and an instance is only ever touched from the core that runs it.
+ *
+ * pulse_kernel_start() does not start a timer, enable interrupts or enter a
+ * loop: it only marks the kernel started (and staggers it). The port timer,
+ * tickless hooks and pulse_start() belong to the default kernel; other
+ * instances are ticked from timers the application owns. With
+ * PULSE_CFG_STATIC_TASKS the table is the task set of every instance.
+ */
+void pulse_kernel_init(pulse_kernel_t *k, uint32_t tick_ms);
+
+void pulse_kernel_init_us(pulse_kernel_t *k, uint32_t tick_us);
+
+#if (PULSE_CFG_STATIC_TASKS == 0u)
+int32_t pulse_kernel_add_task(pulse_kernel_t *k,
+                              pulse_state_t init_state,
+                              uint32_t period_ticks,
+                              pulse_tick_f tick);
+
+int32_t pulse_kernel_add_task_ex(pulse_kernel_t *k,
+                                 pulse_state_t init_state,
+                                 uint32_t period_ticks,
+                                 uint32_t offset_ticks,
+                                 pulse_tick_f tick);
+
+#if (PULSE_CFG_SPORADIC == 1u)
+int32_t pulse_kernel_add_sporadic(pulse_kernel_t *k,
+                                  pulse_state_t init_state,
+                                  uint32_t min_gap_ticks,
+                                  pulse_tick_f tick);
+
+int32_t pulse_kernel_signal_isr(pulse_kernel_t *k, uint8_t id);
+#endif
+#endif
+
+#if (PULSE_CFG_AUTO_STAGGER == 1u)
+void pulse_kernel_auto_stagger(pulse_kernel_t *k);
+#endif
+
+#if (PULSE_CFG_PRIORITY == 1u)
+int32_t pulse_kernel_set_priority(pulse_kernel_t *k, uint8_t id, uint8_t priority);
+
+void pulse_kernel_apply_priorities(pulse_kernel_t *k);
+#endif
+
+#if (PULSE_CFG_TASK_CONTROL == 1u)
+int32_t pulse_kernel_suspend(pulse_kernel_t *k, uint8_t id);
+
+int32_t pulse_kernel_resume(pulse_kernel_t *k, uint8_t id);
+
+#if (PULSE_CFG_STATIC_TASKS == 0u)
+int32_t pulse_kernel_set_period(pulse_kernel_t *k, uint8_t id, uint32_t period_ticks);
+#endif
+#endif
+
+#if (PULSE_CFG_MODES == 1u)
+int32_t pulse_kernel_set_mode(pulse_kernel_t *k, const pulse_mode_t *mode);
+
+const pulse_mode_t *pulse_kernel_get_mode(const pulse_kernel_t *k);
+#endif
+
+#if (PULSE_CFG_COROUTINES == 1u)
+int32_t pulse_kernel_wait_ticks(pulse_kernel_t *k, uint32_t ticks);
+#endif
+
+void pulse_kernel_start(pulse_kernel_t *k);
+
+void pulse_kernel_tick_isr(pulse_kernel_t *k);
+
+void pulse_kernel_poll(pulse_kernel_t *k);
+
+uint8_t pulse_kernel_poll_bounded(pulse_kernel_t *k, uint8_t max_tasks);
+
+#if (PULSE_CFG_POLL_BUDGET == 1u)
+uint8_t pulse_kernel_poll_budget(pulse_kernel_t *k, pulse_stamp_t budget);
+#endif
+
+#if (PULSE_CFG_IDLE_SLEEP == 1u)
+/* Checks only k: with several kernels on one core, a release in another
+ * one ends the sleep through that kernel's timer interrupt.
+ */
+void pulse_kernel_idle(pulse_kernel_t *k);
+#endif
+
+#if (PULSE_CFG_STATS == 1u)
+int32_t pulse_kernel_get_task_stats(pulse_kernel_t *k, uint8_t id, pulse_task_stats_t *out);
+
+void pulse_kernel_reset_task_stats(pulse_kernel_t *k, uint8_t id);
+#endif
+
+#if (PULSE_CFG_OVERRUN == 1u)
+int32_t pulse_kernel_set_overrun_policy(pulse_kernel_t *k, uint8_t id, uint8_t policy, uint8_t catchup_max);
+
+uint32_t pulse_kernel_get_overruns(pulse_kernel_t *k, uint8_t id);
+#endif
+
+#if (PULSE_CFG_TRACE == 1u)
+uint16_t pulse_kernel_trace_read(pulse_kernel_t *k, pulse_trace_rec_t *out, uint16_t max);
+#endif
+
+uint8_t pulse_kernel_is_started(const pulse_kernel_t *k);
+
+uint32_t pulse_kernel_tick_period_ms(const pulse_kernel_t *k);
+
+uint32_t pulse_kernel_tick_period_us(const pulse_kernel_t *k);
+
+#if (PULSE_CFG_XSIGNAL_MAX > 0u)
+/* Makes kernel k watch channel ch and release its sporadic task `id` for
+ * every signal sent on it. Call during setup, before the sender starts.
+ * Returns 0, -1 if ch is NULL or `id` is not a sporadic task, or -3 if k
+ * already watches PULSE_CFG_XSIGNAL_MAX channels.
+ */
+int32_t pulse_kernel_xsignal_attach(pulse_kernel_t *k, pulse_xsignal_t *ch, uint8_t id);
+
+/* Signals the task attached to ch. Lock-free and wait-free; callable from
+ * any context on any core, as long as a channel has a single sending
+ * context. The receiver releases the task on its next pulse_kernel_poll().
+ */
+void pulse_xsignal_send(pulse_xsignal_t *ch);
+#endif
+
+/* -------------------------- Convenience macros -------------------------- */
+
+#define PULSE_UNUSED(x) do { (void)(x); } while (0)
+
+#if (PULSE_CFG_COROUTINES == 1u)
+/* Protothread-style coroutines. The task's state holds the line to resume
+ * at, so a job keeps nothing on the stack across slices: locals that must
+ * survive a yield or wait have to be static. pulse_state_t must hold every
+ * line number used, which the macros check at compile time. A task's
+ * initial state, or any state not set by these macros, starts the job from
+ * the top; after PULSE_END() it starts again at the next release.
+ *
+ *   static pulse_state_t erase(pulse_state_t pc)
+ *   {
+ *       static uint8_t block;
+ *
+ *       PULSE_BEGIN(pc);
+ *       for (block = 0u; block < 16u; block++)
+ *       {
+ *           flash_erase_start(block);
+ *           PULSE_WAIT_TICKS(pc, 3u);
+ *       }
+ *       PULSE_END(pc);
+ *   }
+ *
+ * The PULSE_KERNEL_ forms wait on kernel instance k; the others on the
+ * default kernel.
+ */
+#define PULSE_BEGIN(pc) \
+    switch (pc)         \
+    {                   \
+    default:
+
+#define PULSE_KERNEL_WAIT_TICKS(k, pc, ticks)                                      \
+    do                                                                             \
+    {                                                                              \
+        (void)sizeof(char[((pulse_state_t)(__LINE__) == (__LINE__)) ? 1 : -1]);   \
+        (void)pulse_kernel_wait_ticks((k), (ticks));                               \
+        return (pulse_state_t)(__LINE__);                                          \
+    case (__LINE__):;                                                              \
+    } while (0)
+
+#define PULSE_WAIT_TICKS(pc, ticks)                                                \
+    do                                                                             \
+    {                                                                              \
+        (void)sizeof(char[((pulse_state_t)(__LINE__) == (__LINE__)) ? 1 : -1]);   \
+        (void)pulse_wait_ticks(ticks);                                             \
+        return (pulse_state_t)(__LINE__);                                          \
+    case (__LINE__):;                                                              \
+    } while (0)
+
+#define PULSE_KERNEL_YIELD(k, pc) PULSE_KERNEL_WAIT_TICKS((k), (pc), 0u)
+#define PULSE_YIELD(pc)           PULSE_WAIT_TICKS((pc), 0u)
+
+#define PULSE_END(pc) \
+    }                 \
+    return 0
+#endif
+
+/* -------------------------- Implementation -------------------------- */
+
+#ifdef PULSE_IMPLEMENTATION
+
+static pulse_kernel_t pulse_kernel;
+
+#if ((PULSE_CFG_STATIC_TASKS == 1u) && defined(PULSE_TASK_TABLE))
+/* Periods and tick functions as switches: the constants stay in code space
+ * (flash on Harvard cores, no PROGMEM accessors needed) and fold away
+ * wherever the id is known at compile time.
+ */
+static inline pulse_tick_t pulse_static_period(uint8_t id)
+{
+    switch (id)
+    {
+#define PULSE_X_PERIOD(name, period, tick, init) \
+    case (uint8_t)PULSE_TASK_ID_##name: return (pulse_tick_t)(period);
+    PULSE_TASK_TABLE(PULSE_X_PERIOD)
+#undef PULSE_X_PERIOD
+    default: return 1u;
+    }
+}
+
+static inline pulse_state_t pulse_static_dispatch(uint8_t id, pulse_state_t state)
+{
+    switch (id)
+    {
+#define PULSE_X_DISPATCH(name, period, tick, init) \
+    case (uint8_t)PULSE_TASK_ID_##name: return (tick)(state);
+    PULSE_TASK_TABLE(PULSE_X_DISPATCH)
+#undef PULSE_X_DISPATCH
+    default: return state;
+    }
+}
+
+#define PULSE_TASK_COUNT          ((uint8_t)PULSE_STATIC_TASK_COUNT)
+#elif (PULSE_CFG_STATIC_TASKS == 1u)
+#define PULSE_TASK_COUNT          (pulse_static_count())
+#else
+#define PULSE_TASK_COUNT          (k->task_count)
+#endif
+
+/* Task field access, independent of the storage layout. */
+#if (PULSE_CFG_TASK_SOA == 1u)
+#define PULSE_TASK_PERIOD(id)     (k->period_ticks[(id)])
+#define PULSE_TASK_ELAPSED(id)    (k->elapsed_ticks[(id)])
+#define PULSE_TASK_RELEASE(id)    (k->next_release[(id)])
+#define PULSE_TASK_WHEEL_NEXT(id) (k->wheel_next[(id)])
+#define PULSE_TASK_STATE(id)      (k->state[(id)])
+#define PULSE_TASK_TICK(id)       (k->tick[(id)])
+#define PULSE_TASK_OVERRUNS(id)   (k->overruns[(id)])
+#define PULSE_TASK_POLICY(id)     (k->overrun_policy[(id)])
+#define PULSE_TASK_CATCHUP_MAX(id) (k->catchup_max[(id)])
+#define PULSE_TASK_CATCHUP(id)    (k->catchup_pending[(id)])
+#define PULSE_TASK_KIND(id)       (k->kind[(id)])
+#define PULSE_TASK_PERIOD_NEXT(id) (k->period_next[(id)])
+#else
+#define PULSE_TASK_PERIOD(id)     (k->tasks[(id)].period_ticks)
+#define PULSE_TASK_ELAPSED(id)    (k->tasks[(id)].elapsed_ticks)
+#define PULSE_TASK_RELEASE(id)    (k->tasks[(id)].next_release)
+#define PULSE_TASK_WHEEL_NEXT(id) (k->tasks[(id)].wheel_next)
+#define PULSE_TASK_STATE(id)      (k->tasks[(id)].state)
+#define PULSE_TASK_TICK(id)       (k->tasks[(id)].tick)
+#define PULSE_TASK_OVERRUNS(id)   (k->tasks[(id)].overruns)
+#define PULSE_TASK_POLICY(id)     (k->tasks[(id)].overrun_policy)
+#define PULSE_TASK_CATCHUP_MAX(id) (k->tasks[(id)].catchup_max)
+#define PULSE_TASK_CATCHUP(id)    (k->tasks[(id)].catchup_pending)
+#define PULSE_TASK_KIND(id)       (k->tasks[(id)].kind)
+#define PULSE_TASK_PERIOD_NEXT(id) (k->tasks[(id)].period_next)
+#endif
+
+/* Ready-set position of task `id`, and back; the public API converts on
+ * entry.
+ */
+#if (PULSE_CFG_PRIORITY == 1u)
+#define PULSE_TASK_POS(id)        (k->task_pos[(id)])
+#define PULSE_TASK_ID(pos)        (k->pos_task[(pos)])
+#else
+#define PULSE_TASK_POS(id)        (id)
+#define PULSE_TASK_ID(pos)        (pos)
+#endif
+
+/* Task kinds. A signalled task has a release pending: ready, waiting in the
+ * release queue for its guard, or (if running) due once it returns.
+ */
+#define PULSE_KIND_PERIODIC  (0u)
+#define PULSE_KIND_SPORADIC  (1u)
+#define PULSE_KIND_SIGNALLED (2u)
+
+static inline uint8_t pulse_task_kind(pulse_kernel_t *k, uint8_t id)
+{
+#if (PULSE_CFG_SPORADIC == 1u)
+    return PULSE_TASK_KIND(id);
+#else
+    (void)k;
+    (void)id;
+    return PULSE_KIND_PERIODIC;
+#endif
+}
+
+#if (PULSE_CFG_STATIC_TASKS == 1u)
+#undef PULSE_TASK_PERIOD
+#define PULSE_TASK_PERIOD(id)     (pulse_static_period((uint8_t)(id)))
+#endif
+
+/* Bit i of a byte, without a variable shift on 8-bit cores. */
+static const uint8_t pulse_bit8_table[8] = { 0x01u, 0x02u, 0x04u, 0x08u, 0x10u, 0x20u, 0x40u, 0x80u };
+
+#if ((PULSE_CFG_TASK_CONTROL == 1u) || (PULSE_CFG_COROUTINES == 1u))
+/* Per-task flags kept as byte arrays, bit id & 7 of byte id >> 3. */
+static inline uint8_t pulse_flag_test(const uint8_t *flags, uint8_t id)
+{
+    return ((flags[id >> 3u] & pulse_bit8_table[id & 7u]) != 0u) ? 1u : 0u;
+}
+
+static inline void pulse_flag_set(uint8_t *flags, uint8_t id)
+{
+    flags[id >> 3u] |= pulse_bit8_table[id & 7u];
+}
+
+static inline void pulse_flag_clear(uint8_t *flags, uint8_t id)
+{
+    flags[id >> 3u] &= (uint8_t)~pulse_bit8_table[id & 7u];
+}
+
+#if (PULSE_CFG_PRIORITY == 1u)
+static void pulse_flag_swap(uint8_t *flags, uint8_t a, uint8_t b)
+{
+    const uint8_t fa = pulse_flag_test(flags, a);
+    const uint8_t fb = pulse_flag_test(flags, b);
+
+    pulse_flag_clear(flags, a);
+    pulse_flag_clear(flags, b);
+    if (fb != 0u)
+    {
+        pulse_flag_set(flags, a);
+    }
+    if (fa != 0u)
+    {
+        pulse_flag_set(flags, b);
+    }
+}
+#endif
+#endif
+
+#if defined(PULSE_PORT_CTZ)
+static inline uint8_t pulse_ctz8(uint8_t x)
+{
+    return (uint8_t)PULSE_PORT_CTZ(x);
+}
+#else
+/* Lowest set bit of a non-zero byte: isolate it, then a de Bruijn multiply
+ * maps each power of two onto a distinct top-3-bit index.
+ */
+static const uint8_t pulse_ctz8_table[8] = { 0u, 1u, 6u, 2u, 7u, 5u, 4u, 3u };
+
+static inline uint8_t pulse_ctz8(uint8_t x)
+{
+    const uint8_t lsb = (uint8_t)(x & (uint8_t)(0u - x));
+    return pulse_ctz8_table[(uint8_t)(lsb * 0x1Du) >> 5u];
+}
+#endif
+
+/* Ready set. Callers hold the critical section for every helper below. */
+#if (PULSE_CFG_READY_BITMAP == 1u)
+static inline pulse_ready_grp_t pulse_grp_bit(uint8_t group)
+{
+#if (PULSE_READY_GROUPS <= 8u)
+    return pulse_bit8_table[group];
+#else
+    return (pulse_ready_grp_t)((pulse_ready_grp_t)1u << group);
+#endif
+}
+
+static inline uint8_t pulse_grp_first(pulse_ready_grp_t grp)
+{
+#if (PULSE_READY_GROUPS <= 8u)
+    return pulse_ctz8(grp);
+#else
+    uint8_t base = 0u;
+
+    while ((grp & 0xFFu) == 0u)
+    {
+        grp = (pulse_ready_grp_t)(grp >> 8u);
+        base = (uint8_t)(base + 8u);
+    }
+    return (uint8_t)(base + pulse_ctz8((uint8_t)(grp & 0xFFu)));
+#endif
+}
+
+static inline void pulse_ready_init(pulse_kernel_t *k)
+{
+    uint8_t g;
+
+    k->ready_grp = 0u;
+    for (g = 0u; g < (uint8_t)PULSE_READY_GROUPS; g++)
+    {
+        k->ready_tbl[g] = 0u;
+    }
+}
+
+static inline void pulse_ready_set(pulse_kernel_t *k, uint8_t id)
+{
+    const uint8_t g = (uint8_t)(id >> 3u);
+
+    k->ready_tbl[g] |= pulse_bit8_table[id & 7u];
+    k->ready_grp |= pulse_grp_bit(g);
+}
+
+static inline void pulse_ready_clear(pulse_kernel_t *k, uint8_t id)
+{
+    const uint8_t g = (uint8_t)(id >> 3u);
+
+    k->ready_tbl[g] &= (uint8_t)~pulse_bit8_table[id & 7u];
+    if (k->ready_tbl[g] == 0u)
+    {
+        k->ready_grp &= (pulse_ready_grp_t)~pulse_grp_bit(g);
+    }
+}
+
+static inline uint8_t pulse_ready_test(pulse_kernel_t *k, uint8_t id)
+{
+    return ((k->ready_tbl[id >> 3u] & pulse_bit8_table[id & 7u]) != 0u) ? 1u : 0u;
+}
+
+static inline uint8_t pulse_ready_any(pulse_kernel_t *k)
+{
+    return (k->ready_grp != 0u) ? 1u : 0u;
+}
+
+/* Number of ready tasks: one step per set bit. */
+static inline uint8_t pulse_ready_count(pulse_kernel_t *k)
+{
+    uint8_t g;
+    uint8_t bits;
+    uint8_t n = 0u;
+
+    for (g = 0u; g < (uint8_t)PULSE_READY_GROUPS; g++)
+    {
+        for (bits = k->ready_tbl[g]; bits != 0u; bits &= (uint8_t)(bits - 1u))
+        {
+            n++;
+        }
+    }
+    return n;
+}
+
+static inline int32_t pulse_ready_first(pulse_kernel_t *k)
+{
+    uint8_t g;
+
+    if (k->ready_grp == 0u)
+    {
+        return -1;
+    }
+
+    g = pulse_grp_first(k->ready_grp);
+    return (int32_t)(((uint32_t)g << 3u) + (uint32_t)pulse_ctz8(k->ready_tbl[g]));
+}
+#else
+static pulse_mask_t pulse_task_bit(uint8_t id)
+{
+#if (PULSE_MAX_TASKS <= 8u)
+    return pulse_bit8_table[id];
+#else
+    return (pulse_mask_t)((pulse_mask_t)1u << id);
+#endif
+}
+
+static int32_t pulse_find_lowest_set_bit(pulse_mask_t mask)
+{
+#if defined(PULSE_PORT_CTZ)
+    if (mask == 0u)
+    {
+        return -1;
+    }
+    return (int32_t)PULSE_PORT_CTZ(mask);
+#else
+    uint8_t base = 0u;
+
+    if (mask == 0u)
+    {
+        return -1;
+    }
+
+#if (PULSE_MAX_TASKS > 8u)
+    /* At most sizeof(pulse_mask_t) - 1 byte steps. */
+    while ((mask & 0xFFu) == 0u)
+    {
+        mask = (pulse_mask_t)(mask >> 8u);
+        base = (uint8_t)(base + 8u);
+    }
+#endif
+
+    return (int32_t)((uint32_t)base + (uint32_t)pulse_ctz8((uint8_t)(mask & 0xFFu)));
+#endif
+}
+
+/* Whole-mask access. With PULSE_CFG_LOCK_FREE each is one atomic step, so
+ * a bit set by the ISR is never lost to a clear from main context.
+ */
+#if (PULSE_CFG_LOCK_FREE == 1u)
+#define PULSE_READY_LOAD(k)        ((pulse_mask_t)PULSE_PORT_ATOMIC_LOAD(&(k)->ready_mask))
+#define PULSE_READY_STORE(k, v)    PULSE_PORT_ATOMIC_STORE(&(k)->ready_mask, (v))
+#define PULSE_READY_OR(k, bits)    ((void)PULSE_PORT_ATOMIC_FETCH_OR(&(k)->ready_mask, (bits)))
+#define PULSE_READY_AND(k, bits)   ((void)PULSE_PORT_ATOMIC_FETCH_AND(&(k)->ready_mask, (bits)))
+#else
+#define PULSE_READY_LOAD(k)        ((k)->ready_mask)
+#define PULSE_READY_STORE(k, v)    ((k)->ready_mask = (v))
+#define PULSE_READY_OR(k, bits)    ((k)->ready_mask |= (bits))
+#define PULSE_READY_AND(k, bits)   ((k)->ready_mask &= (bits))
+#endif
+
+static inline void pulse_ready_init(pulse_kernel_t *k)
+{
+    PULSE_READY_STORE(k, 0u);
+}
+
+static inline void pulse_ready_set(pulse_kernel_t *k, uint8_t id)
+{
+    PULSE_READY_OR(k, pulse_task_bit(id));
+}
+
+static inline void pulse_ready_clear(pulse_kernel_t *k, uint8_t id)
+{
+    PULSE_READY_AND(k, (pulse_mask_t)~pulse_task_bit(id));
+}
+
+static inline uint8_t pulse_ready_test(pulse_kernel_t *k, uint8_t id)
+{
+    return ((PULSE_READY_LOAD(k) & pulse_task_bit(id)) != 0u) ? 1u : 0u;
+}
+
+static inline uint8_t pulse_ready_any(pulse_kernel_t *k)
+{
+    return (PULSE_READY_LOAD(k) != 0u) ? 1u : 0u;
+}
+
+/* Number of ready tasks: one step per set bit. */
+static inline uint8_t pulse_ready_count(pulse_kernel_t *k)
+{
+    pulse_mask_t bits;
+    uint8_t n = 0u;
+
+    for (bits = PULSE_READY_LOAD(k); bits != 0u; bits &= (pulse_mask_t)(bits - 1u))
+    {
+        n++;
+    }
+    return n;
+}
+
+static inline int32_t pulse_ready_first(pulse_kernel_t *k)
+{
+    return pulse_find_lowest_set_bit(PULSE_READY_LOAD(k));
+}
+#endif /* PULSE_CFG_READY_BITMAP */
+
+/* Release batch: a local set of task ids with the same layout as the ready
+ * set. Lets the ISR collect releases and publish them at once, and lets
+ * pulse_poll() take the whole ready set in one go.
+ */
+#if (PULSE_CFG_READY_BITMAP == 1u)
+typedef struct
+{
+    pulse_ready_grp_t grp;
+    uint8_t           tbl[PULSE_READY_GROUPS]; /* valid where grp is set */
+} pulse_batch_t;
+
+/* Clears tbl too, though only groups in grp are read: optimizing compilers
+ * cannot see that and warn about the rest.
+ */
+static inline void pulse_batch_init(pulse_batch_t *b)
+{
+    uint8_t g;
+
+    b->grp = 0u;
+    for (g = 0u; g < (uint8_t)PULSE_READY_GROUPS; g++)
+    {
+        b->tbl[g] = 0u;
+    }
+}
+
+static inline uint8_t pulse_batch_empty(const pulse_batch_t *b)
+{
+    return (b->grp == 0u) ? 1u : 0u;
+}
+
+static inline void pulse_batch_add(pulse_batch_t *b, uint8_t id)
+{
+    const uint8_t g = (uint8_t)(id >> 3u);
+    const pulse_ready_grp_t gbit = pulse_grp_bit(g);
+
+    if ((b->grp & gbit) == 0u)
+    {
+        b->grp |= gbit;
+        b->tbl[g] = 0u;
+    }
+    b->tbl[g] |= pulse_bit8_table[id & 7u];
+}
+
+/* Removes and returns the lowest id, or -1 if the batch is empty. */
+static inline int32_t pulse_batch_pop(pulse_batch_t *b)
+{
+    uint8_t g;
+    uint8_t bit;
+
+    if (b->grp == 0u)
+    {
+        return -1;
+    }
+
+    g = pulse_grp_first(b->grp);
+    bit = pulse_ctz8(b->tbl[g]);
+
+    b->tbl[g] &= (uint8_t)~pulse_bit8_table[bit];
+    if (b->tbl[g] == 0u)
+    {
+        b->grp &= (pulse_ready_grp_t)~pulse_grp_bit(g);
+    }
+
+    return (int32_t)(((uint32_t)g << 3u) + (uint32_t)bit);
+}
+
+/* Caller holds the critical section. */
+static inline void pulse_ready_publish(pulse_kernel_t *k, const pulse_batch_t *b)
+{
+    uint8_t g;
+
+    k->ready_grp |= b->grp;
+    for (g = 0u; g < (uint8_t)PULSE_READY_GROUPS; g++)
+    {
+        if ((b->grp & pulse_grp_bit(g)) != 0u)
+        {
+            k->ready_tbl[g] |= b->tbl[g];
+        }
+    }
+}
+
+/* Moves the whole ready set into b. Caller holds the critical section. */
+static inline void pulse_ready_take(pulse_kernel_t *k, pulse_batch_t *b)
+{
+    uint8_t g;
+
+    b->grp = k->ready_grp;
+    for (g = 0u; g < (uint8_t)PULSE_READY_GROUPS; g++)
+    {
+        /* Every group is written, for the same reason as pulse_batch_init(). */
+        b->tbl[g] = ((b->grp & pulse_grp_bit(g)) != 0u) ? k->ready_tbl[g] : 0u;
+        k->ready_tbl[g] = 0u;
+    }
+    k->ready_grp = 0u;
+}
+#else
+typedef pulse_mask_t pulse_batch_t;
+
+static inline void pulse_batch_init(pulse_batch_t *b)
+{
+    *b = 0u;
+}
+
+static inline uint8_t pulse_batch_empty(const pulse_batch_t *b)
+{
+    return (*b == 0u) ? 1u : 0u;
+}
+
+static inline void pulse_batch_add(pulse_batch_t *b, uint8_t id)
+{
+    *b |= pulse_task_bit(id);
+}
+
+/* Removes and returns the lowest id, or -1 if the batch is empty. */
+static inline int32_t pulse_batch_pop(pulse_batch_t *b)
+{
+    const int32_t id = pulse_find_lowest_set_bit(*b);
+
+    if (id >= 0)
+    {
+        *b &= (pulse_mask_t)~pulse_task_bit((uint8_t)id);
+    }
+    return id;
+}
+
+/* Caller holds the critical section. */
+static inline void pulse_ready_publish(pulse_kernel_t *k, const pulse_batch_t *b)
+{
+    PULSE_READY_OR(k, *b);
+}
+
+/* Moves the whole ready set into b. Caller holds the critical section. */
+static inline void pulse_ready_take(pulse_kernel_t *k, pulse_batch_t *b)
+{
+    *b = PULSE_READY_LOAD(k);
+    PULSE_READY_STORE(k, 0u);
+}
+
+#if (PULSE_CFG_LOCK_FREE == 1u)
+/* The two halves of pulse_ready_take() for lock-free builds: copy the ready
+ * set into b, then, once the batch is claimed, remove it again. Releases
+ * published in between stay in the ready set.
+ */
+static inline void pulse_ready_peek(pulse_kernel_t *k, pulse_batch_t *b)
+{
+    *b = PULSE_READY_LOAD(k);
+}
+
+static inline void pulse_ready_drop(pulse_kernel_t *k, const pulse_batch_t *b)
+{
+    PULSE_READY_AND(k, (pulse_mask_t)~*b);
+}
+#endif
+#endif /* PULSE_CFG_READY_BITMAP */
+
+/* Running flag. Set and cleared by pulse_poll() inside its critical
+ * sections, tested by the tick ISR. Only main context writes it, so
+ * lock-free builds set it before the ready bit is cleared.
+ */
+#if (PULSE_CFG_TASK_SOA == 1u)
+#if (PULSE_CFG_READY_BITMAP == 1u)
+static inline void pulse_running_init(pulse_kernel_t *k)
+{
+    uint8_t g;
+    for (g = 0u; g < (uint8_t)PULSE_READY_GROUPS; g++)
+    {
+        k->running_tbl[g] = 0u;
+    }
+}
+
+static inline void pulse_running_set(pulse_kernel_t *k, uint8_t id)
+{
+    k->running_tbl[id >> 3u] |= pulse_bit8_table[id & 7u];
+}
+
+static inline void pulse_running_clear(pulse_kernel_t *k, uint8_t id)
+{
+    k->running_tbl[id >> 3u] &= (uint8_t)~pulse_bit8_table[id & 7u];
+}
+
+static inline uint8_t pulse_running_test(pulse_kernel_t *k, uint8_t id)
+{
+    return ((k->running_tbl[id >> 3u] & pulse_bit8_table[id & 7u]) != 0u) ? 1u : 0u;
+}
+#else
+static inline void pulse_running_init(pulse_kernel_t *k)
+{
+    k->running_mask = 0u;
+}
+
+static inline void pulse_running_set(pulse_kernel_t *k, uint8_t id)
+{
+    k->running_mask |= pulse_task_bit(id);
+}
+
+static inline void pulse_running_clear(pulse_kernel_t *k, uint8_t id)
+{
+    k->running_mask &= (pulse_mask_t)~pulse_task_bit(id);
+}
+
+static inline uint8_t pulse_running_test(pulse_kernel_t *k, uint8_t id)
+{
+    return ((k->running_mask & pulse_task_bit(id)) != 0u) ? 1u : 0u;
+}
+#endif
+#else
+static inline void pulse_running_init(pulse_kernel_t *k)
+{
+    uint8_t i;
+    for (i = 0u; i < (uint8_t)PULSE_MAX_TASKS; i++)
+    {
+        k->tasks[i].running = 0u;
+    }
+}
+
+static inline void pulse_running_set(pulse_kernel_t *k, uint8_t id)
+{
+    k->tasks[id].running = 1u;
+}
+
+static inline void pulse_running_clear(pulse_kernel_t *k, uint8_t id)
+{
+    k->tasks[id].running = 0u;
+}
+
+static inline uint8_t pulse_running_test(pulse_kernel_t *k, uint8_t id)
+{
+    return k->tasks[id].running;
+}
+#endif /* PULSE_CFG_TASK_SOA */
+
+/* Critical sections that guard only the ready and running sets: the scan
+ * ISR's publish and pulse_poll()'s claim and retire. Compiled away with
+ * PULSE_CFG_LOCK_FREE.
+ */
+#if (PULSE_CFG_LOCK_FREE == 1u)
+#define PULSE_READY_ENTER() do { } while (0)
+#define PULSE_READY_EXIT()  do { } while (0)
+#else
+#define PULSE_READY_ENTER() PULSE_PORT_ENTER_CRITICAL()
+#define PULSE_READY_EXIT()  PULSE_PORT_EXIT_CRITICAL()
+#endif
+
+#if (PULSE_CFG_TRACE == 1u)
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_SCAN)
+#define PULSE_TRACE_NOW() (k->trace_now)
+#else
+#define PULSE_TRACE_NOW() (k->now)
+#endif
+
+#define PULSE_TRACE_MASK ((uint16_t)(PULSE_CFG_TRACE_DEPTH - 1u))
+
+static inline uint16_t pulse_trace_tick_len(uint32_t tick_us)
+{
+    const uint32_t ms = tick_us / 1000u;
+
+    if (tick_us < (uint32_t)PULSE_TRACE_TICK_MS)
+    {
+        return (uint16_t)tick_us;
+    }
+    return (uint16_t)(PULSE_TRACE_TICK_MS | ((ms < 0x7FFFu) ? ms : 0x7FFFu));
+}
+
+static inline void pulse_trace_store(pulse_kernel_t *k, uint16_t head, uint8_t event, uint8_t id, uint16_t sub)
+{
+    pulse_trace_rec_t * const r = &k->trace[head & PULSE_TRACE_MASK];
+
+    r->tick = PULSE_TRACE_NOW();
+    r->sub = sub;
+    r->event = event;
+    r->id = id;
+}
+
+/* Appends one record. On a full ring the record is dropped and counted, and
+ * the count goes out as a LOST record once there is room for it and the
+ * record after it. Caller holds the critical section or runs in the tick ISR.
+ */
+static void pulse_trace_put(pulse_kernel_t *k, uint8_t event, uint8_t id, uint16_t sub)
+{
+    uint16_t head = k->trace_head;
+    const uint16_t used = (uint16_t)(head - k->trace_tail);
+
+    if (k->trace_lost != 0u)
+    {
+        if (used > (uint16_t)(PULSE_CFG_TRACE_DEPTH - 2u))
+        {
+            if (k->trace_lost < 0xFFFFu)
+            {
+                k->trace_lost++;
+            }
+            return;
+        }
+        pulse_trace_store(k, head, PULSE_TRACE_LOST, PULSE_TRACE_NO_TASK, k->trace_lost);
+        head = (uint16_t)(head + 1u);
+        k->trace_lost = 0u;
+    }
+    else if (used >= (uint16_t)PULSE_CFG_TRACE_DEPTH)
+    {
+        k->trace_lost = 1u;
+        return;
+    }
+
+    pulse_trace_store(k, head, event, id, sub);
+    k->trace_head = (uint16_t)(head + 1u);
+}
+
+/* Records a timed event of the task at position `pos`. PULSE_TRACE_MAIN()
+ * is the form for main context outside a critical section.
+ */
+#define PULSE_TRACE(event, pos) \
+    pulse_trace_put(k, (event), PULSE_TASK_ID(pos), (uint16_t)PULSE_PORT_SUBTICK())
+#define PULSE_TRACE_MAIN(event, pos) \
+    do { PULSE_PORT_ENTER_CRITICAL(); PULSE_TRACE((event), (pos)); PULSE_PORT_EXIT_CRITICAL(); } while (0)
+#else
+#define PULSE_TRACE(event, pos)      do { } while (0)
+#define PULSE_TRACE_MAIN(event, pos) do { } while (0)
+#endif /* PULSE_CFG_TRACE */
+
+#if (PULSE_CFG_STATS == 1u) || (PULSE_CFG_TRACE == 1u)
+/* Stamps and logs a release, unless the task is already waiting in the
+ * ready set. Caller holds the critical section or runs in the tick ISR.
+ */
+static inline void pulse_note_release(pulse_kernel_t *k, uint8_t id)
+{
+    if (pulse_ready_test(k, id) == 0u)
+    {
+#if (PULSE_CFG_STATS == 1u)
+        k->release_stamp[id] = PULSE_PORT_TIMESTAMP();
+#endif
+        PULSE_TRACE(PULSE_TRACE_RELEASE, id);
+    }
+}
+
+#define PULSE_NOTE_RELEASE(id) pulse_note_release(k, (id))
+#else
+#define PULSE_NOTE_RELEASE(id) do { } while (0)
+#endif
+
+static inline uint8_t pulse_task_suspended(pulse_kernel_t *k, uint8_t id)
+{
+#if (PULSE_CFG_TASK_CONTROL == 1u)
+    return pulse_flag_test(k->suspended, id);
+#else
+    (void)k;
+    (void)id;
+    return 0u;
+#endif
+}
+
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+/* Nonzero if a release of task id is held for pulse_resume(); such a task
+ * is in no release queue.
+ */
+static inline uint8_t pulse_task_held(pulse_kernel_t *k, uint8_t id)
+{
+#if (PULSE_CFG_TASK_CONTROL == 1u)
+    return pulse_flag_test(k->held, id);
+#else
+    (void)k;
+    (void)id;
+    return 0u;
+#endif
+}
+#endif
+
+/* A release of task id fell due: make it ready, or hold it while the task
+ * is suspended. Caller holds the critical section or runs in the tick ISR.
+ */
+static inline void pulse_task_due(pulse_kernel_t *k, uint8_t id)
+{
+#if (PULSE_CFG_TASK_CONTROL == 1u)
+    if (pulse_task_suspended(k, id) != 0u)
+    {
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+        pulse_flag_set(k->held, id);
+#endif
+        return;
+    }
+#endif
+    PULSE_NOTE_RELEASE(id);
+    pulse_ready_set(k, id);
+}
+
+#if (PULSE_CFG_STATS == 1u)
+static void pulse_stats_clear(pulse_kernel_t *k, uint8_t id)
+{
+    pulse_task_stats_t * const st = &k->stats[id];
+
+    st->runs = 0u;
+    st->exec_min = (pulse_stamp_t)~(pulse_stamp_t)0u;
+    st->exec_max = 0u;
+    st->exec_total = 0u;
+    st->latency_max = 0u;
+}
+#endif /* PULSE_CFG_STATS */
+
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+/* Wrap-safe tick comparisons: valid while times are less than half the
+ * pulse_tick_t range apart.
+ */
+static uint8_t pulse_time_reached(pulse_tick_t when, pulse_tick_t now)
+{
+    return (((pulse_tick_t)(now - when) & PULSE_TICK_SIGN) == 0u) ? 1u : 0u;
+}
+#endif
+
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+static uint8_t pulse_heap_before(pulse_kernel_t *k, uint8_t a, uint8_t b)
+{
+    const pulse_tick_t ra = PULSE_TASK_RELEASE(a);
+    const pulse_tick_t rb = PULSE_TASK_RELEASE(b);
+
+    return (((pulse_tick_t)(ra - rb) & PULSE_TICK_SIGN) != 0u) ? 1u : 0u;
+}
+
+/* Caller holds the critical section. */
+static void pulse_heap_push(pulse_kernel_t *k, uint8_t id)
+{
+    uint16_t pos = k->release_count;
+
+    k->release_count = (uint8_t)(k->release_count + 1u);
+
+    while (pos > 0u)
+    {
+        const uint16_t parent = (uint16_t)((uint16_t)(pos - 1u) / 2u);
+
+        if (pulse_heap_before(k, id, k->release_heap[parent]) == 0u)
+        {
+            break;
+        }
+
+        k->release_heap[pos] = k->release_heap[parent];
+        pos = parent;
+    }
+
+    k->release_heap[pos] = id;
+}
+
+/* Caller holds the critical section and guarantees release_count > 0. */
+static uint8_t pulse_heap_pop(pulse_kernel_t *k)
+{
+    const uint8_t top = k->release_heap[0];
+    uint8_t last;
+    uint16_t pos = 0u;
+
+    k->release_count = (uint8_t)(k->release_count - 1u);
+    last = k->release_heap[k->release_count];
+
+    for (;;)
+    {
+        uint16_t child = (uint16_t)((uint16_t)(pos * 2u) + 1u);
+
+        if (child >= k->release_count)
+        {
+            break;
+        }
+
+        if (((uint16_t)(child + 1u) < k->release_count) &&
+            (pulse_heap_before(k, k->release_heap[child + 1u], k->release_heap[child]) != 0u))
+        {
+            child = (uint16_t)(child + 1u);
+        }
+
+        if (pulse_heap_before(k, k->release_heap[child], last) == 0u)
+        {
+            break;
+        }
+
+        k->release_heap[pos] = k->release_heap[child];
+        pos = child;
+    }
+
+    k->release_heap[pos] = last;
+
+    return top;
+}
+
+/* Pops every task whose release time has been reached into the ready set.
+ * Caller holds the critical section.
+ */
+static void pulse_heap_release_due(pulse_kernel_t *k)
+{
+    while ((k->release_count != 0u) &&
+           (pulse_time_reached(PULSE_TASK_RELEASE(k->release_heap[0]),
+                               k->now) != 0u))
+    {
+        const uint8_t id = pulse_heap_pop(k);
+
+        pulse_task_due(k, id);
+    }
+}
+#endif /* PULSE_RELEASE_HEAP */
+
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+#define PULSE_WHEEL_MASK (PULSE_WHEEL_SLOTS - 1u)
+#define PULSE_WHEEL_SPAN ((uint32_t)1u << (PULSE_CFG_WHEEL_BITS * PULSE_CFG_WHEEL_LEVELS))
+#define PULSE_WHEEL_NONE (0xFFu)
+
+/* The slots map absolute ticks, so the whole span must fit in pulse_tick_t:
+ * lower PULSE_CFG_WHEEL_BITS or PULSE_CFG_WHEEL_LEVELS for a narrow tick.
+ */
+typedef char pulse_cfg_wheel_bits_times_levels_must_fit_tick_t[
+    ((PULSE_WHEEL_SPAN - 1u) <= (uint32_t)PULSE_TICK_MAX) ? 1 : -1];
+
+/* Files a task by its next_release. `base` is the first tick that has not
+ * been processed yet. Overdue tasks go into the base slot so they are released
+ * by the next processed tick. Caller holds the critical section.
+ */
+static void pulse_wheel_insert(pulse_kernel_t *k, uint8_t id, pulse_tick_t base)
+{
+    pulse_tick_t when = PULSE_TASK_RELEASE(id);
+    uint32_t delta = (pulse_tick_t)(when - base);
+    uint8_t level = 0u;
+    uint8_t slot;
+
+    if ((delta & (uint32_t)PULSE_TICK_SIGN) != 0u)
+    {
+        when = base;
+        delta = 0u;
+    }
+    else if (delta >= PULSE_WHEEL_SPAN)
+    {
+        /* Park at the far edge of the outermost wheel; re-filed on cascade. */
+        delta = PULSE_WHEEL_SPAN - 1u;
+        when = (pulse_tick_t)(base + delta);
+    }
+    else
+    {
+        /* already in range */
+    }
+
+    while (delta >= ((uint32_t)1u << (PULSE_CFG_WHEEL_BITS * (uint32_t)(level + 1u))))
+    {
+        level = (uint8_t)(level + 1u);
+    }
+
+    slot = (uint8_t)((when >> (PULSE_CFG_WHEEL_BITS * (uint32_t)level)) & PULSE_WHEEL_MASK);
+
+    PULSE_TASK_WHEEL_NEXT(id) = k->wheel[level][slot];
+    k->wheel[level][slot] = id;
+}
+
+/* Empties every slot of every wheel. */
+static void pulse_wheel_clear(pulse_kernel_t *k)
+{
+    uint8_t level;
+    uint16_t slot;
+
+    for (level = 0u; level < (uint8_t)PULSE_CFG_WHEEL_LEVELS; level++)
+    {
+        for (slot = 0u; slot < (uint16_t)PULSE_WHEEL_SLOTS; slot++)
+        {
+            k->wheel[level][slot] = PULSE_WHEEL_NONE;
+        }
+    }
+}
+
+/* Re-files every task of one outer slot against the current tick. Returns the
+ * slot index so the caller knows whether the next wheel has to cascade too.
+ */
+static uint8_t pulse_wheel_cascade(pulse_kernel_t *k, uint8_t level)
+{
+    const uint8_t slot = (uint8_t)((k->now >> (PULSE_CFG_WHEEL_BITS * (uint32_t)level)) & PULSE_WHEEL_MASK);
+    uint8_t id = k->wheel[level][slot];
+
+    k->wheel[level][slot] = PULSE_WHEEL_NONE;
+
+    while (id != PULSE_WHEEL_NONE)
+    {
+        const uint8_t next = PULSE_TASK_WHEEL_NEXT(id);
+        pulse_wheel_insert(k, id, k->now);
+        id = next;
+    }
+
+    return slot;
+}
+#endif /* PULSE_RELEASE_WHEEL */
+
+/* Files a task whose next release is `offset` ticks away (0 = now). Caller
+ * holds the critical section; the task must not be queued anywhere.
+ */
+static void pulse_task_phase(pulse_kernel_t *k, uint8_t id, pulse_tick_t offset)
+{
+#if ((PULSE_CFG_TASK_CONTROL == 1u) && (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN))
+    /* The new phase replaces a held release. */
+    pulse_flag_clear(k->held, id);
+#endif
+#if (PULSE_CFG_COROUTINES == 1u)
+    /* And a wait left over from an earlier job. */
+    pulse_flag_clear(k->waiting, id);
+#endif
+#if (PULSE_CFG_SPORADIC == 1u)
+    if (PULSE_TASK_KIND(id) != PULSE_KIND_PERIODIC)
+    {
+        /* Guard already met: the first signal releases at once. */
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+        PULSE_TASK_RELEASE(id) = k->now;
+#else
+        PULSE_TASK_ELAPSED(id) = PULSE_TASK_PERIOD(id);
+#endif
+        (void)offset;
+        return;
+    }
+#endif
+
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    PULSE_TASK_RELEASE(id) = (pulse_tick_t)(k->now + offset);
+#else
+    PULSE_TASK_ELAPSED(id) = (pulse_tick_t)(PULSE_TASK_PERIOD(id) - offset);
+#endif
+
+    if (offset == 0u)
+    {
+        pulse_task_due(k, id);
+    }
+    else
+    {
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+        pulse_heap_push(k, id);
+#elif (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+        pulse_wheel_insert(k, id, k->now + 1u);
+#endif
+    }
+}
+
+#if (PULSE_CFG_MODES == 1u)
+/* Takes the requested mode. The release queue is rebuilt from the tasks that
+ * stay active, so a task leaving the mode costs nothing from here on and one
+ * entering it is filed only once. Caller holds the critical section at a
+ * tick boundary; on the wheel backend, before the tick's slot is expired.
+ */
+static void pulse_mode_apply(pulse_kernel_t *k)
+{
+    const pulse_mode_t * const mode = k->mode_next;
+    uint8_t id;
+
+    k->mode_next = (const pulse_mode_t *)0;
+    k->mode = mode;
+
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+    k->release_count = 0u;
+#elif (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+    pulse_wheel_clear(k);
+#endif
+
+    for (id = 0u; id < PULSE_TASK_COUNT; id++)
+    {
+        const uint8_t pos = PULSE_TASK_POS(id);
+        const uint32_t period = (id < mode->count) ? mode->periods[id] : PULSE_MODE_OFF;
+
+        if (period == PULSE_MODE_OFF)
+        {
+            /* Leaving, or still out: nothing pending survives the switch. */
+            pulse_flag_set(k->suspended, pos);
+            pulse_ready_clear(k, pos);
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+            pulse_flag_clear(k->held, pos);
+#endif
+#if (PULSE_CFG_OVERRUN == 1u)
+            PULSE_TASK_CATCHUP(pos) = 0u;
+#endif
+        }
+        else if (pulse_task_suspended(k, pos) != 0u)
+        {
+            /* Entering: as if just added, at the mode's period. */
+            pulse_flag_clear(k->suspended, pos);
+            if (period != PULSE_MODE_KEEP)
+            {
+                PULSE_TASK_PERIOD(pos) = (pulse_tick_t)period;
+#if (PULSE_PERIOD_DEFERRED == 1u)
+                PULSE_TASK_PERIOD_NEXT(pos) = (pulse_tick_t)period;
+#endif
+            }
+#if (PULSE_CFG_SPORADIC == 1u)
+            if (PULSE_TASK_KIND(pos) != PULSE_KIND_PERIODIC)
+            {
+                PULSE_TASK_KIND(pos) = PULSE_KIND_SPORADIC;
+            }
+#endif
+            /* A task still finishing a run is filed again when it retires. */
+            if (pulse_running_test(k, pos) == 0u)
+            {
+                pulse_task_phase(k, pos, (PULSE_CFG_RUN_IMMEDIATELY == 1u) ? (pulse_tick_t)0u : PULSE_TASK_PERIOD(pos));
+            }
+        }
+        else
+        {
+            /* Staying: new period from the next release boundary. */
+            if (period != PULSE_MODE_KEEP)
+            {
+#if (PULSE_PERIOD_DEFERRED == 1u)
+                PULSE_TASK_PERIOD_NEXT(pos) = (pulse_tick_t)period;
+#else
+                PULSE_TASK_PERIOD(pos) = (pulse_tick_t)period;
+#endif
+            }
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+            /* Waiting for its release (a signalled sporadic task for its
+             * guard) means it was queued: file it again.
+             */
+            if ((pulse_ready_test(k, pos) == 0u) && (pulse_running_test(k, pos) == 0u) &&
+                (pulse_task_kind(k, pos) != PULSE_KIND_SPORADIC))
+            {
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+                pulse_heap_push(k, pos);
+#else
+                pulse_wheel_insert(k, pos, k->now);
+#endif
+            }
+#endif
+        }
+    }
+}
+
+/* Takes a pending switch from the tick ISR; otherwise one pointer test. */
+static inline void pulse_mode_tick(pulse_kernel_t *k)
+{
+    if (k->mode_next != (const pulse_mode_t *)0)
+    {
+        PULSE_PORT_ENTER_CRITICAL();
+        pulse_mode_apply(k);
+        PULSE_PORT_EXIT_CRITICAL();
+    }
+}
+#endif /* PULSE_CFG_MODES */
+
+#if (PULSE_CFG_TICKLESS == 1u)
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+/* Advances the global tick counter and releases the tasks that became due.
+ * Caller holds the critical section.
+ */
+static void pulse_advance_ticks(pulse_kernel_t *k, uint32_t n_ticks)
+{
+    k->now = (pulse_tick_t)(k->now + n_ticks);
+    pulse_heap_release_due(k);
+}
+
+/* Ticks until the heap head is due. */
+static uint32_t pulse_next_release_ticks(pulse_kernel_t *k)
+{
+    pulse_tick_t when;
+
+    if (k->release_count == 0u)
+    {
+        return 0xFFFFFFFFu;
+    }
+
+    when = PULSE_TASK_RELEASE(k->release_heap[0]);
+
+    if (pulse_time_reached(when, k->now) != 0u)
+    {
+        return 1u;
+    }
+
+    return (pulse_tick_t)(when - k->now);
+}
+#else
+/* Advances every task by n_ticks and releases the ones whose period has
+ * expired. Caller holds the critical section.
+ */
+static void pulse_advance_ticks(pulse_kernel_t *k, uint32_t n_ticks)
+{
+    uint8_t i;
+
+#if (PULSE_CFG_TRACE == 1u)
+    k->trace_now += n_ticks;
+#endif
+    for (i = 0u; i < PULSE_TASK_COUNT; i++)
+    {
+#if (PULSE_CFG_SATURATE_ELAPSED == 1u)
+        if (n_ticks <= (uint32_t)(pulse_tick_t)(PULSE_TICK_MAX - PULSE_TASK_ELAPSED(i)))
+        {
+            PULSE_TASK_ELAPSED(i) = (pulse_tick_t)(PULSE_TASK_ELAPSED(i) + n_ticks);
+        }
+        else
+        {
+            PULSE_TASK_ELAPSED(i) = PULSE_TICK_MAX;
+        }
+#else
+        PULSE_TASK_ELAPSED(i) = (pulse_tick_t)(PULSE_TASK_ELAPSED(i) + n_ticks);
+#endif
+
+        if ((PULSE_TASK_ELAPSED(i) >= PULSE_TASK_PERIOD(i)) && (pulse_running_test(k, i) == 0u) &&
+            (pulse_task_kind(k, i) != PULSE_KIND_SPORADIC))
+        {
+            pulse_task_due(k, i);
+        }
+    }
+}
+
+/* Ticks until the earliest release among tasks that are not already waiting
+ * in ready_mask. Tasks that overran while running are due on the next tick.
+ */
+static uint32_t pulse_next_release_ticks(pulse_kernel_t *k)
+{
+    uint32_t next = 0xFFFFFFFFu;
+    uint8_t i;
+
+    for (i = 0u; i < PULSE_TASK_COUNT; i++)
+    {
+        const pulse_tick_t elapsed = PULSE_TASK_ELAPSED(i);
+        const pulse_tick_t period = PULSE_TASK_PERIOD(i);
+        uint32_t remaining;
+
+        if ((pulse_ready_test(k, i) != 0u) || (pulse_task_kind(k, i) == PULSE_KIND_SPORADIC) ||
+            (pulse_task_suspended(k, i) != 0u))
+        {
+            continue;
+        }
+
+        if (elapsed < period)
+        {
+            remaining = (pulse_tick_t)(period - elapsed);
+        }
+        else
+        {
+            remaining = 1u;
+        }
+
+        if (remaining < next)
+        {
+            next = remaining;
+        }
+    }
+
+    return next;
+}
+#endif /* PULSE_CFG_RELEASE_BACKEND */
+
+/* Catch up from the hardware counter, publish releases and rearm the
+ * one-shot compare. Caller holds the critical section.
+ */
+static void pulse_tickless_sync(pulse_kernel_t *k)
+{
+    const uint32_t n_ticks = PULSE_PORT_TIMER_ELAPSED();
+
+    if (n_ticks != 0u)
+    {
+        pulse_advance_ticks(k, n_ticks);
+    }
+#if (PULSE_CFG_MODES == 1u)
+    if (k->mode_next != (const pulse_mode_t *)0)
+    {
+        pulse_mode_apply(k);
+    }
+#endif
+
+    PULSE_PORT_TIMER_SET_NEXT(pulse_next_release_ticks(k));
+}
+#endif /* PULSE_CFG_TICKLESS */
+
+/* Resets the run-time fields of task idx and files its first release. The
+ * period is already set. Caller holds the critical section or runs with
+ * interrupts disabled.
+ */
+static void pulse_task_setup(pulse_kernel_t *k, uint8_t idx, pulse_state_t init_state, pulse_tick_t offset_ticks, uint8_t fixed)
+{
+    pulse_running_clear(k, idx);
+    PULSE_TASK_STATE(idx) = init_state;
+
+#if (PULSE_CFG_OVERRUN == 1u)
+    PULSE_TASK_OVERRUNS(idx) = 0u;
+    PULSE_TASK_POLICY(idx) = PULSE_OVERRUN_SKIP;
+    PULSE_TASK_CATCHUP_MAX(idx) = 0u;
+    PULSE_TASK_CATCHUP(idx) = 0u;
+#endif
+
+#if (PULSE_CFG_STATS == 1u)
+    pulse_stats_clear(k, idx);
+    k->release_stamp[idx] = PULSE_PORT_TIMESTAMP();
+#endif
+
+#if (PULSE_CFG_AUTO_STAGGER == 1u)
+    if (fixed != 0u)
+    {
+        k->phase_fixed[idx >> 3u] |= pulse_bit8_table[idx & 7u];
+    }
+    else
+    {
+        k->phase_fixed[idx >> 3u] &= (uint8_t)~pulse_bit8_table[idx & 7u];
+    }
+#else
+    (void)fixed;
+#endif
+
+    pulse_task_phase(k, idx, offset_ticks);
+}
+
+void pulse_kernel_init(pulse_kernel_t *k, uint32_t tick_ms)
+{
+    pulse_kernel_init_us(k, (tick_ms < (0xFFFFFFFFu / 1000u)) ? (tick_ms * 1000u) : 0xFFFFFFFFu);
+}
+
+void pulse_kernel_init_us(pulse_kernel_t *k, uint32_t tick_us)
+{
+    uint8_t i;
+
+    if (tick_us == 0u)
+    {
+        tick_us = 1000u;
+    }
+
+#if (PULSE_CFG_STATIC_TASKS == 0u)
+    k->task_count = 0u;
+#endif
+#if (PULSE_CFG_XSIGNAL_MAX > 0u)
+    k->xsignal_count = 0u;
+#endif
+    k->started = 0u;
+    k->tick_us = tick_us;
+    pulse_ready_init(k);
+    pulse_running_init(k);
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    k->now = 0u;
+#endif
+#if (PULSE_CFG_TRACE == 1u)
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_SCAN)
+    k->trace_now = 0u;
+#endif
+    k->trace_head = 0u;
+    k->trace_tail = 0u;
+    k->trace_lost = 0u;
+#endif
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+    k->release_count = 0u;
+#endif
+#if (PULSE_CFG_TASK_CONTROL == 1u)
+    for (i = 0u; i < (uint8_t)((PULSE_MAX_TASKS + 7u) / 8u); i++)
+    {
+        k->suspended[i] = 0u;
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+        k->held[i] = 0u;
+#endif
+    }
+#endif
+#if (PULSE_CFG_MODES == 1u)
+    k->mode = (const pulse_mode_t *)0;
+    k->mode_next = (const pulse_mode_t *)0;
+#endif
+#if (PULSE_CFG_COROUTINES == 1u)
+    for (i = 0u; i < (uint8_t)((PULSE_MAX_TASKS + 7u) / 8u); i++)
+    {
+        k->waiting[i] = 0u;
+    }
+    k->current = 0xFFu;
+#endif
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+    pulse_wheel_clear(k);
+#endif
+
+    for (i = 0u; i < (uint8_t)PULSE_MAX_TASKS; i++)
+    {
+        PULSE_TASK_STATE(i) = 0;
+#if (PULSE_CFG_STATIC_TASKS == 0u)
+        PULSE_TASK_PERIOD(i) = 0u;
+#endif
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+        PULSE_TASK_RELEASE(i) = 0u;
+#else
+        PULSE_TASK_ELAPSED(i) = 0u;
+#endif
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+        k->release_heap[i] = 0u;
+#endif
+#if (PULSE_CFG_STATIC_TASKS == 0u)
+        PULSE_TASK_TICK(i) = (pulse_tick_f)0;
+#endif
+#if (PULSE_PERIOD_DEFERRED == 1u)
+        PULSE_TASK_PERIOD_NEXT(i) = 0u;
+#endif
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+        PULSE_TASK_WHEEL_NEXT(i) = PULSE_WHEEL_NONE;
+#endif
+#if (PULSE_CFG_SPORADIC == 1u)
+        PULSE_TASK_KIND(i) = PULSE_KIND_PERIODIC;
+#endif
+#if (PULSE_CFG_PRIORITY == 1u)
+        k->task_pos[i] = i;
+        k->pos_task[i] = i;
+        k->priority[i] = (uint8_t)PULSE_PRIO_DEFAULT;
+#endif
+    }
+
+#if ((PULSE_CFG_STATIC_TASKS == 1u) && defined(PULSE_TASK_TABLE))
+#if (PULSE_CFG_RUN_IMMEDIATELY == 1u)
+#define PULSE_X_SETUP(name, period, tick, init) \
+    pulse_task_setup(k, (uint8_t)PULSE_TASK_ID_##name, (pulse_state_t)(init), 0u, 0u);
+#else
+#define PULSE_X_SETUP(name, period, tick, init) \
+    pulse_task_setup(k, (uint8_t)PULSE_TASK_ID_##name, (pulse_state_t)(init), (pulse_tick_t)(period), 0u);
+#endif
+    PULSE_TASK_TABLE(PULSE_X_SETUP)
+#undef PULSE_X_SETUP
+#elif (PULSE_CFG_STATIC_TASKS == 1u)
+    for (i = 0u; i < PULSE_TASK_COUNT; i++)
+    {
+#if (PULSE_CFG_RUN_IMMEDIATELY == 1u)
+        pulse_task_setup(k, i, pulse_static_init_state(i), 0u, 0u);
+#else
+        pulse_task_setup(k, i, pulse_static_init_state(i), PULSE_TASK_PERIOD(i), 0u);
+#endif
+    }
+#endif
+}
+
+#if (PULSE_CFG_STATIC_TASKS == 0u)
+static int32_t pulse_add_task_phased(pulse_kernel_t *k,
+                                     pulse_state_t init_state,
+                                     uint32_t period_ticks,
+                                     uint32_t offset_ticks,
+                                     pulse_tick_f tick,
+                                     uint8_t fixed,
+                                     uint8_t kind)
+{
+    uint8_t idx;
+
+    /* A sporadic task's "period" is its guard, which may be 0. */
+    if (((period_ticks == 0u) && (kind == PULSE_KIND_PERIODIC)) || (offset_ticks > period_ticks))
+    {
+        return -1;
+    }
+
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    /* Absolute release times are compared modulo the pulse_tick_t range. */
+    if (period_ticks > (uint32_t)PULSE_PERIOD_MAX)
+#else
+    if (period_ticks > (uint32_t)PULSE_TICK_MAX)
+#endif
+    {
+        return -1;
+    }
+
+#if (PULSE_CFG_NULL_TICK_GUARD == 1u)
+    if (tick == (pulse_tick_f)0)
+    {
+        return -2;
+    }
+#endif
+
+    PULSE_PORT_ENTER_CRITICAL();
+
+    if (k->task_count >= (uint8_t)PULSE_MAX_TASKS)
+    {
+        PULSE_PORT_EXIT_CRITICAL();
+        return -3;
+    }
+
+    idx = k->task_count;
+
+    PULSE_TASK_PERIOD(idx) = (pulse_tick_t)period_ticks;
+#if (PULSE_PERIOD_DEFERRED == 1u)
+    PULSE_TASK_PERIOD_NEXT(idx) = (pulse_tick_t)period_ticks;
+#endif
+    PULSE_TASK_TICK(idx) = tick;
+#if (PULSE_CFG_SPORADIC == 1u)
+    PULSE_TASK_KIND(idx) = kind;
+#else
+    (void)kind;
+#endif
+
+    pulse_task_setup(k, idx, init_state, (pulse_tick_t)offset_ticks, fixed);
+
+    k->task_count = (uint8_t)(k->task_count + 1u);
+
+    PULSE_PORT_EXIT_CRITICAL();
+
+    return 0;
+}
+
+int32_t pulse_kernel_add_task(pulse_kernel_t *k,
+                              pulse_state_t init_state,
+                              uint32_t period_ticks,
+                              pulse_tick_f tick)
+{
+#if (PULSE_CFG_RUN_IMMEDIATELY == 1u)
+    /* Mark ready immediately so tests/superloops can run without waiting a tick. */
+    return pulse_add_task_phased(k, init_state, period_ticks, 0u, tick, 0u, PULSE_KIND_PERIODIC);
+#else
+    return pulse_add_task_phased(k, init_state, period_ticks, period_ticks, tick, 0u, PULSE_KIND_PERIODIC);
+#endif
+}
+
+int32_t pulse_kernel_add_task_ex(pulse_kernel_t *k,
+                                 pulse_state_t init_state,
+                                 uint32_t period_ticks,
+                                 uint32_t offset_ticks,
+                                 pulse_tick_f tick)
+{
+    return pulse_add_task_phased(k, init_state, period_ticks, offset_ticks, tick, 1u, PULSE_KIND_PERIODIC);
+}
+
+#if (PULSE_CFG_SPORADIC == 1u)
+int32_t pulse_kernel_add_sporadic(pulse_kernel_t *k,
+                                  pulse_state_t init_state,
+                                  uint32_t min_gap_ticks,
+                                  pulse_tick_f tick)
+{
+    /* Fixed phase: auto staggering has nothing to place. */
+    return pulse_add_task_phased(k, init_state, min_gap_ticks, 0u, tick, 1u, PULSE_KIND_SPORADIC);
+}
+#endif
+#endif /* !PULSE_CFG_STATIC_TASKS */
+
+#if (PULSE_CFG_AUTO_STAGGER == 1u)
+static uint32_t pulse_gcd(uint32_t a, uint32_t b)
+{
+    while (b != 0u)
+    {
+        const uint32_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+/* Ticks until the next release of a task (0 = ready or due). */
+static uint32_t pulse_task_remaining(pulse_kernel_t *k, uint8_t id)
+{
+    if (pulse_ready_test(k, id) != 0u)
+    {
+        return 0u;
+    }
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    if (pulse_time_reached(PULSE_TASK_RELEASE(id), k->now) != 0u)
+    {
+        return 0u;
+    }
+    return (pulse_tick_t)(PULSE_TASK_RELEASE(id) - k->now);
+#else
+    if (PULSE_TASK_ELAPSED(id) >= PULSE_TASK_PERIOD(id))
+    {
+        return 0u;
+    }
+    return (pulse_tick_t)(PULSE_TASK_PERIOD(id) - PULSE_TASK_ELAPSED(id));
+#endif
+}
+
+static uint8_t pulse_phase_is_fixed(pulse_kernel_t *k, uint8_t id)
+{
+    return ((k->phase_fixed[id >> 3u] & pulse_bit8_table[id & 7u]) != 0u) ? 1u : 0u;
+}
+
+/* Releases at first, first + period, ... inside the horizon. */
+static void pulse_stagger_mark(uint8_t *load, uint32_t horizon, uint32_t first, uint32_t period)
+{
+    uint32_t t;
+
+    for (t = first; t < horizon; t += period)
+    {
+        if (load[t] != 0xFFu)
+        {
+            load[t] = (uint8_t)(load[t] + 1u);
+        }
+    }
+}
+
+static uint8_t pulse_stagger_peak(const uint8_t *load, uint32_t horizon, uint32_t first, uint32_t period)
+{
+    uint8_t peak = 0u;
+    uint32_t t;
+
+    for (t = first; t < horizon; t += period)
+    {
+        if (load[t] > peak)
+        {
+            peak = load[t];
+        }
+    }
+    return peak;
+}
+
+void pulse_kernel_auto_stagger(pulse_kernel_t *k)
+{
+    uint8_t load[PULSE_CFG_STAGGER_HORIZON];
+    uint32_t horizon = 1u;
+    uint32_t last_period = 0u;
+    int32_t last_id = -1;
+    uint32_t t;
+    uint8_t i;
+
+    PULSE_PORT_ENTER_CRITICAL();
+
+    /* Hyperperiod, capped: beyond the cap the pattern is only approximated.
+     * A sporadic task's period is its guard, which may be 0.
+     */
+    for (i = 0u; i < PULSE_TASK_COUNT; i++)
+    {
+        const uint32_t p = PULSE_TASK_PERIOD(i);
+        uint32_t step;
+
+        if (pulse_task_kind(k, i) != PULSE_KIND_PERIODIC)
+        {
+            continue;
+        }
+        step = p / pulse_gcd(horizon, p);
+        if (step > ((uint32_t)PULSE_CFG_STAGGER_HORIZON / horizon))
+        {
+            horizon = (uint32_t)PULSE_CFG_STAGGER_HORIZON;
+            break;
+        }
+        horizon *= step;
+    }
+
+    for (t = 0u; t < horizon; t++)
+    {
+        load[t] = 0u;
+    }
+
+    /* Fixed phases first; every other task is unfiled and placed below. */
+    for (i = 0u; i < PULSE_TASK_COUNT; i++)
+    {
+        if (pulse_phase_is_fixed(k, i) != 0u)
+        {
+            /* Sporadic tasks have no predictable releases to count. */
+            if (pulse_task_kind(k, i) == PULSE_KIND_PERIODIC)
+            {
+                pulse_stagger_mark(load, horizon, pulse_task_remaining(k, i), PULSE_TASK_PERIOD(i));
+            }
+        }
+        else
+        {
+            pulse_ready_clear(k, i);
+        }
+    }
+
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+    k->release_count = 0u;
+    for (i = 0u; i < PULSE_TASK_COUNT; i++)
+    {
+        if ((pulse_phase_is_fixed(k, i) != 0u) && (pulse_ready_test(k, i) == 0u) &&
+            (pulse_task_kind(k, i) != PULSE_KIND_SPORADIC) && (pulse_task_held(k, i) == 0u))
+        {
+            pulse_heap_push(k, i);
+        }
+    }
+#elif (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+    pulse_wheel_clear(k);
+    for (i = 0u; i < PULSE_TASK_COUNT; i++)
+    {
+        if ((pulse_phase_is_fixed(k, i) != 0u) && (pulse_ready_test(k, i) == 0u) &&
+            (pulse_task_kind(k, i) != PULSE_KIND_SPORADIC) && (pulse_task_held(k, i) == 0u))
+        {
+            pulse_wheel_insert(k, i, k->now + 1u);
+        }
+    }
+#endif
+
+    /* Greedy, shortest period first (ties by id): each task takes the phase
+     * whose releases land on the least loaded ticks seen so far.
+     */
+    for (;;)
+    {
+        int32_t pick = -1;
+        uint32_t pick_period = 0u;
+        uint32_t span;
+        uint32_t best = 0u;
+        uint8_t best_peak = 0xFFu;
+        uint32_t o;
+
+        for (i = 0u; i < PULSE_TASK_COUNT; i++)
+        {
+            const uint32_t p = PULSE_TASK_PERIOD(i);
+
+            if (pulse_phase_is_fixed(k, i) != 0u)
+            {
+                continue;
+            }
+            if ((p < last_period) || ((p == last_period) && ((int32_t)i <= last_id)))
+            {
+                continue;
+            }
+            if ((pick < 0) || (p < pick_period))
+            {
+                pick = (int32_t)i;
+                pick_period = p;
+            }
+        }
+
+        if (pick < 0)
+        {
+            break;
+        }
+
+        span = (pick_period < horizon) ? pick_period : horizon;
+        for (o = 0u; o < span; o++)
+        {
+            const uint8_t peak = pulse_stagger_peak(load, horizon, o, pick_period);
+
+            if (peak < best_peak)
+            {
+                best_peak = peak;
+                best = o;
+            }
+        }
+
+        pulse_stagger_mark(load, horizon, best, pick_period);
+
+#if (PULSE_CFG_RUN_IMMEDIATELY == 0u)
+        /* Phase 0 means a first release after one full period. */
+        if (best == 0u)
+        {
+            best = pick_period;
+        }
+#endif
+        pulse_task_phase(k, (uint8_t)pick, (pulse_tick_t)best);
+
+        last_period = pick_period;
+        last_id = pick;
+    }
+
+    PULSE_PORT_EXIT_CRITICAL();
+}
+#endif /* PULSE_CFG_AUTO_STAGGER */
+
+#if (PULSE_CFG_PRIORITY == 1u)
+int32_t pulse_kernel_set_priority(pulse_kernel_t *k, uint8_t id, uint8_t priority)
+{
+    if (id >= PULSE_TASK_COUNT)
+    {
+        return -1;
+    }
+
+    PULSE_PORT_ENTER_CRITICAL();
+    k->priority[id] = priority;
+    PULSE_PORT_EXIT_CRITICAL();
+
+    return 0;
+}
+
+/* Nonzero if the task at position a dispatches before the one at b. */
+static uint8_t pulse_prio_before(pulse_kernel_t *k, uint8_t a, uint8_t b)
+{
+    const uint8_t ida = k->pos_task[a];
+    const uint8_t idb = k->pos_task[b];
+
+    if (k->priority[ida] != k->priority[idb])
+    {
+        return (k->priority[ida] < k->priority[idb]) ? 1u : 0u;
+    }
+#if (PULSE_CFG_AUTO_RM == 1u)
+    if (PULSE_TASK_PERIOD(a) != PULSE_TASK_PERIOD(b))
+    {
+        return (PULSE_TASK_PERIOD(a) < PULSE_TASK_PERIOD(b)) ? 1u : 0u;
+    }
+#endif
+    return (ida < idb) ? 1u : 0u;
+}
+
+static inline uint8_t pulse_prio_relabel(uint8_t ref, uint8_t a, uint8_t b)
+{
+    if (ref == a)
+    {
+        return b;
+    }
+    return (ref == b) ? a : ref;
+}
+
+#define PULSE_SWAP(type, x, y) do { const type pulse_swap_tmp = (x); (x) = (y); (y) = pulse_swap_tmp; } while (0)
+
+/* Exchanges everything held for positions a and b, including the release
+ * queue entries that name them. Caller holds the critical section.
+ */
+static void pulse_prio_swap(pulse_kernel_t *k, uint8_t a, uint8_t b)
+{
+    const uint8_t ready_a = pulse_ready_test(k, a);
+    const uint8_t ready_b = pulse_ready_test(k, b);
+    const uint8_t running_a = pulse_running_test(k, a);
+    const uint8_t running_b = pulse_running_test(k, b);
+    uint8_t i;
+
+#if (PULSE_CFG_TASK_SOA == 1u)
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    PULSE_SWAP(pulse_tick_t, k->next_release[a], k->next_release[b]);
+#else
+    PULSE_SWAP(pulse_tick_t, k->elapsed_ticks[a], k->elapsed_ticks[b]);
+#endif
+    PULSE_SWAP(pulse_tick_t, k->period_ticks[a], k->period_ticks[b]);
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+    PULSE_SWAP(uint8_t, k->wheel_next[a], k->wheel_next[b]);
+#endif
+#if (PULSE_CFG_SPORADIC == 1u)
+    PULSE_SWAP(uint8_t, k->kind[a], k->kind[b]);
+#endif
+    PULSE_SWAP(pulse_state_t, k->state[a], k->state[b]);
+    PULSE_SWAP(pulse_tick_f, k->tick[a], k->tick[b]);
+#if (PULSE_PERIOD_DEFERRED == 1u)
+    PULSE_SWAP(pulse_tick_t, k->period_next[a], k->period_next[b]);
+#endif
+#if (PULSE_CFG_OVERRUN == 1u)
+    PULSE_SWAP(uint32_t, k->overruns[a], k->overruns[b]);
+    PULSE_SWAP(uint8_t, k->overrun_policy[a], k->overrun_policy[b]);
+    PULSE_SWAP(uint8_t, k->catchup_max[a], k->catchup_max[b]);
+    PULSE_SWAP(uint8_t, k->catchup_pending[a], k->catchup_pending[b]);
+#endif
+#else
+    PULSE_SWAP(pulse_task_t, k->tasks[a], k->tasks[b]);
+#endif
+
+#if (PULSE_CFG_STATS == 1u)
+    PULSE_SWAP(pulse_stamp_t, k->release_stamp[a], k->release_stamp[b]);
+    PULSE_SWAP(pulse_task_stats_t, k->stats[a], k->stats[b]);
+#endif
+
+#if (PULSE_CFG_AUTO_STAGGER == 1u)
+    {
+        const uint8_t fixed_a = pulse_phase_is_fixed(k, a);
+        const uint8_t fixed_b = pulse_phase_is_fixed(k, b);
+
+        k->phase_fixed[a >> 3u] &= (uint8_t)~pulse_bit8_table[a & 7u];
+        k->phase_fixed[b >> 3u] &= (uint8_t)~pulse_bit8_table[b & 7u];
+        if (fixed_b != 0u)
+        {
+            k->phase_fixed[a >> 3u] |= pulse_bit8_table[a & 7u];
+        }
+        if (fixed_a != 0u)
+        {
+            k->phase_fixed[b >> 3u] |= pulse_bit8_table[b & 7u];
+        }
+    }
+#endif
+
+#if (PULSE_CFG_TASK_CONTROL == 1u)
+    pulse_flag_swap(k->suspended, a, b);
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    pulse_flag_swap(k->held, a, b);
+#endif
+#endif
+#if (PULSE_CFG_COROUTINES == 1u)
+    pulse_flag_swap(k->waiting, a, b);
+#endif
+
+    pulse_ready_clear(k, a);
+    pulse_ready_clear(k, b);
+    if (ready_b != 0u)
+    {
+        pulse_ready_set(k, a);
+    }
+    if (ready_a != 0u)
+    {
+        pulse_ready_set(k, b);
+    }
+    pulse_running_clear(k, a);
+    pulse_running_clear(k, b);
+    if (running_b != 0u)
+    {
+        pulse_running_set(k, a);
+    }
+    if (running_a != 0u)
+    {
+        pulse_running_set(k, b);
+    }
+
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+    /* Keys move with the tasks, so the heap order still holds. */
+    for (i = 0u; i < k->release_count; i++)
+    {
+        k->release_heap[i] = pulse_prio_relabel(k->release_heap[i], a, b);
+    }
+#elif (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+    {
+        uint8_t level;
+        uint16_t slot;
+
+        for (level = 0u; level < (uint8_t)PULSE_CFG_WHEEL_LEVELS; level++)
+        {
+            for (slot = 0u; slot < (uint16_t)PULSE_WHEEL_SLOTS; slot++)
+            {
+                k->wheel[level][slot] = pulse_prio_relabel(k->wheel[level][slot], a, b);
+            }
+        }
+        for (i = 0u; i < PULSE_TASK_COUNT; i++)
+        {
+            PULSE_TASK_WHEEL_NEXT(i) = pulse_prio_relabel(PULSE_TASK_WHEEL_NEXT(i), a, b);
+        }
+    }
+#else
+    (void)i;
+#endif
+
+    PULSE_SWAP(uint8_t, k->pos_task[a], k->pos_task[b]);
+    k->task_pos[k->pos_task[a]] = a;
+    k->task_pos[k->pos_task[b]] = b;
+}
+
+#undef PULSE_SWAP
+
+void pulse_kernel_apply_priorities(pulse_kernel_t *k)
+{
+    uint8_t pos;
+    uint8_t best;
+    uint8_t i;
+
+    PULSE_PORT_ENTER_CRITICAL();
+
+    /* Selection sort: at most one swap per position, and the key ends in
+     * the id, so the result does not depend on the current order.
+     */
+    for (pos = 0u; (uint8_t)(pos + 1u) < PULSE_TASK_COUNT; pos++)
+    {
+        best = pos;
+        for (i = (uint8_t)(pos + 1u); i < PULSE_TASK_COUNT; i++)
+        {
+            if (pulse_prio_before(k, i, best) != 0u)
+            {
+                best = i;
+            }
+        }
+        if (best != pos)
+        {
+            pulse_prio_swap(k, pos, best);
+        }
+    }
+
+    PULSE_PORT_EXIT_CRITICAL();
+}
+#endif /* PULSE_CFG_PRIORITY */
+
+#if (PULSE_CFG_TASK_CONTROL == 1u)
+int32_t pulse_kernel_suspend(pulse_kernel_t *k, uint8_t id)
+{
+    uint8_t pos;
+
+    if (id >= PULSE_TASK_COUNT)
+    {
+        return -1;
+    }
+
+    PULSE_PORT_ENTER_CRITICAL();
+    pos = PULSE_TASK_POS(id);
+    pulse_flag_set(k->suspended, pos);
+    if (pulse_ready_test(k, pos) != 0u)
+    {
+        /* Released but not dispatched yet: keep it for pulse_resume(). The
+         * scan backend still has it in elapsed_ticks.
+         */
+        pulse_ready_clear(k, pos);
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+        pulse_flag_set(k->held, pos);
+#endif
+    }
+#if (PULSE_CFG_OVERRUN == 1u)
+    PULSE_TASK_CATCHUP(pos) = 0u;
+#endif
+    PULSE_PORT_EXIT_CRITICAL();
+
+    return 0;
+}
+
+int32_t pulse_kernel_resume(pulse_kernel_t *k, uint8_t id)
+{
+    uint8_t pos;
+
+    if (id >= PULSE_TASK_COUNT)
+    {
+        return -1;
+    }
+
+    PULSE_PORT_ENTER_CRITICAL();
+    pos = PULSE_TASK_POS(id);
+    if (pulse_task_suspended(k, pos) != 0u)
+    {
+        pulse_flag_clear(k->suspended, pos);
+
+        /* A held release is served as due now, so the time spent suspended
+         * is not counted as overruns.
+         */
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+        if (pulse_task_held(k, pos) != 0u)
+        {
+            pulse_flag_clear(k->held, pos);
+            PULSE_TASK_RELEASE(pos) = k->now;
+            pulse_task_due(k, pos);
+        }
+#else
+        if ((pulse_running_test(k, pos) == 0u) && (pulse_task_kind(k, pos) != PULSE_KIND_SPORADIC) &&
+            (PULSE_TASK_ELAPSED(pos) >= PULSE_TASK_PERIOD(pos)))
+        {
+            PULSE_TASK_ELAPSED(pos) = PULSE_TASK_PERIOD(pos);
+            pulse_task_due(k, pos);
+        }
+#endif
+    }
+    PULSE_PORT_EXIT_CRITICAL();
+
+    return 0;
+}
+
+#if (PULSE_CFG_STATIC_TASKS == 0u)
+int32_t pulse_kernel_set_period(pulse_kernel_t *k, uint8_t id, uint32_t period_ticks)
+{
+    int32_t rc = -1;
+    uint8_t pos;
+
+    if (id >= PULSE_TASK_COUNT)
+    {
+        return -1;
+    }
+
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    if (period_ticks > (uint32_t)PULSE_PERIOD_MAX)
+#else
+    if (period_ticks > (uint32_t)PULSE_TICK_MAX)
+#endif
+    {
+        return -1;
+    }
+
+    PULSE_PORT_ENTER_CRITICAL();
+    pos = PULSE_TASK_POS(id);
+    if ((period_ticks != 0u) || (pulse_task_kind(k, pos) != PULSE_KIND_PERIODIC))
+    {
+#if (PULSE_PERIOD_DEFERRED == 1u)
+        PULSE_TASK_PERIOD_NEXT(pos) = (pulse_tick_t)period_ticks;
+#else
+        /* The pending release time is already fixed; the release queue
+         * reads the period only when it files the one after.
+         */
+        PULSE_TASK_PERIOD(pos) = (pulse_tick_t)period_ticks;
+#endif
+        rc = 0;
+    }
+    PULSE_PORT_EXIT_CRITICAL();
+
+    return rc;
+}
+#endif
+#endif /* PULSE_CFG_TASK_CONTROL */
+
+#if (PULSE_CFG_MODES == 1u)
+int32_t pulse_kernel_set_mode(pulse_kernel_t *k, const pulse_mode_t *mode)
+{
+    if ((mode == (const pulse_mode_t *)0) || (mode->count > (uint8_t)PULSE_MAX_TASKS) ||
+        ((mode->count != 0u) && (mode->periods == (const uint32_t *)0)))
+    {
+        return -1;
+    }
+
+    {
+        uint8_t id;
+
+        for (id = 0u; id < mode->count; id++)
+        {
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+            if ((mode->periods[id] > (uint32_t)PULSE_PERIOD_MAX) && (mode->periods[id] != PULSE_MODE_KEEP))
+#else
+            if ((mode->periods[id] > (uint32_t)PULSE_TICK_MAX) && (mode->periods[id] != PULSE_MODE_KEEP))
+#endif
+            {
+                return -1;
+            }
+        }
+    }
+
+    /* The switch itself waits for the tick; only the request is stored. */
+    PULSE_PORT_ENTER_CRITICAL();
+    k->mode_next = mode;
+    PULSE_PORT_EXIT_CRITICAL();
+
+    return 0;
+}
+
+const pulse_mode_t *pulse_kernel_get_mode(const pulse_kernel_t *k)
+{
+    const pulse_mode_t *mode;
+
+    PULSE_PORT_ENTER_CRITICAL();
+    mode = k->mode;
+    PULSE_PORT_EXIT_CRITICAL();
+
+    return mode;
+}
+#endif /* PULSE_CFG_MODES */
+
+#if (PULSE_CFG_COROUTINES == 1u)
+int32_t pulse_kernel_wait_ticks(pulse_kernel_t *k, uint32_t ticks)
+{
+    const uint8_t id = k->current;
+
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    if ((id == 0xFFu) || (ticks > (uint32_t)PULSE_PERIOD_MAX))
+#else
+    if ((id == 0xFFu) || (ticks > (uint32_t)PULSE_TICK_MAX))
+#endif
+    {
+        return -1;
+    }
+
+    /* The task is running, so it is in no release queue and the tick ISR
+     * does not release it; pulse_task_retire() files it.
+     */
+    PULSE_PORT_ENTER_CRITICAL();
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    PULSE_TASK_RELEASE(id) = (pulse_tick_t)(k->now + ticks);
+#else
+    /* period_next keeps the real period for the dispatch that ends the wait. */
+    PULSE_TASK_ELAPSED(id) = 0u;
+    PULSE_TASK_PERIOD(id) = (pulse_tick_t)ticks;
+#endif
+#if (PULSE_CFG_OVERRUN == 1u)
+    PULSE_TASK_CATCHUP(id) = 0u;
+#endif
+#if (PULSE_CFG_SPORADIC == 1u)
+    if (PULSE_TASK_KIND(id) != PULSE_KIND_PERIODIC)
+    {
+        /* A pending signal merges into the wake-up. */
+        PULSE_TASK_KIND(id) = PULSE_KIND_SIGNALLED;
+    }
+    else
+#endif
+    {
+        pulse_flag_set(k->waiting, id);
+    }
+    PULSE_PORT_EXIT_CRITICAL();
+
+    return 0;
+}
+#endif
+
+#if (PULSE_CFG_STATS == 1u)
+int32_t pulse_kernel_get_task_stats(pulse_kernel_t *k, uint8_t id, pulse_task_stats_t *out)
+{
+    if ((out == (pulse_task_stats_t *)0) || (id >= PULSE_TASK_COUNT))
+    {
+        return -1;
+    }
+
+    PULSE_PORT_ENTER_CRITICAL();
+    *out = k->stats[PULSE_TASK_POS(id)];
+    PULSE_PORT_EXIT_CRITICAL();
+
+    return 0;
+}
+
+void pulse_kernel_reset_task_stats(pulse_kernel_t *k, uint8_t id)
+{
+    if (id < PULSE_TASK_COUNT)
+    {
+        PULSE_PORT_ENTER_CRITICAL();
+        pulse_stats_clear(k, PULSE_TASK_POS(id));
+        PULSE_PORT_EXIT_CRITICAL();
+    }
+}
+#endif /* PULSE_CFG_STATS */
+
+#if (PULSE_CFG_OVERRUN == 1u)
+int32_t pulse_kernel_set_overrun_policy(pulse_kernel_t *k, uint8_t id, uint8_t policy, uint8_t catchup_max)
+{
+    uint8_t pos;
+
+    if ((id >= PULSE_TASK_COUNT) || (policy > PULSE_OVERRUN_CATCHUP))
+    {
+        return -1;
+    }
+
+    PULSE_PORT_ENTER_CRITICAL();
+    pos = PULSE_TASK_POS(id);
+    PULSE_TASK_POLICY(pos) = policy;
+    PULSE_TASK_CATCHUP_MAX(pos) = (policy == PULSE_OVERRUN_CATCHUP) ? catchup_max : 0u;
+    if (PULSE_TASK_CATCHUP(pos) > PULSE_TASK_CATCHUP_MAX(pos))
+    {
+        PULSE_TASK_CATCHUP(pos) = PULSE_TASK_CATCHUP_MAX(pos);
+    }
+    PULSE_PORT_EXIT_CRITICAL();
+
+    return 0;
+}
+
+uint32_t pulse_kernel_get_overruns(pulse_kernel_t *k, uint8_t id)
+{
+    uint32_t n = 0u;
+
+    if (id < PULSE_TASK_COUNT)
+    {
+        PULSE_PORT_ENTER_CRITICAL();
+        n = PULSE_TASK_OVERRUNS(PULSE_TASK_POS(id));
+        PULSE_PORT_EXIT_CRITICAL();
+    }
+
+    return n;
+}
+#endif /* PULSE_CFG_OVERRUN */
+
+#if (PULSE_CFG_TRACE == 1u)
+uint16_t pulse_kernel_trace_read(pulse_kernel_t *k, pulse_trace_rec_t *out, uint16_t max)
+{
+    uint16_t n = 0u;
+
+    if (out == (pulse_trace_rec_t *)0)
+    {
+        return 0u;
+    }
+
+    PULSE_PORT_ENTER_CRITICAL();
+    while ((n < max) && (k->trace_tail != k->trace_head))
+    {
+        out[n] = k->trace[k->trace_tail & PULSE_TRACE_MASK];
+        k->trace_tail = (uint16_t)(k->trace_tail + 1u);
+        n++;
+    }
+    PULSE_PORT_EXIT_CRITICAL();
+
+    return n;
+}
+
+void pulse_trace_encode(const pulse_trace_rec_t *rec, uint8_t *out)
+{
+    out[0] = (uint8_t)(rec->tick & 0xFFu);
+    out[1] = (uint8_t)((rec->tick >> 8u) & 0xFFu);
+    out[2] = (uint8_t)((rec->tick >> 16u) & 0xFFu);
+    out[3] = (uint8_t)((rec->tick >> 24u) & 0xFFu);
+    out[4] = (uint8_t)(rec->sub & 0xFFu);
+    out[5] = (uint8_t)((rec->sub >> 8u) & 0xFFu);
+    out[6] = rec->event;
+    out[7] = rec->id;
+}
+#endif /* PULSE_CFG_TRACE */
+
+uint8_t pulse_kernel_is_started(const pulse_kernel_t *k)
+{
+    return k->started;
+}
+
+uint32_t pulse_kernel_tick_period_ms(const pulse_kernel_t *k)
+{
+    return k->tick_us / 1000u;
+}
+
+uint32_t pulse_kernel_tick_period_us(const pulse_kernel_t *k)
+{
+    return k->tick_us;
+}
+
+#if (PULSE_CFG_TICKLESS == 1u)
+void pulse_kernel_tick_isr(pulse_kernel_t *k)
+{
+    PULSE_PORT_ENTER_CRITICAL();
+    pulse_tickless_sync(k);
+    PULSE_PORT_EXIT_CRITICAL();
+}
+#elif (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+void pulse_kernel_tick_isr(pulse_kernel_t *k)
+{
+    k->now++;
+#if (PULSE_CFG_MODES == 1u)
+    pulse_mode_tick(k);
+#endif
+
+    /* Common case: the earliest release is still in the future. */
+    if ((k->release_count != 0u) &&
+        (pulse_time_reached(PULSE_TASK_RELEASE(k->release_heap[0]),
+                            k->now) != 0u))
+    {
+        PULSE_PORT_ENTER_CRITICAL();
+        pulse_heap_release_due(k);
+        PULSE_PORT_EXIT_CRITICAL();
+    }
+}
+#elif (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+void pulse_kernel_tick_isr(pulse_kernel_t *k)
+{
+    uint8_t slot;
+    uint8_t id;
+
+    k->now++;
+#if (PULSE_CFG_MODES == 1u)
+    pulse_mode_tick(k);
+#endif
+
+    slot = (uint8_t)(k->now & PULSE_WHEEL_MASK);
+
+    /* Inner wheel wrapped: pull the next outer slot in, and so on outwards. */
+    if (slot == 0u)
+    {
+        uint8_t level = 1u;
+
+        PULSE_PORT_ENTER_CRITICAL();
+        while ((level < (uint8_t)PULSE_CFG_WHEEL_LEVELS) && (pulse_wheel_cascade(k, level) == 0u))
+        {
+            level = (uint8_t)(level + 1u);
+        }
+        PULSE_PORT_EXIT_CRITICAL();
+    }
+
+    /* Common case: nothing expires on this tick. */
+    if (k->wheel[0][slot] != PULSE_WHEEL_NONE)
+    {
+        PULSE_PORT_ENTER_CRITICAL();
+        id = k->wheel[0][slot];
+        k->wheel[0][slot] = PULSE_WHEEL_NONE;
+
+        while (id != PULSE_WHEEL_NONE)
+        {
+            const uint8_t next = PULSE_TASK_WHEEL_NEXT(id);
+
+            if (pulse_time_reached(PULSE_TASK_RELEASE(id), k->now) != 0u)
+            {
+                PULSE_TASK_WHEEL_NEXT(id) = PULSE_WHEEL_NONE;
+                pulse_task_due(k, id);
+            }
+            else
+            {
+                /* Parked beyond the wheel span (single-level wheels only). */
+                pulse_wheel_insert(k, id, k->now + 1u);
+            }
+            id = next;
+        }
+        PULSE_PORT_EXIT_CRITICAL();
+    }
+}
+#else
+static inline void pulse_tick_task(pulse_kernel_t *k, pulse_batch_t *released, uint8_t i, pulse_tick_t period)
+{
+#if (PULSE_CFG_SATURATE_ELAPSED == 1u)
+    if (PULSE_TASK_ELAPSED(i) < PULSE_TICK_MAX)
+    {
+        PULSE_TASK_ELAPSED(i)++;
+    }
+#else
+    PULSE_TASK_ELAPSED(i)++;
+#endif
+
+    if (PULSE_TASK_ELAPSED(i) >= period)
+    {
+        /* An idle sporadic task waits for a signal; its period is the guard.
+         * A suspended one keeps counting, so resume finds the release.
+         */
+        if ((pulse_running_test(k, i) == 0u) && (pulse_task_kind(k, i) != PULSE_KIND_SPORADIC) &&
+            (pulse_task_suspended(k, i) == 0u))
+        {
+            /* Do not reset elapsed_ticks here; reset when task actually runs.
+             * This avoids losing releases if polling is delayed.
+             */
+            PULSE_NOTE_RELEASE(i);
+            pulse_batch_add(released, i);
+        }
+    }
+}
+
+void pulse_kernel_tick_isr(pulse_kernel_t *k)
+{
+    pulse_batch_t released;
+
+    pulse_batch_init(&released);
+#if (PULSE_CFG_TRACE == 1u)
+    k->trace_now++;
+#endif
+
+#if ((PULSE_CFG_STATIC_TASKS == 1u) && defined(PULSE_TASK_TABLE))
+    /* One check per table entry, with the period as an immediate. */
+#define PULSE_X_TICK(name, period, tick, init) \
+    pulse_tick_task(k, &released, (uint8_t)PULSE_TASK_ID_##name, (pulse_tick_t)(period));
+    PULSE_TASK_TABLE(PULSE_X_TICK)
+#undef PULSE_X_TICK
+#else
+    {
+        uint8_t i;
+
+        for (i = 0u; i < PULSE_TASK_COUNT; i++)
+        {
+            pulse_tick_task(k, &released, i, PULSE_TASK_PERIOD(i));
+        }
+    }
+#endif
+
+    /* Publish every release of this tick in one critical section. */
+    if (pulse_batch_empty(&released) == 0u)
+    {
+        PULSE_READY_ENTER();
+        pulse_ready_publish(k, &released);
+        PULSE_READY_EXIT();
+    }
+#if (PULSE_CFG_MODES == 1u)
+    /* After this tick's releases, so they are judged by the old mode. */
+    pulse_mode_tick(k);
+#endif
+}
+#endif /* PULSE_CFG_TICKLESS */
+
+#if ((PULSE_CFG_SPORADIC == 1u) || (PULSE_CFG_COROUTINES == 1u))
+/* Releases an idle task now if its next release is already due, or queues
+ * it for when it is (the scan ISR finds it by itself): a signalled sporadic
+ * task once its guard expires, a coroutine at the end of its wait. Caller
+ * holds the critical section.
+ */
+static void pulse_task_file(pulse_kernel_t *k, uint8_t id)
+{
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    if (pulse_time_reached(PULSE_TASK_RELEASE(id), k->now) != 0u)
+    {
+        pulse_task_due(k, id);
+    }
+    else
+    {
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+        pulse_heap_push(k, id);
+#else
+        pulse_wheel_insert(k, id, k->now + 1u);
+#endif
+    }
+#else
+    if (PULSE_TASK_ELAPSED(id) >= PULSE_TASK_PERIOD(id))
+    {
+        pulse_task_due(k, id);
+    }
+#endif
+}
+#endif
+
+#if (PULSE_CFG_SPORADIC == 1u)
+int32_t pulse_kernel_signal_isr(pulse_kernel_t *k, uint8_t id)
+{
+    int32_t rc = -1;
+    uint8_t pos;
+
+    PULSE_PORT_ENTER_CRITICAL();
+    if (id < PULSE_TASK_COUNT)
+    {
+        pos = PULSE_TASK_POS(id);
+        if (PULSE_TASK_KIND(pos) != PULSE_KIND_PERIODIC)
+        {
+            /* Already signalled: this one merges into the pending release. */
+            if (PULSE_TASK_KIND(pos) == PULSE_KIND_SPORADIC)
+            {
+                PULSE_TASK_KIND(pos) = PULSE_KIND_SIGNALLED;
+
+                /* A running task is kicked by pulse_task_retire() instead. */
+                if (pulse_running_test(k, pos) == 0u)
+                {
+                    pulse_task_file(k, pos);
+                }
+            }
+            rc = 0;
+        }
+    }
+    PULSE_PORT_EXIT_CRITICAL();
+
+    return rc;
+}
+#endif /* PULSE_CFG_SPORADIC */
+
+#if (PULSE_CFG_XSIGNAL_MAX > 0u)
+int32_t pulse_kernel_xsignal_attach(pulse_kernel_t *k, pulse_xsignal_t *ch, uint8_t id)
+{
+    int32_t rc = -1;
+
+    PULSE_PORT_ENTER_CRITICAL();
+    if ((ch != (pulse_xsignal_t *)0) && (id < PULSE_TASK_COUNT) && (PULSE_TASK_KIND(PULSE_TASK_POS(id)) != PULSE_KIND_PERIODIC))
+    {
+        if (k->xsignal_count >= (uint8_t)PULSE_CFG_XSIGNAL_MAX)
+        {
+            rc = -3;
+        }
+        else
+        {
+            ch->seen = ch->sent;
+            ch->task_id = id;
+            k->xsignal[k->xsignal_count] = ch;
+            k->xsignal_count = (uint8_t)(k->xsignal_count + 1u);
+            rc = 0;
+        }
+    }
+    PULSE_PORT_EXIT_CRITICAL();
+
+    return rc;
+}
+
+void pulse_xsignal_send(pulse_xsignal_t *ch)
+{
+    /* Whatever the signal hands over is visible before the count moves. */
+    PULSE_PORT_MEMORY_BARRIER();
+    ch->sent = (PULSE_PORT_WORD_T)(ch->sent + 1u);
+    PULSE_PORT_XSIGNAL_NOTIFY(ch);
+}
+
+/* Turns new counts on the watched channels into releases. One load per
+ * channel when nothing is pending; runs in main context only.
+ */
+static void pulse_xsignal_collect(pulse_kernel_t *k)
+{
+    uint8_t i;
+
+    for (i = 0u; i < k->xsignal_count; i++)
+    {
+        pulse_xsignal_t * const ch = k->xsignal[i];
+        const PULSE_PORT_WORD_T sent = ch->sent;
+
+        if (sent != ch->seen)
+        {
+            ch->seen = sent;
+            /* Data read by the task comes after the count that announced it. */
+            PULSE_PORT_MEMORY_BARRIER();
+            (void)pulse_kernel_signal_isr(k, ch->task_id);
+        }
+    }
+}
+#endif /* PULSE_CFG_XSIGNAL_MAX */
+
+#if (PULSE_CFG_OVERRUN == 1u)
+/* Counts the releases missed by a dispatch that is `late` ticks behind its
+ * release time and applies the task's policy. Returns the ticks to move the
+ * release grid forward by, for PHASE/CATCHUP: whole periods past the release
+ * that is being served now.
+ */
+static pulse_tick_t pulse_overrun_account(pulse_kernel_t *k, uint8_t id, pulse_tick_t late)
+{
+    const pulse_tick_t period = PULSE_TASK_PERIOD(id);
+    uint32_t missed = 0u;
+
+    /* Division only when at least one release was actually missed. */
+    if (late >= period)
+    {
+        missed = (uint32_t)(late / period);
+#if (PULSE_CFG_TRACE == 1u)
+        pulse_trace_put(k, PULSE_TRACE_OVERRUN, PULSE_TASK_ID(id), (uint16_t)((missed < 0xFFFFu) ? missed : 0xFFFFu));
+#endif
+    }
+
+    if (PULSE_TASK_OVERRUNS(id) <= (0xFFFFFFFFu - missed))
+    {
+        PULSE_TASK_OVERRUNS(id) += missed;
+    }
+    else
+    {
+        PULSE_TASK_OVERRUNS(id) = 0xFFFFFFFFu;
+    }
+
+    if (PULSE_TASK_POLICY(id) == PULSE_OVERRUN_CATCHUP)
+    {
+        const uint32_t owed = (uint32_t)PULSE_TASK_CATCHUP(id) + missed;
+        const uint32_t cap = (uint32_t)PULSE_TASK_CATCHUP_MAX(id);
+
+        PULSE_TASK_CATCHUP(id) = (uint8_t)((owed < cap) ? owed : cap);
+    }
+
+    return (pulse_tick_t)(missed * period);
+}
+#endif
+
+/* Marks a ready task as running and restarts its period. Caller holds the
+ * critical section and removes it from the ready set afterwards.
+ */
+static inline void pulse_task_claim(pulse_kernel_t *k, uint8_t id)
+{
+    pulse_running_set(k, id);
+#if (PULSE_CFG_SPORADIC == 1u)
+    if (PULSE_TASK_KIND(id) != PULSE_KIND_PERIODIC)
+    {
+        /* Consumes the signal; the guard counts from this dispatch. */
+        PULSE_TASK_KIND(id) = PULSE_KIND_SPORADIC;
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+        PULSE_TASK_RELEASE(id) = (pulse_tick_t)(k->now + PULSE_TASK_PERIOD(id));
+#else
+        PULSE_TASK_ELAPSED(id) = 0u;
+#endif
+#if (PULSE_PERIOD_DEFERRED == 1u)
+        PULSE_TASK_PERIOD(id) = PULSE_TASK_PERIOD_NEXT(id);
+#endif
+        return;
+    }
+#endif
+#if (PULSE_CFG_COROUTINES == 1u)
+    if (pulse_flag_test(k->waiting, id) != 0u)
+    {
+        /* End of a wait: not an overrun; the period counts from here. */
+        pulse_flag_clear(k->waiting, id);
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+        PULSE_TASK_RELEASE(id) = (pulse_tick_t)(k->now + PULSE_TASK_PERIOD(id));
+#else
+        PULSE_TASK_ELAPSED(id) = 0u;
+        PULSE_TASK_PERIOD(id) = PULSE_TASK_PERIOD_NEXT(id);
+#endif
+        return;
+    }
+#endif
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+#if (PULSE_CFG_OVERRUN == 1u)
+    /* A catch-up run is dispatched before its grid time: timing stays. */
+    if (pulse_time_reached(PULSE_TASK_RELEASE(id), k->now) != 0u)
+    {
+        const pulse_tick_t due = PULSE_TASK_RELEASE(id);
+        const pulse_tick_t skip = pulse_overrun_account(k, id, (pulse_tick_t)(k->now - due));
+
+        if (PULSE_TASK_POLICY(id) == PULSE_OVERRUN_SKIP)
+        {
+            PULSE_TASK_RELEASE(id) = (pulse_tick_t)(k->now + PULSE_TASK_PERIOD(id));
+        }
+        else
+        {
+            PULSE_TASK_RELEASE(id) = (pulse_tick_t)(due + skip + PULSE_TASK_PERIOD(id));
+        }
+    }
+#else
+    /* Period counts from the dispatch, as elapsed_ticks = 0 does. */
+    PULSE_TASK_RELEASE(id) = (pulse_tick_t)(k->now + PULSE_TASK_PERIOD(id));
+#endif
+#else
+#if (PULSE_CFG_OVERRUN == 1u)
+    /* A catch-up run is dispatched before its grid time: timing stays, and
+     * so does the old period until that release is served.
+     */
+    if (PULSE_TASK_ELAPSED(id) >= PULSE_TASK_PERIOD(id))
+    {
+        const pulse_tick_t late = (pulse_tick_t)(PULSE_TASK_ELAPSED(id) - PULSE_TASK_PERIOD(id));
+        pulse_tick_t skip;
+
+#if (PULSE_PERIOD_DEFERRED == 1u)
+        /* The old period ended at the release being served; missed releases
+         * after it follow the new one, as on the release queue.
+         */
+        PULSE_TASK_PERIOD(id) = PULSE_TASK_PERIOD_NEXT(id);
+#endif
+        skip = pulse_overrun_account(k, id, late);
+        if (PULSE_TASK_POLICY(id) == PULSE_OVERRUN_SKIP)
+        {
+            PULSE_TASK_ELAPSED(id) = 0u;
+        }
+        else
+        {
+            /* Keep the remainder instead of zeroing: stays on the grid. */
+            PULSE_TASK_ELAPSED(id) = (pulse_tick_t)(late - skip);
+        }
+    }
+#else
+    PULSE_TASK_ELAPSED(id) = 0u;
+#if (PULSE_PERIOD_DEFERRED == 1u)
+    /* The old period has been served; a new one counts from here. */
+    PULSE_TASK_PERIOD(id) = PULSE_TASK_PERIOD_NEXT(id);
+#endif
+#endif
+#endif
+}
+
+static inline void pulse_task_run(pulse_kernel_t *k, uint8_t id)
+{
+#if (PULSE_CFG_STATS == 1u)
+    /* The task is marked running, so the ISR leaves its release stamp alone. */
+    pulse_task_stats_t * const st = &k->stats[id];
+    pulse_stamp_t start;
+    pulse_stamp_t latency;
+    pulse_stamp_t exec;
+#endif
+
+    PULSE_TRACE_MAIN(PULSE_TRACE_RUN, id);
+#if (PULSE_CFG_STATS == 1u)
+    start = PULSE_PORT_TIMESTAMP();
+    latency = (pulse_stamp_t)(start - k->release_stamp[id]);
+#endif
+
+#if (PULSE_CFG_COROUTINES == 1u)
+    k->current = id;
+#endif
+#if (PULSE_CFG_STATIC_TASKS == 1u)
+    PULSE_TASK_STATE(id) = pulse_static_dispatch(id, PULSE_TASK_STATE(id));
+#else
+#if (PULSE_CFG_NULL_TICK_GUARD == 1u)
+    if (PULSE_TASK_TICK(id) != (pulse_tick_f)0)
+#endif
+    {
+        PULSE_TASK_STATE(id) = PULSE_TASK_TICK(id)(PULSE_TASK_STATE(id));
+    }
+#endif
+#if (PULSE_CFG_COROUTINES == 1u)
+    k->current = 0xFFu;
 #endif
 
-#ifndef PULSE_PORT_IDLE_HOOK
-#define PULSE_PORT_IDLE_HOOK() do { } while (0)
+#if (PULSE_CFG_STATS == 1u)
+    exec = (pulse_stamp_t)(PULSE_PORT_TIMESTAMP() - start);
 #endif
+    PULSE_TRACE_MAIN(PULSE_TRACE_DONE, id);
 
-/* -------------------------- Types -------------------------- */
-
-typedef int32_t pulse_state_t;
-
-typedef pulse_state_t (*pulse_tick_f)(pulse_state_t state);
-
-typedef struct
-{
-    uint8_t       running;       /* 0 = not running, 1 = running */
-    pulse_state_t state;         /* task state for state-machine style tasks */
-    uint32_t      period_ticks;  /* task period in ticks (must be > 0) */
-    uint32_t      elapsed_ticks; /* elapsed ticks since last run */
-    pulse_tick_f  tick;          /* tick function */
-} pulse_task_t;
+#if (PULSE_CFG_STATS == 1u)
+    st->runs++;
+    st->exec_total += (uint64_t)exec;
+    if (exec < st->exec_min)
+    {
+        st->exec_min = exec;
+    }
+    if (exec > st->exec_max)
+    {
+        st->exec_max = exec;
+    }
+    if (latency > st->latency_max)
+    {
+        st->latency_max = latency;
+    }
+#endif
+}
 
-typedef struct
+/* Clears running and requeues the next release. Caller holds the critical
+ * section.
+ */
+static inline void pulse_task_retire(pulse_kernel_t *k, uint8_t id)
 {
-    pulse_task_t tasks[PULSE_MAX_TASKS];
-    uint8_t      task_count;
-
-    /* Ready bitmask: bit i set => task i is ready to run.
-     * ISR sets bits; pulse_poll() clears and runs tasks.
+    pulse_running_clear(k, id);
+#if (PULSE_CFG_COROUTINES == 1u)
+    if (pulse_flag_test(k->waiting, id) != 0u)
+    {
+        /* Between slices: released by the wait, which may be over already. */
+        pulse_task_file(k, id);
+        return;
+    }
+#endif
+#if (PULSE_CFG_OVERRUN == 1u)
+    if (PULSE_TASK_CATCHUP(id) != 0u)
+    {
+        /* Owed a catch-up run: straight back into the ready set. The regular
+         * release is requeued once the burst is over.
+         */
+        PULSE_TASK_CATCHUP(id) = (uint8_t)(PULSE_TASK_CATCHUP(id) - 1u);
+        pulse_task_due(k, id);
+        return;
+    }
+#endif
+#if (PULSE_CFG_SPORADIC == 1u)
+    if (PULSE_TASK_KIND(id) != PULSE_KIND_PERIODIC)
+    {
+        /* Signalled while it ran: release as soon as the guard allows. */
+        if (PULSE_TASK_KIND(id) == PULSE_KIND_SIGNALLED)
+        {
+            pulse_task_file(k, id);
+        }
+        return;
+    }
+#endif
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+    /* Requeue only once the task is done, so an overrunning task is
+     * released on the next tick after it returns, never while running.
      */
-    uint64_t     ready_mask;
-
-    uint8_t      started;
-
-    uint32_t     tick_ms;
-} pulse_kernel_t;
-
-/* -------------------------- API -------------------------- */
-
-void pulse_init(uint32_t tick_ms);
+    pulse_heap_push(k, id);
+#elif (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+    pulse_wheel_insert(k, id, k->now + 1u);
+#endif
+}
 
-int32_t pulse_add_task(pulse_state_t init_state,
-                       uint32_t period_ticks,
-                       pulse_tick_f tick);
+/* Claims, runs and retires the first ready task. Returns 0 if none was
+ * ready (and, in tickless builds, after rearming the compare).
+ */
+static inline uint8_t pulse_poll_one(pulse_kernel_t *k)
+{
+    int32_t id;
 
-void pulse_start(void);
+#if (PULSE_CFG_XSIGNAL_MAX > 0u)
+    pulse_xsignal_collect(k);
+#endif
+    PULSE_READY_ENTER();
+    id = pulse_ready_first(k);
+#if (PULSE_CFG_TICKLESS == 1u)
+    if (id < 0)
+    {
+        /* Nothing left to run: account for the time the batch took and
+         * arm the compare for the next release before returning.
+         */
+        pulse_tickless_sync(k);
+        id = pulse_ready_first(k);
+    }
+#endif
+    if (id >= 0)
+    {
+        /* Running first: a lock-free ISR must not release it again. */
+        pulse_task_claim(k, (uint8_t)id);
+        pulse_ready_clear(k, (uint8_t)id);
+    }
+    PULSE_READY_EXIT();
 
-/* Call from your timer ISR: marks tasks ready only. */
-void pulse_tick_isr(void);
+    if (id < 0)
+    {
+        return 0u;
+    }
 
-/* Run all ready tasks (highest priority first) in main/thread context. */
-void pulse_poll(void);
+    pulse_task_run(k, (uint8_t)id);
 
-uint8_t pulse_is_started(void);
+    PULSE_READY_ENTER();
+    pulse_task_retire(k, (uint8_t)id);
+    PULSE_READY_EXIT();
+    return 1u;
+}
 
-uint32_t pulse_tick_period_ms(void);
+/* Tasks still ready when a bounded poll stops early. */
+static uint8_t pulse_poll_pending(pulse_kernel_t *k)
+{
+    uint8_t n;
 
-/* -------------------------- Convenience macros -------------------------- */
+#if (PULSE_CFG_XSIGNAL_MAX > 0u)
+    pulse_xsignal_collect(k);
+#endif
+    PULSE_READY_ENTER();
+    n = pulse_ready_count(k);
+#if (PULSE_CFG_TICKLESS == 1u)
+    if (n == 0u)
+    {
+        pulse_tickless_sync(k);
+        n = pulse_ready_count(k);
+    }
+#endif
+    PULSE_READY_EXIT();
+    return n;
+}
 
-#define PULSE_UNUSED(x) do { (void)(x); } while (0)
+#if (PULSE_CFG_BATCH_DISPATCH == 1u)
+void pulse_kernel_poll(pulse_kernel_t *k)
+{
+    pulse_batch_t batch;
+    pulse_batch_t walk;
+    int32_t id;
 
-/* -------------------------- Implementation -------------------------- */
+    for (;;)
+    {
+#if (PULSE_CFG_XSIGNAL_MAX > 0u)
+        pulse_xsignal_collect(k);
+#endif
+        PULSE_READY_ENTER();
+#if (PULSE_CFG_LOCK_FREE == 1u)
+        pulse_ready_peek(k, &batch);
+#else
+        pulse_ready_take(k, &batch);
+#endif
+#if (PULSE_CFG_TICKLESS == 1u)
+        if (pulse_batch_empty(&batch) != 0u)
+        {
+            pulse_tickless_sync(k);
+            pulse_ready_take(k, &batch);
+        }
+#endif
+        walk = batch;
+        for (id = pulse_batch_pop(&walk); id >= 0; id = pulse_batch_pop(&walk))
+        {
+            pulse_task_claim(k, (uint8_t)id);
+        }
+#if (PULSE_CFG_LOCK_FREE == 1u)
+        pulse_ready_drop(k, &batch);
+#endif
+        PULSE_READY_EXIT();
 
-#ifdef PULSE_IMPLEMENTATION
+        if (pulse_batch_empty(&batch) != 0u)
+        {
+            break;
+        }
 
-static pulse_kernel_t pulse_kernel;
+        walk = batch;
+        for (id = pulse_batch_pop(&walk); id >= 0; id = pulse_batch_pop(&walk))
+        {
+            pulse_task_run(k, (uint8_t)id);
+        }
 
-static uint64_t pulse_task_bit(uint8_t id)
+        PULSE_READY_ENTER();
+        for (id = pulse_batch_pop(&batch); id >= 0; id = pulse_batch_pop(&batch))
+        {
+            pulse_task_retire(k, (uint8_t)id);
+        }
+        PULSE_READY_EXIT();
+    }
+}
+#else
+void pulse_kernel_poll(pulse_kernel_t *k)
 {
-    return (uint64_t)1u << (uint64_t)id;
+    while (pulse_poll_one(k) != 0u)
+    {
+    }
 }
+#endif /* PULSE_CFG_BATCH_DISPATCH */
 
-static int32_t pulse_find_lowest_set_bit(uint64_t mask)
+uint8_t pulse_kernel_poll_bounded(pulse_kernel_t *k, uint8_t max_tasks)
 {
-    uint8_t i;
-    for (i = 0u; i < (uint8_t)PULSE_MAX_TASKS; i++)
+    uint8_t n;
+
+    for (n = 0u; n < max_tasks; n++)
     {
-        if ((mask & pulse_task_bit(i)) != 0u)
+        if (pulse_poll_one(k) == 0u)
         {
-            return (int32_t)i;
+            return 0u;
         }
     }
-    return -1;
+    return pulse_poll_pending(k);
 }
 
-void pulse_init(uint32_t tick_ms)
+#if (PULSE_CFG_POLL_BUDGET == 1u)
+uint8_t pulse_kernel_poll_budget(pulse_kernel_t *k, pulse_stamp_t budget)
 {
-    uint8_t i;
+    const pulse_stamp_t start = PULSE_PORT_TIMESTAMP();
 
-    if (tick_ms == 0u)
+    /* Checked before each task, so an overrun is at most one tick() call. */
+    while ((pulse_stamp_t)(PULSE_PORT_TIMESTAMP() - start) < budget)
     {
-        tick_ms = 1u;
+        if (pulse_poll_one(k) == 0u)
+        {
+            return 0u;
+        }
     }
+    return pulse_poll_pending(k);
+}
+#endif
 
+#if (PULSE_CFG_IDLE_SLEEP == 1u)
+void pulse_kernel_idle(pulse_kernel_t *k)
+{
     PULSE_PORT_DISABLE_GLOBAL_IRQ();
 
-    pulse_kernel.task_count = 0u;
-    pulse_kernel.started = 0u;
-    pulse_kernel.tick_ms = tick_ms;
-    pulse_kernel.ready_mask = 0u;
+    if (pulse_ready_any(k) == 0u)
+    {
+#if (PULSE_CFG_TRACE == 1u)
+        pulse_trace_put(k, PULSE_TRACE_IDLE, PULSE_TRACE_NO_TASK, (uint16_t)PULSE_PORT_SUBTICK());
+#endif
+        /* Any release from here on is latched by the interrupt controller
+         * and ends the sleep the port is about to enter.
+         */
+        PULSE_PORT_SLEEP_ENABLE_IRQ();
+#if (PULSE_CFG_TRACE == 1u)
+        PULSE_PORT_ENTER_CRITICAL();
+        pulse_trace_put(k, PULSE_TRACE_WAKE, PULSE_TRACE_NO_TASK, (uint16_t)PULSE_PORT_SUBTICK());
+        PULSE_PORT_EXIT_CRITICAL();
+#endif
+    }
+    else
+    {
+        PULSE_PORT_ENABLE_GLOBAL_IRQ();
+    }
+}
+#endif
 
-    for (i = 0u; i < (uint8_t)PULSE_MAX_TASKS; i++)
+void pulse_kernel_start(pulse_kernel_t *k)
+{
+    if (k->started == 0u)
     {
-        pulse_kernel.tasks[i].running = 0u;
-        pulse_kernel.tasks[i].state = 0;
-        pulse_kernel.tasks[i].period_ticks = 0u;
-        pulse_kernel.tasks[i].elapsed_ticks = 0u;
-        pulse_kernel.tasks[i].tick = (pulse_tick_f)0;
+        k->started = 1u;
+#if (PULSE_CFG_TRACE == 1u)
+        PULSE_PORT_ENTER_CRITICAL();
+        pulse_trace_put(k, PULSE_TRACE_START, PULSE_TRACE_NO_TASK, pulse_trace_tick_len(k->tick_us));
+        PULSE_PORT_EXIT_CRITICAL();
+#endif
+#if (PULSE_CFG_PRIORITY == 1u)
+        pulse_kernel_apply_priorities(k);
+#endif
+#if (PULSE_CFG_AUTO_STAGGER == 1u)
+        pulse_kernel_auto_stagger(k);
+#endif
     }
+}
+
+/* ---------------- Default instance ---------------- */
+
+void pulse_init(uint32_t tick_ms)
+{
+    PULSE_PORT_DISABLE_GLOBAL_IRQ();
+    pulse_kernel_init(&pulse_kernel, tick_ms);
+}
 
+void pulse_init_us(uint32_t tick_us)
+{
     PULSE_PORT_DISABLE_GLOBAL_IRQ();
+    pulse_kernel_init_us(&pulse_kernel, tick_us);
 }
 
+#if (PULSE_CFG_STATIC_TASKS == 0u)
 int32_t pulse_add_task(pulse_state_t init_state,
                        uint32_t period_ticks,
                        pulse_tick_f tick)
 {
-    uint8_t idx;
+    return pulse_kernel_add_task(&pulse_kernel, init_state, period_ticks, tick);
+}
 
-    if (period_ticks == 0u)
-    {
-        return -1;
-    }
+int32_t pulse_add_task_ex(pulse_state_t init_state,
+                          uint32_t period_ticks,
+                          uint32_t offset_ticks,
+                          pulse_tick_f tick)
+{
+    return pulse_kernel_add_task_ex(&pulse_kernel, init_state, period_ticks, offset_ticks, tick);
+}
 
-#if (PULSE_CFG_NULL_TICK_GUARD == 1u)
-    if (tick == (pulse_tick_f)0)
-    {
-        return -2;
-    }
+#if (PULSE_CFG_SPORADIC == 1u)
+int32_t pulse_add_sporadic(pulse_state_t init_state,
+                           uint32_t min_gap_ticks,
+                           pulse_tick_f tick)
+{
+    return pulse_kernel_add_sporadic(&pulse_kernel, init_state, min_gap_ticks, tick);
+}
+
+int32_t pulse_signal_isr(uint8_t id)
+{
+    return pulse_kernel_signal_isr(&pulse_kernel, id);
+}
+#endif
 #endif
 
-    PULSE_PORT_ENTER_CRITICAL();
+#if (PULSE_CFG_AUTO_STAGGER == 1u)
+void pulse_auto_stagger(void)
+{
+    pulse_kernel_auto_stagger(&pulse_kernel);
+}
+#endif
 
-    if (pulse_kernel.task_count >= (uint8_t)PULSE_MAX_TASKS)
-    {
-        PULSE_PORT_EXIT_CRITICAL();
-        return -3;
-    }
+#if (PULSE_CFG_PRIORITY == 1u)
+int32_t pulse_set_priority(uint8_t id, uint8_t priority)
+{
+    return pulse_kernel_set_priority(&pulse_kernel, id, priority);
+}
+
+void pulse_apply_priorities(void)
+{
+    pulse_kernel_apply_priorities(&pulse_kernel);
+}
+#endif
 
-    idx = pulse_kernel.task_count;
+#if (PULSE_CFG_TASK_CONTROL == 1u)
+int32_t pulse_suspend(uint8_t id)
+{
+    return pulse_kernel_suspend(&pulse_kernel, id);
+}
 
-    pulse_kernel.tasks[idx].running = 0u;
-    pulse_kernel.tasks[idx].state = init_state;
-    pulse_kernel.tasks[idx].period_ticks = period_ticks;
+int32_t pulse_resume(uint8_t id)
+{
+    return pulse_kernel_resume(&pulse_kernel, id);
+}
 
-#if (PULSE_CFG_RUN_IMMEDIATELY == 1u)
-    /* allow an immediate release */
-    pulse_kernel.tasks[idx].elapsed_ticks = period_ticks;
-#else
-    pulse_kernel.tasks[idx].elapsed_ticks = 0u;
+#if (PULSE_CFG_STATIC_TASKS == 0u)
+int32_t pulse_set_period(uint8_t id, uint32_t period_ticks)
+{
+    return pulse_kernel_set_period(&pulse_kernel, id, period_ticks);
+}
+#endif
 #endif
 
-    pulse_kernel.tasks[idx].tick = tick;
+#if (PULSE_CFG_MODES == 1u)
+int32_t pulse_set_mode(const pulse_mode_t *mode)
+{
+    return pulse_kernel_set_mode(&pulse_kernel, mode);
+}
 
-#if (PULSE_CFG_RUN_IMMEDIATELY == 1u)
-    /* Mark ready immediately so tests/superloops can run without waiting a tick. */
-    pulse_kernel.ready_mask |= pulse_task_bit(idx);
+const pulse_mode_t *pulse_get_mode(void)
+{
+    return pulse_kernel_get_mode(&pulse_kernel);
+}
 #endif
 
-    pulse_kernel.task_count = (uint8_t)(pulse_kernel.task_count + 1u);
+#if (PULSE_CFG_COROUTINES == 1u)
+int32_t pulse_wait_ticks(uint32_t ticks)
+{
+    return pulse_kernel_wait_ticks(&pulse_kernel, ticks);
+}
+#endif
 
-    PULSE_PORT_EXIT_CRITICAL();
+void pulse_tick_isr(void)
+{
+    pulse_kernel_tick_isr(&pulse_kernel);
+}
 
-    return 0;
+void pulse_poll(void)
+{
+    pulse_kernel_poll(&pulse_kernel);
 }
 
-uint8_t pulse_is_started(void)
+uint8_t pulse_poll_bounded(uint8_t max_tasks)
 {
-    return pulse_kernel.started;
+    return pulse_kernel_poll_bounded(&pulse_kernel, max_tasks);
 }
 
-uint32_t pulse_tick_period_ms(void)
+#if (PULSE_CFG_POLL_BUDGET == 1u)
+uint8_t pulse_poll_budget(pulse_stamp_t budget)
 {
-    return pulse_kernel.tick_ms;
+    return pulse_kernel_poll_budget(&pulse_kernel, budget);
 }
+#endif
 
-void pulse_tick_isr(void)
+#if (PULSE_CFG_IDLE_SLEEP == 1u)
+void pulse_idle(void)
 {
-    uint8_t i;
+    pulse_kernel_idle(&pulse_kernel);
+}
+#endif
 
-    for (i = 0u; i < pulse_kernel.task_count; i++)
-    {
-        pulse_task_t * const t = &pulse_kernel.tasks[i];
+#if (PULSE_CFG_STATS == 1u)
+int32_t pulse_get_task_stats(uint8_t id, pulse_task_stats_t *out)
+{
+    return pulse_kernel_get_task_stats(&pulse_kernel, id, out);
+}
 
-#if (PULSE_CFG_SATURATE_ELAPSED == 1u)
-        if (t->elapsed_ticks < 0xFFFFFFFFu)
-        {
-            t->elapsed_ticks++;
-        }
-#else
-        t->elapsed_ticks++;
+void pulse_reset_task_stats(uint8_t id)
+{
+    pulse_kernel_reset_task_stats(&pulse_kernel, id);
+}
 #endif
 
-        if (t->elapsed_ticks >= t->period_ticks)
-        {
-            if (t->running == 0u)
-            {
-                /* Do not reset elapsed_ticks here; reset when task actually runs.
-                 * This avoids losing releases if polling is delayed.
-                 */
-                PULSE_PORT_ENTER_CRITICAL();
-                pulse_kernel.ready_mask |= pulse_task_bit(i);
-                PULSE_PORT_EXIT_CRITICAL();
-            }
-        }
-    }
+#if (PULSE_CFG_OVERRUN == 1u)
+int32_t pulse_set_overrun_policy(uint8_t id, uint8_t policy, uint8_t catchup_max)
+{
+    return pulse_kernel_set_overrun_policy(&pulse_kernel, id, policy, catchup_max);
 }
 
-void pulse_poll(void)
+uint32_t pulse_get_overruns(uint8_t id)
 {
-    uint64_t mask;
-    int32_t id;
-
-    for (;;)
-    {
-        PULSE_PORT_ENTER_CRITICAL();
-        mask = pulse_kernel.ready_mask;
-        id = pulse_find_lowest_set_bit(mask);
-        if (id >= 0)
-        {
-            pulse_kernel.ready_mask &= ~pulse_task_bit((uint8_t)id);
-            pulse_kernel.tasks[(uint8_t)id].running = 1u;
-            pulse_kernel.tasks[(uint8_t)id].elapsed_ticks = 0u;
-        }
-        PULSE_PORT_EXIT_CRITICAL();
+    return pulse_kernel_get_overruns(&pulse_kernel, id);
+}
+#endif
 
-        if (id < 0)
-        {
-            break;
-        }
+#if (PULSE_CFG_TRACE == 1u)
+uint16_t pulse_trace_read(pulse_trace_rec_t *out, uint16_t max)
+{
+    return pulse_kernel_trace_read(&pulse_kernel, out, max);
+}
+#endif
 
-        {
-            pulse_task_t * const t = &pulse_kernel.tasks[(uint8_t)id];
+uint8_t pulse_is_started(void)
+{
+    return pulse_kernel_is_started(&pulse_kernel);
+}
 
-#if (PULSE_CFG_NULL_TICK_GUARD == 1u)
-            if (t->tick != (pulse_tick_f)0)
-#endif
-            {
-                t->state = t->tick(t->state);
-            }
+uint32_t pulse_tick_period_ms(void)
+{
+    return pulse_kernel_tick_period_ms(&pulse_kernel);
+}
 
-            PULSE_PORT_ENTER_CRITICAL();
-            t->running = 0u;
-            PULSE_PORT_EXIT_CRITICAL();
-        }
-    }
+uint32_t pulse_tick_period_us(void)
+{
+    return pulse_kernel_tick_period_us(&pulse_kernel);
 }
 
 void pulse_start(void)
@@ -336,15 +4465,19 @@ void pulse_start(void)
         }
     }
 
-    pulse_kernel.started = 1u;
+    pulse_kernel_start(&pulse_kernel);
 
-    PULSE_PORT_TIMER_INIT(pulse_kernel.tick_ms);
+    PULSE_PORT_TIMER_INIT_US(pulse_kernel.tick_us);
     PULSE_PORT_ENABLE_GLOBAL_IRQ();
 
     for (;;)
     {
         pulse_poll();
+#if (PULSE_CFG_IDLE_SLEEP == 1u)
+        pulse_idle();
+#else
         PULSE_PORT_IDLE_HOOK();
+#endif
     }
 }
 
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * pulse.hpp: C++17 front end for pulse.h with a compile-time task set.
+ *
+ *   #include "pulse_port_avr.h"
+ *   #define PULSE_IMPLEMENTATION
+ *   #include "pulse.hpp"
+ *
+ *   pulse_state_t imu(pulse_state_t s);
+ *   pulse_state_t beacon(pulse_state_t s);
+ *
+ *   using App = pulse::Kernel<pulse::Task<10, imu>,
+ *                             pulse::Task<100, beacon>>;
+ *   PULSE_HPP_KERNEL(App)
+ *
+ *   int main() { App::init(1u); App::start(); }
+ *
+ * The kernel is the C one built with PULSE_CFG_STATIC_TASKS, so pulse_poll()
+ * behaves exactly as in C. Tick functions are template arguments, and the
+ * generated dispatch calls them directly, so small task bodies inline into
+ * the poll loop. No function pointer or period is stored in RAM.
+ *
+ * PULSE_HPP_KERNEL() defines the pulse_static_*() hooks. Put it in the
+ * translation unit that defines PULSE_IMPLEMENTATION, so the compiler can see
+ * them next to the kernel. Only one Kernel per program is allowed.
+ */
+
+#ifndef PULSE_HPP
+#define PULSE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#ifndef PULSE_CFG_STATIC_TASKS
+#define PULSE_CFG_STATIC_TASKS (1u)
+#endif
+
+#if (PULSE_CFG_STATIC_TASKS != 1u)
+#error "pulse.hpp requires PULSE_CFG_STATIC_TASKS=1"
+#endif
+
+#ifdef PULSE_TASK_TABLE
+#error "pulse.hpp generates the task set; do not define PULSE_TASK_TABLE"
+#endif
+
+#define PULSE_STATIC_TASKS_EXTERN
+
+#include "pulse.h"
+
+namespace pulse
+{
+
+using state_t = pulse_state_t;
+using tick_fn = state_t (*)(state_t);
+
+/* One periodic task: period in ticks, tick function, initial state. */
+template <std::uint32_t Period, tick_fn Fn, state_t Init = 0>
+struct Task
+{
+    static_assert((Period > 0u) && (Period <= PULSE_PERIOD_MAX), "pulse::Task period must be in 1..PULSE_PERIOD_MAX");
+    static_assert(Fn != nullptr, "pulse::Task needs a tick function");
+
+    static constexpr std::uint32_t period = Period;
+    static constexpr tick_fn fn = Fn;
+    static constexpr state_t init = Init;
+
+    /* Fn is a template argument, so this is a direct, inlinable call. */
+    static state_t call(state_t s) { return Fn(s); }
+};
+
+namespace detail
+{
+
+constexpr std::uint64_t gcd(std::uint64_t a, std::uint64_t b)
+{
+    while (b != 0u)
+    {
+        const std::uint64_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+/* 0 if the result does not fit in 64 bits. */
+constexpr std::uint64_t lcm(std::uint64_t a, std::uint64_t b)
+{
+    if (a == 0u)
+    {
+        return 0u;
+    }
+    const std::uint64_t step = b / gcd(a, b);
+    return (step > (UINT64_MAX / a)) ? 0u : (a * step);
+}
+
+} // namespace detail
+
+/* A fixed task set. Ids are the positions in the parameter list, which is
+ * also the dispatch priority (first = highest).
+ */
+template <class... Tasks>
+class Kernel
+{
+public:
+    static constexpr std::uint8_t count = static_cast<std::uint8_t>(sizeof...(Tasks));
+
+    static_assert(sizeof...(Tasks) >= 1u, "pulse::Kernel needs at least one task");
+    static_assert(sizeof...(Tasks) <= PULSE_MAX_TASKS, "pulse::Kernel has more tasks than PULSE_MAX_TASKS");
+
+    /* Least common multiple of all periods, in ticks. */
+    static constexpr std::uint64_t hyperperiod = []() {
+        std::uint64_t h = 1u;
+        ((h = detail::lcm(h, Tasks::period)), ...);
+        return h;
+    }();
+
+    static_assert(hyperperiod != 0u, "pulse::Kernel hyperperiod does not fit in 64 bits");
+
+    /* True if every period divides every longer one. */
+    static constexpr bool harmonic = []() {
+        constexpr std::uint32_t p[] = { Tasks::period... };
+        for (std::size_t i = 0u; i < sizeof...(Tasks); i++)
+        {
+            for (std::size_t j = 0u; j < sizeof...(Tasks); j++)
+            {
+                if ((p[i] <= p[j]) && ((p[j] % p[i]) != 0u))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }();
+
+#ifdef PULSE_HPP_REQUIRE_HARMONIC
+    static_assert(harmonic, "pulse::Kernel periods are not harmonic");
+#endif
+
+    /* Id of the task running Fn. */
+    template <tick_fn Fn>
+    static constexpr std::uint8_t id()
+    {
+        constexpr tick_fn fns[] = { Tasks::fn... };
+        std::uint8_t i = 0u;
+        while ((i < count) && (fns[i] != Fn))
+        {
+            i++;
+        }
+        return i;
+    }
+
+    static std::uint32_t period(std::uint8_t task_id)
+    {
+        return period_of(task_id, std::make_index_sequence<sizeof...(Tasks)>{});
+    }
+
+    static state_t init_state(std::uint8_t task_id)
+    {
+        return init_of(task_id, std::make_index_sequence<sizeof...(Tasks)>{});
+    }
+
+    static state_t dispatch(std::uint8_t task_id, state_t s)
+    {
+        return dispatch_of(task_id, s, std::make_index_sequence<sizeof...(Tasks)>{});
+    }
+
+    static void init(std::uint32_t tick_ms) { pulse_init(tick_ms); }
+    static void init_us(std::uint32_t tick_us) { pulse_init_us(tick_us); }
+    static void start() { pulse_start(); }
+    static void poll() { pulse_poll(); }
+    static void tick_isr() { pulse_tick_isr(); }
+
+private:
+    template <std::size_t... I>
+    static std::uint32_t period_of(std::uint8_t task_id, std::index_sequence<I...>)
+    {
+        std::uint32_t p = 1u;
+        (void)(((task_id == I) && ((p = Tasks::period), true)) || ...);
+        return p;
+    }
+
+    template <std::size_t... I>
+    static state_t init_of(std::uint8_t task_id, std::index_sequence<I...>)
+    {
+        state_t s = 0;
+        (void)(((task_id == I) && ((s = Tasks::init), true)) || ...);
+        return s;
+    }
+
+    /* Folds into a compare-and-call chain with direct calls, which the
+     * compiler turns into a jump table or inlines outright.
+     */
+    template <std::size_t... I>
+    static state_t dispatch_of(std::uint8_t task_id, state_t s, std::index_sequence<I...>)
+    {
+        (void)(((task_id == I) && ((s = Tasks::call(s)), true)) || ...);
+        return s;
+    }
+};
+
+} // namespace pulse
+
+/* Binds the C kernel to a pulse::Kernel. Use once, next to
+ * PULSE_IMPLEMENTATION.
+ */
+#define PULSE_HPP_KERNEL(KernelType)                                              \
+    extern "C" uint8_t pulse_static_count(void) { return KernelType::count; }    \
+    extern "C" pulse_tick_t pulse_static_period(uint8_t id)                      \
+    {                                                                            \
+        return static_cast<pulse_tick_t>(KernelType::period(id));                \
+    }                                                                            \
+    extern "C" pulse_state_t pulse_static_dispatch(uint8_t id, pulse_state_t s)  \
+    {                                                                            \
+        return KernelType::dispatch(id, s);                                      \
+    }                                                                            \
+    extern "C" pulse_state_t pulse_static_init_state(uint8_t id)                 \
+    {                                                                            \
+        return KernelType::init_state(id);                                       \
+    }
+
+#endif /* PULSE_HPP */
@@ -24,36 +24,322 @@
 #define PULSE_PORT_IDLE_HOOK() do { } while (0)
 #endif
 
-static inline void pulse_port_avr_timer_init(uint32_t tick_ms)
+#if defined(PULSE_CFG_IDLE_SLEEP) && (PULSE_CFG_IDLE_SLEEP == 1u)
+#include <avr/sleep.h>
+
+/* Timer1 keeps running only in idle mode on most ATmega parts. */
+#ifndef PULSE_AVR_SLEEP_MODE
+#define PULSE_AVR_SLEEP_MODE SLEEP_MODE_IDLE
+#endif
+
+/* The instruction after `sei` always executes before a pending interrupt is
+ * taken, so `sei; sleep` cannot lose a wake-up.
+ */
+#define PULSE_PORT_SLEEP_ENABLE_IRQ() \
+    do { set_sleep_mode(PULSE_AVR_SLEEP_MODE); sleep_enable(); sei(); sleep_cpu(); sleep_disable(); } while (0)
+#endif
+
+/* If 1, a tick that is not a whole number of timer counts alternates between
+ * the two nearest compare values, so the average period is exact and the
+ * tick does not drift against F_CPU. If 0, the nearest count is used.
+ * Periodic builds only; tickless builds always round.
+ */
+#ifndef PULSE_AVR_DRIFT_CORRECTION
+#define PULSE_AVR_DRIFT_CORRECTION (1u)
+#endif
+
+#if ((PULSE_AVR_DRIFT_CORRECTION != 0u) && (PULSE_AVR_DRIFT_CORRECTION != 1u))
+#error "PULSE_AVR_DRIFT_CORRECTION must be 0 or 1"
+#endif
+
+/* Timer1 clock dividers (CS12:0 = 1..5), as shifts of F_CPU. */
+#define PULSE_AVR_DIVIDERS (5u)
+
+static const uint8_t pulse_port_avr_div_shift[PULSE_AVR_DIVIDERS] = { 0u, 3u, 6u, 8u, 10u };
+
+/* q = a * b / d and r = a * b % d for d < 2^31, without 64-bit arithmetic.
+ * Returns -1 as soon as q exceeds `limit`.
+ */
+static inline int8_t pulse_port_avr_muldiv(uint32_t a, uint32_t b, uint32_t d, uint32_t limit,
+                                           uint32_t *q, uint32_t *r)
 {
-    uint32_t ocr;
-    uint32_t ticks_per_ms;
+    const uint32_t qa = a / d;
+    const uint32_t ra = a % d;
+    uint32_t qq = 0u;
+    uint32_t rr = 0u;
+    uint8_t bit;
+
+    for (bit = 32u; bit > 0u; bit--)
+    {
+        qq <<= 1;
+        rr <<= 1;
+        if (rr >= d)
+        {
+            rr -= d;
+            qq++;
+        }
+        if ((b & ((uint32_t)1u << (bit - 1u))) != 0u)
+        {
+            qq += qa;
+            rr += ra;
+            if (rr >= d)
+            {
+                rr -= d;
+                qq++;
+            }
+        }
+        if (qq > limit)
+        {
+            return -1;
+        }
+    }
+
+    *q = qq;
+    *r = rr;
+    return 0;
+}
+
+/* Picks the smallest divider at which a tick of tick_us is at most `limit`
+ * whole counts, for the finest resolution. Returns the CS12:0 bits, the whole
+ * counts and the remainder rem/den of a count. A tick too long for /1024 is
+ * clamped to `limit` counts, one too short to 2 counts.
+ */
+static inline uint8_t pulse_port_avr_timer_scale(uint32_t tick_us, uint32_t limit, uint32_t *counts,
+                                                 uint32_t *rem, uint32_t *den)
+{
+    uint8_t i;
+
+    for (i = 0u; i < PULSE_AVR_DIVIDERS; i++)
+    {
+        *den = (uint32_t)1000000u << pulse_port_avr_div_shift[i];
+        if (pulse_port_avr_muldiv((uint32_t)F_CPU, tick_us, *den, limit, counts, rem) == 0)
+        {
+            break;
+        }
+    }
+    if (i == PULSE_AVR_DIVIDERS)
+    {
+        i = PULSE_AVR_DIVIDERS - 1u;
+        *counts = limit;
+        *rem = 0u;
+    }
+    if (*counts < 2u)
+    {
+        *counts = 2u;
+        *rem = 0u;
+    }
+
+    return (uint8_t)((uint8_t)(i + 1u) << CS10);
+}
+
+#if defined(PULSE_CFG_TICKLESS) && (PULSE_CFG_TICKLESS == 1u)
+
+/* Tick lengths the port can program, for PULSE_CFG_TICK_US. */
+#define PULSE_PORT_TICK_US_MIN ((2000000ul + (F_CPU) - 1ul) / (F_CPU))
+#define PULSE_PORT_TICK_US_MAX ((0x7FFFull * 1024ull * 1000000ull) / (F_CPU))
+
+/* Tickless: Timer1 free-runs in normal mode and OCR1A is used as a one-shot
+ * compare. pulse_port_avr_ref is TCNT1 at the last whole tick handed to the
+ * kernel, so the sub-tick remainder is never lost.
+ */
+static uint16_t pulse_port_avr_ref;
+static uint16_t pulse_port_avr_counts_per_tick;
+
+static inline void pulse_port_avr_timer_init(uint32_t tick_us)
+{
+    uint32_t counts;
+    uint32_t rem;
+    uint32_t den;
+    uint8_t cs;
 
     TCCR1A = 0u;
     TCCR1B = 0u;
     TCNT1  = 0u;
 
-    ticks_per_ms = (uint32_t)((uint32_t)F_CPU / 64u / 1000u);
-    ocr = (tick_ms * ticks_per_ms);
+    /* Need headroom for at least one pending tick inside the 16-bit counter. */
+    cs = pulse_port_avr_timer_scale(tick_us, 0x7FFFu, &counts, &rem, &den);
+    if ((rem >= (den - rem)) && (counts < 0x7FFFu))
+    {
+        counts++;
+    }
+
+    pulse_port_avr_counts_per_tick = (uint16_t)counts;
+    pulse_port_avr_ref = 0u;
 
-    if (ocr > 0u)
+    OCR1A = pulse_port_avr_counts_per_tick;
+    TIFR1 = (uint8_t)(1u << OCF1A);
+
+    TCCR1B |= cs;
+
+    TIMSK1 |= (uint8_t)(1u << OCIE1A);
+}
+
+static inline uint32_t pulse_port_avr_timer_elapsed(void)
+{
+    const uint16_t delta = (uint16_t)(TCNT1 - pulse_port_avr_ref);
+    const uint16_t n = (uint16_t)(delta / pulse_port_avr_counts_per_tick);
+
+    pulse_port_avr_ref = (uint16_t)(pulse_port_avr_ref + (uint16_t)(n * pulse_port_avr_counts_per_tick));
+
+    return (uint32_t)n;
+}
+
+static inline void pulse_port_avr_timer_set_next(uint32_t ticks)
+{
+    /* Keep one tick of headroom so TCNT1 can never lap pulse_port_avr_ref. */
+    const uint32_t max_ticks = (uint32_t)((0xFFFFu - pulse_port_avr_counts_per_tick) / pulse_port_avr_counts_per_tick);
+    uint16_t target;
+
+    if (ticks > max_ticks)
     {
-        ocr -= 1u;
+        ticks = max_ticks;
     }
+    if (ticks == 0u)
+    {
+        ticks = 1u;
+    }
+
+    target = (uint16_t)(pulse_port_avr_ref + (uint16_t)(ticks * pulse_port_avr_counts_per_tick));
+
+    OCR1A = target;
+    TIFR1 = (uint8_t)(1u << OCF1A);
+
+    /* The counter may have passed the target while it was being programmed. */
+    if ((uint16_t)(TCNT1 - pulse_port_avr_ref) >= (uint16_t)(target - pulse_port_avr_ref))
+    {
+        OCR1A = (uint16_t)(TCNT1 + 2u);
+    }
+}
+
+#if (defined(PULSE_CFG_STATS) && (PULSE_CFG_STATS == 1u)) || (defined(PULSE_CFG_POLL_BUDGET) && (PULSE_CFG_POLL_BUDGET == 1u))
+/* Timer1 free-runs over the full 16 bits, so TCNT1 itself is the timestamp. */
+#define PULSE_PORT_STAMP_T     uint16_t
+#define PULSE_PORT_TIMESTAMP() (TCNT1)
+#endif
+
+/* Sub-tick position for traces: counts since the last whole tick. */
+#define PULSE_PORT_SUBTICK() ((uint16_t)(TCNT1 - pulse_port_avr_ref))
+
+#define PULSE_PORT_TIMER_ELAPSED()        pulse_port_avr_timer_elapsed()
+#define PULSE_PORT_TIMER_SET_NEXT(ticks)  do { pulse_port_avr_timer_set_next((ticks)); } while (0)
+
+#else
+
+/* Tick lengths the port can program, for PULSE_CFG_TICK_US. */
+#define PULSE_PORT_TICK_US_MIN ((2000000ul + (F_CPU) - 1ul) / (F_CPU))
+#define PULSE_PORT_TICK_US_MAX ((0xFFFFull * 1024ull * 1000000ull) / (F_CPU))
+
+#if (PULSE_AVR_DRIFT_CORRECTION == 1u)
+/* Bresenham over the remainder: each tick adds rem/den of a count, and a tick
+ * that carries runs one count longer. Reloaded in the compare ISR while
+ * TCNT1 is still near 0, so it applies to the tick just started.
+ */
+static uint16_t pulse_port_avr_ocr;
+static uint32_t pulse_port_avr_rem;
+static uint32_t pulse_port_avr_den;
+static uint32_t pulse_port_avr_acc;
+
+static inline void pulse_port_avr_trim(void)
+{
+    pulse_port_avr_acc += pulse_port_avr_rem;
+    if (pulse_port_avr_acc >= pulse_port_avr_den)
+    {
+        pulse_port_avr_acc -= pulse_port_avr_den;
+        OCR1A = (uint16_t)(pulse_port_avr_ocr + 1u);
+    }
+    else
+    {
+        OCR1A = pulse_port_avr_ocr;
+    }
+}
+
+#define PULSE_PORT_AVR_TRIM() do { pulse_port_avr_trim(); } while (0)
+#endif
+
+static inline void pulse_port_avr_timer_init(uint32_t tick_us)
+{
+    uint32_t counts;
+    uint32_t rem;
+    uint32_t den;
+    uint8_t cs;
+
+    TCCR1A = 0u;
+    TCCR1B = 0u;
+    TCNT1  = 0u;
+
+    /* At most 0xFFFF whole counts, so a carried tick still fits OCR1A. */
+    cs = pulse_port_avr_timer_scale(tick_us, 0xFFFFu, &counts, &rem, &den);
+#if (PULSE_AVR_DRIFT_CORRECTION == 1u)
+    pulse_port_avr_ocr = (uint16_t)(counts - 1u);
+    pulse_port_avr_rem = rem;
+    pulse_port_avr_den = den;
+    pulse_port_avr_acc = 0u;
+#else
+    if (rem >= (den - rem))
+    {
+        counts++;
+    }
+#endif
 
     TCCR1B |= (uint8_t)(1u << WGM12);
-    TCCR1B |= (uint8_t)((1u << CS11) | (1u << CS10));
+    TCCR1B |= cs;
 
-    OCR1A = (uint16_t)ocr;
+    OCR1A = (uint16_t)(counts - 1u);
 
     TIMSK1 |= (uint8_t)(1u << OCIE1A);
 }
 
-#define PULSE_PORT_TIMER_INIT(tick_ms) do { pulse_port_avr_timer_init((tick_ms)); } while (0)
+#if (defined(PULSE_CFG_STATS) && (PULSE_CFG_STATS == 1u)) || (defined(PULSE_CFG_POLL_BUDGET) && (PULSE_CFG_POLL_BUDGET == 1u))
+/* In CTC mode TCNT1 restarts every tick, so the timestamp is extended by the
+ * compare ISR, which adds each finished tick's OCR1A + 1 counts to a base.
+ */
+static volatile uint32_t pulse_port_avr_stamp_base;
+
+#define PULSE_PORT_AVR_COUNT_TICK() do { pulse_port_avr_stamp_base += (uint32_t)OCR1A + 1u; } while (0)
+
+static inline uint32_t pulse_port_avr_timestamp(void)
+{
+    const uint8_t sreg = SREG;
+    uint32_t base;
+    uint16_t cnt;
+
+    cli();
+    cnt = TCNT1;
+    base = pulse_port_avr_stamp_base;
+
+    /* Compare matched but its ISR has not run yet: count that tick here. */
+    if ((TIFR1 & (uint8_t)(1u << OCF1A)) != 0u)
+    {
+        cnt = TCNT1;
+        base += (uint32_t)OCR1A + 1u;
+    }
+    SREG = sreg;
+
+    return base + (uint32_t)cnt;
+}
+
+#define PULSE_PORT_TIMESTAMP() pulse_port_avr_timestamp()
+#endif
+
+/* Sub-tick position for traces: TCNT1 restarts every tick (OCR1A + 1 counts). */
+#define PULSE_PORT_SUBTICK() ((uint16_t)TCNT1)
+
+#endif /* PULSE_CFG_TICKLESS */
+
+#define PULSE_PORT_TIMER_INIT_US(tick_us) do { pulse_port_avr_timer_init((tick_us)); } while (0)
+
+#ifndef PULSE_PORT_AVR_COUNT_TICK
+#define PULSE_PORT_AVR_COUNT_TICK() do { } while (0)
+#endif
+#ifndef PULSE_PORT_AVR_TRIM
+#define PULSE_PORT_AVR_TRIM() do { } while (0)
+#endif
 
 ISR(TIMER1_COMPA_vect)
 {
     extern void pulse_tick_isr(void);
+    PULSE_PORT_AVR_COUNT_TICK();
+    PULSE_PORT_AVR_TRIM();
     pulse_tick_isr();
 }
 
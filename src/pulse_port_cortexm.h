@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * pulse_port_cortexm.h - ARM Cortex-M port for pulse.h (GCC/Clang)
+ *
+ * Uses only architecture-defined resources (SysTick, SCB, BASEPRI), so it
+ * works with any vendor device header or none at all.
+ */
+
+#ifndef PULSE_PORT_CORTEXM_H
+#define PULSE_PORT_CORTEXM_H
+
+#include <stdint.h>
+
+#ifndef PULSE_CORTEXM_CPU_HZ
+#error "Define PULSE_CORTEXM_CPU_HZ (SysTick clock in Hz, normally the core clock)"
+#endif
+
+/* Optional: frequency of SysTick's implementation-defined reference clock
+ * (CLKSOURCE = 0), e.g. HCLK/8 on STM32. When defined, a tick too long for
+ * 2^24 core clocks runs from the reference clock instead.
+ */
+
+/* If 1, a tick that is not a whole number of SysTick counts alternates
+ * between the two nearest reload values, so the average period is exact and
+ * the tick does not drift against the clock. If 0, the nearest count is used.
+ */
+#ifndef PULSE_CORTEXM_DRIFT_CORRECTION
+#define PULSE_CORTEXM_DRIFT_CORRECTION (1u)
+#endif
+
+#if ((PULSE_CORTEXM_DRIFT_CORRECTION != 0u) && (PULSE_CORTEXM_DRIFT_CORRECTION != 1u))
+#error "PULSE_CORTEXM_DRIFT_CORRECTION must be 0 or 1"
+#endif
+
+#if defined(PULSE_CFG_TICKLESS) && (PULSE_CFG_TICKLESS == 1u)
+#error "pulse_port_cortexm.h: SysTick cannot keep time across a one-shot reload; use a vendor RTC/LPTIM port for tickless builds"
+#endif
+
+/* Implemented priority bits of the NVIC (__NVIC_PRIO_BITS in CMSIS):
+ * 4 on most STM32, 3 on nRF52.
+ */
+#ifndef PULSE_CORTEXM_PRIO_BITS
+#define PULSE_CORTEXM_PRIO_BITS (4u)
+#endif
+
+/* Highest (numerically lowest) logical priority masked by the scheduler's
+ * critical sections. Interrupts more urgent than this are never delayed by
+ * Pulse, but must not call into the kernel. SysTick runs at the lowest
+ * priority, which is always at or below this level.
+ */
+#ifndef PULSE_CORTEXM_KERNEL_PRIO
+#define PULSE_CORTEXM_KERNEL_PRIO (5u)
+#endif
+
+#if (PULSE_CORTEXM_KERNEL_PRIO == 0u) || (PULSE_CORTEXM_KERNEL_PRIO >= (1u << PULSE_CORTEXM_PRIO_BITS))
+#error "PULSE_CORTEXM_KERNEL_PRIO must be in 1 .. (2^PULSE_CORTEXM_PRIO_BITS - 1)"
+#endif
+
+#define PULSE_CORTEXM_BASEPRI ((uint32_t)PULSE_CORTEXM_KERNEL_PRIO << (8u - PULSE_CORTEXM_PRIO_BITS))
+
+/* System control space registers (ARMv6-M / ARMv7-M ARM, B3.2 and B3.3). */
+#define PULSE_CORTEXM_SYST_CSR   (*(volatile uint32_t *)0xE000E010u)
+#define PULSE_CORTEXM_SYST_RVR   (*(volatile uint32_t *)0xE000E014u)
+#define PULSE_CORTEXM_SYST_CVR   (*(volatile uint32_t *)0xE000E018u)
+#define PULSE_CORTEXM_SCB_SHPR3  (*(volatile uint32_t *)0xE000ED20u)
+#define PULSE_CORTEXM_SCB_ICSR   (*(volatile uint32_t *)0xE000ED04u)
+#define PULSE_CORTEXM_DEMCR      (*(volatile uint32_t *)0xE000EDFCu)
+#define PULSE_CORTEXM_DWT_CTRL   (*(volatile uint32_t *)0xE0001000u)
+#define PULSE_CORTEXM_DWT_CYCCNT (*(volatile uint32_t *)0xE0001004u)
+
+#define PULSE_CORTEXM_ICSR_PENDSTSET     (1u << 26)
+#define PULSE_CORTEXM_DEMCR_TRCENA       (1u << 24)
+#define PULSE_CORTEXM_DWT_CTRL_CYCCNTENA (1u << 0)
+
+#define PULSE_CORTEXM_SYST_CSR_ENABLE    (1u << 0)
+#define PULSE_CORTEXM_SYST_CSR_TICKINT   (1u << 1)
+#define PULSE_CORTEXM_SYST_CSR_CLKSOURCE (1u << 2)
+#define PULSE_CORTEXM_SYST_RVR_MAX       (0x00FFFFFFu)
+
+/* Tick lengths the port can program, for PULSE_CFG_TICK_US. */
+#define PULSE_PORT_TICK_US_MIN ((2000000ull + (PULSE_CORTEXM_CPU_HZ) - 1ull) / (PULSE_CORTEXM_CPU_HZ))
+#if defined(PULSE_CORTEXM_REF_HZ)
+#define PULSE_PORT_TICK_US_MAX ((0x00FFFFFFull * 1000000ull) / (PULSE_CORTEXM_REF_HZ))
+#else
+#define PULSE_PORT_TICK_US_MAX ((0x00FFFFFFull * 1000000ull) / (PULSE_CORTEXM_CPU_HZ))
+#endif
+
+/* Word-sized loads and stores are single-copy atomic (pulse_ring.h indices). */
+#ifndef PULSE_PORT_WORD_T
+#define PULSE_PORT_WORD_T uint32_t
+#endif
+
+/* Also orders accesses against the other core of dual-core parts (RP2040,
+ * nRF5340), which cross-kernel signals rely on.
+ */
+#ifndef PULSE_PORT_MEMORY_BARRIER
+#define PULSE_PORT_MEMORY_BARRIER() do { __asm volatile ("dmb" ::: "memory"); } while (0)
+#endif
+
+#define PULSE_PORT_DISABLE_GLOBAL_IRQ() do { __asm volatile ("cpsid i" ::: "memory"); } while (0)
+#define PULSE_PORT_ENABLE_GLOBAL_IRQ()  do { __asm volatile ("cpsie i" ::: "memory"); } while (0)
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+
+/* BASEPRI_MAX only ever raises the mask, so entering from an ISR that already
+ * runs above the kernel level cannot lower it. Kernel critical sections do not
+ * nest, so leaving simply drops the mask back to 0.
+ */
+#define PULSE_PORT_ENTER_CRITICAL() \
+    do { __asm volatile ("msr basepri_max, %0\n\tisb" :: "r" (PULSE_CORTEXM_BASEPRI) : "memory"); } while (0)
+#define PULSE_PORT_EXIT_CRITICAL() \
+    do { __asm volatile ("msr basepri, %0" :: "r" (0u) : "memory"); } while (0)
+
+static inline uint32_t pulse_port_cortexm_ctz32(uint32_t x)
+{
+    uint32_t r;
+
+    __asm ("rbit %0, %1\n\tclz %0, %0" : "=r" (r) : "r" (x));
+    return r;
+}
+
+static inline uint32_t pulse_port_cortexm_ctz64(uint64_t x)
+{
+    const uint32_t lo = (uint32_t)x;
+
+    if (lo != 0u)
+    {
+        return pulse_port_cortexm_ctz32(lo);
+    }
+    return 32u + pulse_port_cortexm_ctz32((uint32_t)(x >> 32u));
+}
+
+/* The width test folds at compile time; 8/16/32-bit masks never touch the
+ * 64-bit path.
+ */
+#ifndef PULSE_PORT_CTZ
+#define PULSE_PORT_CTZ(x) \
+    ((sizeof(x) > 4u) ? pulse_port_cortexm_ctz64((uint64_t)(x)) : pulse_port_cortexm_ctz32((uint32_t)(x)))
+#endif
+
+/* Exclusive-access read-modify-write for PULSE_CFG_LOCK_FREE. Exception entry
+ * clears the local monitor, so a STREX interrupted by the tick fails and the
+ * loop retries with the ISR's bits included.
+ */
+static inline uint32_t pulse_port_cortexm_fetch_or(volatile uint32_t *p, uint32_t v)
+{
+    uint32_t old;
+    uint32_t tmp;
+    uint32_t fail;
+
+    __asm volatile ("1:\n\tldrex %0, [%3]\n\torr %1, %0, %4\n\tstrex %2, %1, [%3]\n\tcmp %2, #0\n\tbne 1b"
+                    : "=&r" (old), "=&r" (tmp), "=&r" (fail) : "r" (p), "r" (v) : "cc", "memory");
+    return old;
+}
+
+static inline uint32_t pulse_port_cortexm_fetch_and(volatile uint32_t *p, uint32_t v)
+{
+    uint32_t old;
+    uint32_t tmp;
+    uint32_t fail;
+
+    __asm volatile ("1:\n\tldrex %0, [%3]\n\tand %1, %0, %4\n\tstrex %2, %1, [%3]\n\tcmp %2, #0\n\tbne 1b"
+                    : "=&r" (old), "=&r" (tmp), "=&r" (fail) : "r" (p), "r" (v) : "cc", "memory");
+    return old;
+}
+
+#define PULSE_PORT_ATOMIC_T                 volatile uint32_t
+#define PULSE_PORT_ATOMIC_BITS              (32u)
+#define PULSE_PORT_ATOMIC_LOAD(p)           (*(p))
+#define PULSE_PORT_ATOMIC_STORE(p, v)       (*(p) = (uint32_t)(v))
+#define PULSE_PORT_ATOMIC_FETCH_OR(p, v)    pulse_port_cortexm_fetch_or((p), (uint32_t)(v))
+#define PULSE_PORT_ATOMIC_FETCH_AND(p, v)   pulse_port_cortexm_fetch_and((p), (uint32_t)(v))
+
+#else
+
+/* ARMv6-M (Cortex-M0/M0+) has neither BASEPRI nor RBIT/CLZ: mask everything
+ * with PRIMASK and let the kernel use its portable bit scan. Without
+ * LDREX/STREX there are no atomic hooks, so PULSE_CFG_LOCK_FREE is not
+ * available.
+ */
+#define PULSE_PORT_ENTER_CRITICAL()     do { __asm volatile ("cpsid i" ::: "memory"); } while (0)
+#define PULSE_PORT_EXIT_CRITICAL()      do { __asm volatile ("cpsie i" ::: "memory"); } while (0)
+
+#endif /* ARMv7-M */
+
+/* Sleep until the next interrupt. A release published between pulse_poll()
+ * returning and the WFI is picked up after the following tick at the latest;
+ * PULSE_CFG_IDLE_SLEEP closes that window.
+ */
+#ifndef PULSE_PORT_IDLE_HOOK
+#define PULSE_PORT_IDLE_HOOK() do { __asm volatile ("dsb\n\twfi" ::: "memory"); } while (0)
+#endif
+
+/* Entered with PRIMASK set: WFI still wakes on a pending interrupt, which is
+ * then taken as soon as `cpsie i` clears PRIMASK.
+ */
+#define PULSE_PORT_SLEEP_ENABLE_IRQ() do { __asm volatile ("dsb\n\twfi\n\tcpsie i" ::: "memory"); } while (0)
+
+#if (defined(PULSE_CFG_STATS) && (PULSE_CFG_STATS == 1u)) || (defined(PULSE_CFG_POLL_BUDGET) && (PULSE_CFG_POLL_BUDGET == 1u))
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+/* DWT cycle counter: core clock cycles, wraps every 2^32 cycles. */
+#define PULSE_PORT_CORTEXM_STAMP_INIT() \
+    do { PULSE_CORTEXM_DEMCR |= PULSE_CORTEXM_DEMCR_TRCENA; \
+         PULSE_CORTEXM_DWT_CYCCNT = 0u; \
+         PULSE_CORTEXM_DWT_CTRL |= PULSE_CORTEXM_DWT_CTRL_CYCCNTENA; } while (0)
+#define PULSE_PORT_CORTEXM_COUNT_TICK() do { } while (0)
+#define PULSE_PORT_TIMESTAMP()          (PULSE_CORTEXM_DWT_CYCCNT)
+#else
+/* No cycle counter on ARMv6-M: extend SysTick by a base that SysTick_Handler
+ * advances by each finished tick's reload + 1. A new RVR value only takes
+ * effect at the next wrap, so the reload of the running tick is tracked
+ * separately.
+ */
+static volatile uint32_t pulse_port_cortexm_stamp_base;
+static volatile uint32_t pulse_port_cortexm_stamp_reload;
+
+#define PULSE_PORT_CORTEXM_STAMP_INIT() \
+    do { pulse_port_cortexm_stamp_base = 0u; pulse_port_cortexm_stamp_reload = PULSE_CORTEXM_SYST_RVR; } while (0)
+#define PULSE_PORT_CORTEXM_COUNT_TICK() \
+    do { pulse_port_cortexm_stamp_base += pulse_port_cortexm_stamp_reload + 1u; \
+         pulse_port_cortexm_stamp_reload = PULSE_CORTEXM_SYST_RVR; } while (0)
+
+static inline uint32_t pulse_port_cortexm_timestamp(void)
+{
+    uint32_t primask;
+    uint32_t base;
+    uint32_t reload;
+    uint32_t cvr;
+
+    __asm volatile ("mrs %0, primask\n\tcpsid i" : "=r" (primask) :: "memory");
+    cvr = PULSE_CORTEXM_SYST_CVR;
+    base = pulse_port_cortexm_stamp_base;
+    reload = pulse_port_cortexm_stamp_reload;
+
+    /* Wrapped but SysTick_Handler has not run yet: count that tick here. The
+     * new tick was loaded from RVR, which the handler has not changed yet.
+     */
+    if ((PULSE_CORTEXM_SCB_ICSR & PULSE_CORTEXM_ICSR_PENDSTSET) != 0u)
+    {
+        cvr = PULSE_CORTEXM_SYST_CVR;
+        base += reload + 1u;
+        reload = PULSE_CORTEXM_SYST_RVR;
+    }
+    __asm volatile ("msr primask, %0" :: "r" (primask) : "memory");
+
+    return base + (reload - cvr);
+}
+
+#define PULSE_PORT_TIMESTAMP() pulse_port_cortexm_timestamp()
+#endif
+#else
+#define PULSE_PORT_CORTEXM_STAMP_INIT() do { } while (0)
+#define PULSE_PORT_CORTEXM_COUNT_TICK() do { } while (0)
+#endif /* PULSE_CFG_STATS */
+
+#if (PULSE_CORTEXM_DRIFT_CORRECTION == 1u)
+/* Bresenham over the remainder: each tick adds rem/10^6 of a count, and a
+ * tick that carries runs one count longer. SysTick_Handler writes the reload
+ * for the tick after the running one.
+ */
+static uint32_t pulse_port_cortexm_reload;
+static uint32_t pulse_port_cortexm_rem;
+static uint32_t pulse_port_cortexm_acc;
+
+static inline void pulse_port_cortexm_trim(void)
+{
+    pulse_port_cortexm_acc += pulse_port_cortexm_rem;
+    if (pulse_port_cortexm_acc >= 1000000u)
+    {
+        pulse_port_cortexm_acc -= 1000000u;
+        PULSE_CORTEXM_SYST_RVR = pulse_port_cortexm_reload + 1u;
+    }
+    else
+    {
+        PULSE_CORTEXM_SYST_RVR = pulse_port_cortexm_reload;
+    }
+}
+
+#define PULSE_PORT_CORTEXM_TRIM() do { pulse_port_cortexm_trim(); } while (0)
+#else
+#define PULSE_PORT_CORTEXM_TRIM() do { } while (0)
+#endif
+
+/* Whole SysTick counts in a tick of tick_us at hz, and the remainder in
+ * millionths of a count.
+ */
+static inline uint64_t pulse_port_cortexm_counts(uint32_t hz, uint32_t tick_us, uint32_t *rem)
+{
+    const uint64_t clocks = (uint64_t)hz * tick_us;
+
+    *rem = (uint32_t)(clocks % 1000000u);
+    return clocks / 1000000u;
+}
+
+static inline void pulse_port_cortexm_timer_init(uint32_t tick_us)
+{
+    uint32_t csr = PULSE_CORTEXM_SYST_CSR_CLKSOURCE;
+    uint32_t rem;
+    uint64_t counts = pulse_port_cortexm_counts((uint32_t)PULSE_CORTEXM_CPU_HZ, tick_us, &rem);
+
+    /* 24-bit reload, one count short of the limit so a carried tick fits. */
+#if defined(PULSE_CORTEXM_REF_HZ)
+    if (counts > PULSE_CORTEXM_SYST_RVR_MAX)
+    {
+        csr = 0u;
+        counts = pulse_port_cortexm_counts((uint32_t)PULSE_CORTEXM_REF_HZ, tick_us, &rem);
+    }
+#endif
+    if (counts > PULSE_CORTEXM_SYST_RVR_MAX)
+    {
+        counts = PULSE_CORTEXM_SYST_RVR_MAX;
+        rem = 0u;
+    }
+    if (counts < 2u)
+    {
+        counts = 2u;
+        rem = 0u;
+    }
+#if (PULSE_CORTEXM_DRIFT_CORRECTION == 1u)
+    pulse_port_cortexm_reload = (uint32_t)counts - 1u;
+    pulse_port_cortexm_rem = rem;
+    pulse_port_cortexm_acc = 0u;
+#else
+    if (rem >= 500000u)
+    {
+        counts++;
+    }
+#endif
+
+    PULSE_CORTEXM_SYST_CSR = 0u;
+    PULSE_CORTEXM_SYST_RVR = (uint32_t)counts - 1u;
+    PULSE_CORTEXM_SYST_CVR = 0u;
+
+    PULSE_PORT_CORTEXM_STAMP_INIT();
+
+    /* SysTick is system handler 15: priority byte 3 of SHPR3, set lowest. */
+    PULSE_CORTEXM_SCB_SHPR3 |= 0xFF000000u;
+
+    PULSE_CORTEXM_SYST_CSR = csr |
+                             PULSE_CORTEXM_SYST_CSR_TICKINT |
+                             PULSE_CORTEXM_SYST_CSR_ENABLE;
+}
+
+#define PULSE_PORT_TIMER_INIT_US(tick_us) do { pulse_port_cortexm_timer_init((tick_us)); } while (0)
+
+/* Sub-tick position for traces: SysTick counts down from RVR, so RVR - CVR
+ * counts up from the start of the tick. A tick of more than 65536 SysTick
+ * counts needs PULSE_CORTEXM_SUBTICK_SHIFT to fit; the decoder then takes
+ * (RVR + 1) >> shift counts per tick.
+ */
+#ifndef PULSE_CORTEXM_SUBTICK_SHIFT
+#define PULSE_CORTEXM_SUBTICK_SHIFT (0u)
+#endif
+#define PULSE_PORT_SUBTICK() \
+    ((uint16_t)((PULSE_CORTEXM_SYST_RVR - PULSE_CORTEXM_SYST_CVR) >> PULSE_CORTEXM_SUBTICK_SHIFT))
+
+/* CMSIS vector table name. Define PULSE_CORTEXM_NO_SYSTICK_HANDLER to provide
+ * your own; it must call PULSE_PORT_CORTEXM_COUNT_TICK(),
+ * PULSE_PORT_CORTEXM_TRIM() and then pulse_tick_isr().
+ */
+#ifndef PULSE_CORTEXM_NO_SYSTICK_HANDLER
+void SysTick_Handler(void);
+
+void SysTick_Handler(void)
+{
+    extern void pulse_tick_isr(void);
+    PULSE_PORT_CORTEXM_COUNT_TICK();
+    PULSE_PORT_CORTEXM_TRIM();
+    pulse_tick_isr();
+}
+#endif
+
+#endif /* PULSE_PORT_CORTEXM_H */
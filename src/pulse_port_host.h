@@ -12,13 +12,77 @@
 #define PULSE_PORT_DISABLE_GLOBAL_IRQ() do { } while (0)
 #define PULSE_PORT_ENABLE_GLOBAL_IRQ()  do { } while (0)
 
+/* Define PULSE_PORT_HOST_COUNT_CRITICAL to count the critical sections the
+ * kernel enters, for tests that check how often interrupts would be masked.
+ */
+#if defined(PULSE_PORT_HOST_COUNT_CRITICAL)
+static uint32_t pulse_port_host_critical_count;
+#define PULSE_PORT_ENTER_CRITICAL()     do { pulse_port_host_critical_count++; } while (0)
+#else
 #define PULSE_PORT_ENTER_CRITICAL()     do { } while (0)
+#endif
 #define PULSE_PORT_EXIT_CRITICAL()      do { } while (0)
 
-#define PULSE_PORT_TIMER_INIT(tick_ms)  do { (void)(tick_ms); } while (0)
+#define PULSE_PORT_TIMER_INIT_US(tick_us) do { (void)(tick_us); } while (0)
+
+/* GCC/Clang lower this to a single instruction on most hosts. Define
+ * PULSE_PORT_HOST_NO_CTZ to exercise the kernel's portable fallback instead.
+ */
+#if defined(__GNUC__) && !defined(PULSE_PORT_CTZ) && !defined(PULSE_PORT_HOST_NO_CTZ)
+#define PULSE_PORT_CTZ(x) ((uint8_t)__builtin_ctzll((unsigned long long)(x)))
+#endif
+
+#if defined(PULSE_CFG_LOCK_FREE) && (PULSE_CFG_LOCK_FREE == 1u)
+/* C11 atomics; lock-free builds of the tests are C only. */
+#include <stdatomic.h>
+
+#define PULSE_PORT_ATOMIC_T                 atomic_uint_least32_t
+#define PULSE_PORT_ATOMIC_BITS              (32u)
+#define PULSE_PORT_ATOMIC_LOAD(p)           ((uint32_t)atomic_load(p))
+#define PULSE_PORT_ATOMIC_STORE(p, v)       atomic_store((p), (uint32_t)(v))
+#define PULSE_PORT_ATOMIC_FETCH_OR(p, v)    ((uint32_t)atomic_fetch_or((p), (uint32_t)(v)))
+#define PULSE_PORT_ATOMIC_FETCH_AND(p, v)   ((uint32_t)atomic_fetch_and((p), (uint32_t)(v)))
+#endif /* PULSE_CFG_LOCK_FREE */
+
+#if defined(PULSE_CFG_TICKLESS) && (PULSE_CFG_TICKLESS == 1u)
+/* Simulated free-running counter for tickless builds. Tests advance
+ * pulse_port_host_ticks and read back the interval the kernel requested.
+ */
+static uint32_t pulse_port_host_ticks;
+static uint32_t pulse_port_host_ref;
+static uint32_t pulse_port_host_next;
+
+static inline uint32_t pulse_port_host_timer_elapsed(void)
+{
+    const uint32_t n = pulse_port_host_ticks - pulse_port_host_ref;
+    pulse_port_host_ref = pulse_port_host_ticks;
+    return n;
+}
+
+#define PULSE_PORT_TIMER_ELAPSED()        pulse_port_host_timer_elapsed()
+#define PULSE_PORT_TIMER_SET_NEXT(ticks)  do { pulse_port_host_next = (ticks); } while (0)
+#endif /* PULSE_CFG_TICKLESS */
 
 #ifndef PULSE_PORT_IDLE_HOOK
 #define PULSE_PORT_IDLE_HOOK()          do { } while (0)
 #endif
 
+#if (defined(PULSE_CFG_STATS) && (PULSE_CFG_STATS == 1u)) || (defined(PULSE_CFG_POLL_BUDGET) && (PULSE_CFG_POLL_BUDGET == 1u))
+/* Simulated timestamp counter; tests advance it to model execution time. */
+static uint32_t pulse_port_host_stamp;
+#define PULSE_PORT_TIMESTAMP()          (pulse_port_host_stamp)
+#endif
+
+#if defined(PULSE_CFG_TRACE) && (PULSE_CFG_TRACE == 1u)
+/* Simulated position inside the current tick; tests set it directly. */
+static uint16_t pulse_port_host_subtick;
+#define PULSE_PORT_SUBTICK()            (pulse_port_host_subtick)
+#endif
+
+#if defined(PULSE_CFG_IDLE_SLEEP) && (PULSE_CFG_IDLE_SLEEP == 1u)
+/* Counts the times the kernel decided to sleep. */
+static uint32_t pulse_port_host_sleeps;
+#define PULSE_PORT_SLEEP_ENABLE_IRQ()   do { pulse_port_host_sleeps++; } while (0)
+#endif
+
 #endif /* PULSE_PORT_HOST_H */
@@ -14,6 +14,11 @@
 #error "Define PULSE_MSP430_TICK_HZ (e.g., 32768 for ACLK, 1000000 for 1MHz SMCLK)"
 #endif
 
+/* 16-bit loads and stores are single instructions (pulse_ring.h indices). */
+#ifndef PULSE_PORT_WORD_T
+#define PULSE_PORT_WORD_T uint16_t
+#endif
+
 #define PULSE_PORT_DISABLE_GLOBAL_IRQ() do { __disable_interrupt(); } while (0)
 #define PULSE_PORT_ENABLE_GLOBAL_IRQ()  do { __enable_interrupt(); } while (0)
 
@@ -28,42 +33,331 @@
 #define PULSE_MSP430_TIMER_SRC TASSEL__ACLK
 #endif
 
-static inline void pulse_port_msp430_timer_init(uint32_t tick_ms)
+#if defined(PULSE_CFG_IDLE_SLEEP) && (PULSE_CFG_IDLE_SLEEP == 1u)
+/* LPM3 keeps ACLK, the default timer source, running. Use LPM0_bits when TA0
+ * runs from SMCLK.
+ */
+#ifndef PULSE_MSP430_LPM_BITS
+#define PULSE_MSP430_LPM_BITS LPM3_bits
+#endif
+
+/* Setting GIE and the LPM bits in one SR write makes the sleep atomic; the
+ * timer ISR clears the LPM bits on exit so the main loop resumes.
+ */
+#define PULSE_PORT_SLEEP_ENABLE_IRQ() do { __bis_SR_register(PULSE_MSP430_LPM_BITS | GIE); } while (0)
+#define PULSE_MSP430_WAKE_ON_EXIT()   do { __bic_SR_register_on_exit(PULSE_MSP430_LPM_BITS); } while (0)
+#else
+#define PULSE_MSP430_WAKE_ON_EXIT()   do { } while (0)
+#endif
+
+/* If 1, a tick that is not a whole number of timer counts alternates between
+ * the two nearest CCR0 values, so the average period is exact and the tick
+ * does not drift against the timer clock. If 0, the nearest count is used.
+ * Periodic builds only; tickless builds always round.
+ */
+#ifndef PULSE_MSP430_DRIFT_CORRECTION
+#define PULSE_MSP430_DRIFT_CORRECTION (1u)
+#endif
+
+#if ((PULSE_MSP430_DRIFT_CORRECTION != 0u) && (PULSE_MSP430_DRIFT_CORRECTION != 1u))
+#error "PULSE_MSP430_DRIFT_CORRECTION must be 0 or 1"
+#endif
+
+/* TA0 input dividers (ID = /1, /2, /4, /8). */
+#define PULSE_MSP430_DIVIDERS (4u)
+
+static const uint16_t pulse_port_msp430_div_bits[PULSE_MSP430_DIVIDERS] = { ID_0, ID_1, ID_2, ID_3 };
+
+/* q = a * b / d and r = a * b % d for d < 2^31, without 64-bit arithmetic.
+ * Returns -1 as soon as q exceeds `limit`.
+ */
+static inline int16_t pulse_port_msp430_muldiv(uint32_t a, uint32_t b, uint32_t d, uint32_t limit,
+                                               uint32_t *q, uint32_t *r)
+{
+    const uint32_t qa = a / d;
+    const uint32_t ra = a % d;
+    uint32_t qq = 0u;
+    uint32_t rr = 0u;
+    uint16_t bit;
+
+    for (bit = 32u; bit > 0u; bit--)
+    {
+        qq <<= 1;
+        rr <<= 1;
+        if (rr >= d)
+        {
+            rr -= d;
+            qq++;
+        }
+        if ((b & ((uint32_t)1u << (bit - 1u))) != 0u)
+        {
+            qq += qa;
+            rr += ra;
+            if (rr >= d)
+            {
+                rr -= d;
+                qq++;
+            }
+        }
+        if (qq > limit)
+        {
+            return -1;
+        }
+    }
+
+    *q = qq;
+    *r = rr;
+    return 0;
+}
+
+/* Picks the smallest divider at which a tick of tick_us is at most `limit`
+ * whole counts, for the finest resolution. Returns the ID bits, the whole
+ * counts and the remainder rem/den of a count. A tick too long for /8 is
+ * clamped to `limit` counts, one too short to 2 counts.
+ */
+static inline uint16_t pulse_port_msp430_timer_scale(uint32_t tick_us, uint32_t limit, uint32_t *counts,
+                                                     uint32_t *rem, uint32_t *den)
+{
+    uint16_t i;
+
+    for (i = 0u; i < PULSE_MSP430_DIVIDERS; i++)
+    {
+        *den = (uint32_t)1000000u << i;
+        if (pulse_port_msp430_muldiv((uint32_t)PULSE_MSP430_TICK_HZ, tick_us, *den, limit, counts, rem) == 0)
+        {
+            break;
+        }
+    }
+    if (i == PULSE_MSP430_DIVIDERS)
+    {
+        i = PULSE_MSP430_DIVIDERS - 1u;
+        *counts = limit;
+        *rem = 0u;
+    }
+    if (*counts < 2u)
+    {
+        *counts = 2u;
+        *rem = 0u;
+    }
+
+    return pulse_port_msp430_div_bits[i];
+}
+
+#if defined(PULSE_CFG_TICKLESS) && (PULSE_CFG_TICKLESS == 1u)
+
+/* Tick lengths the port can program, for PULSE_CFG_TICK_US. */
+#define PULSE_PORT_TICK_US_MIN ((2000000ul + (PULSE_MSP430_TICK_HZ) - 1ul) / (PULSE_MSP430_TICK_HZ))
+#define PULSE_PORT_TICK_US_MAX ((0x7FFFull * 8ull * 1000000ull) / (PULSE_MSP430_TICK_HZ))
+
+/* Tickless: TA0 free-runs in continuous mode and CCR0 is used as a one-shot
+ * compare. pulse_port_msp430_ref is TA0R at the last whole tick handed to the
+ * kernel, so the sub-tick remainder is never lost.
+ */
+static uint16_t pulse_port_msp430_ref;
+static uint16_t pulse_port_msp430_counts_per_tick;
+
+static inline void pulse_port_msp430_timer_init(uint32_t tick_us)
 {
-    uint32_t counts_per_ms;
-    uint32_t ccr0;
+    uint32_t counts;
+    uint32_t rem;
+    uint32_t den;
+    uint16_t id;
 
     TA0CTL = MC__STOP;
     TA0R = 0u;
 
-    counts_per_ms = (uint32_t)(PULSE_MSP430_TICK_HZ / 1000u);
-    ccr0 = (tick_ms * counts_per_ms);
+    /* Need headroom for at least one pending tick inside the 16-bit counter. */
+    id = pulse_port_msp430_timer_scale(tick_us, 0x7FFFu, &counts, &rem, &den);
+    if ((rem >= (den - rem)) && (counts < 0x7FFFu))
+    {
+        counts++;
+    }
+
+    pulse_port_msp430_counts_per_tick = (uint16_t)counts;
+    pulse_port_msp430_ref = 0u;
+
+    TA0CCR0 = pulse_port_msp430_counts_per_tick;
+    TA0CCTL0 = CCIE;
+
+    TA0CTL = (uint16_t)(PULSE_MSP430_TIMER_SRC | id | MC__CONTINUOUS | TACLR);
+}
+
+static inline uint32_t pulse_port_msp430_timer_elapsed(void)
+{
+    const uint16_t delta = (uint16_t)(TA0R - pulse_port_msp430_ref);
+    const uint16_t n = (uint16_t)(delta / pulse_port_msp430_counts_per_tick);
+
+    pulse_port_msp430_ref = (uint16_t)(pulse_port_msp430_ref + (uint16_t)(n * pulse_port_msp430_counts_per_tick));
+
+    return (uint32_t)n;
+}
+
+static inline void pulse_port_msp430_timer_set_next(uint32_t ticks)
+{
+    /* Keep one tick of headroom so TA0R can never lap pulse_port_msp430_ref. */
+    const uint32_t max_ticks = (uint32_t)((0xFFFFu - pulse_port_msp430_counts_per_tick) / pulse_port_msp430_counts_per_tick);
+    uint16_t target;
+
+    if (ticks > max_ticks)
+    {
+        ticks = max_ticks;
+    }
+    if (ticks == 0u)
+    {
+        ticks = 1u;
+    }
+
+    target = (uint16_t)(pulse_port_msp430_ref + (uint16_t)(ticks * pulse_port_msp430_counts_per_tick));
+
+    TA0CCR0 = target;
+    TA0CCTL0 &= (uint16_t)~CCIFG;
+
+    /* The counter may have passed the target while it was being programmed. */
+    if ((uint16_t)(TA0R - pulse_port_msp430_ref) >= (uint16_t)(target - pulse_port_msp430_ref))
+    {
+        TA0CCR0 = (uint16_t)(TA0R + 2u);
+    }
+}
+
+#if (defined(PULSE_CFG_STATS) && (PULSE_CFG_STATS == 1u)) || (defined(PULSE_CFG_POLL_BUDGET) && (PULSE_CFG_POLL_BUDGET == 1u))
+/* TA0 free-runs over the full 16 bits, so TA0R itself is the timestamp. */
+#define PULSE_PORT_STAMP_T     uint16_t
+#define PULSE_PORT_TIMESTAMP() (TA0R)
+#endif
+
+/* Sub-tick position for traces: counts since the last whole tick. */
+#define PULSE_PORT_SUBTICK() ((uint16_t)(TA0R - pulse_port_msp430_ref))
+
+#define PULSE_PORT_TIMER_ELAPSED()        pulse_port_msp430_timer_elapsed()
+#define PULSE_PORT_TIMER_SET_NEXT(ticks)  do { pulse_port_msp430_timer_set_next((ticks)); } while (0)
+
+#else
+
+/* Tick lengths the port can program, for PULSE_CFG_TICK_US. */
+#define PULSE_PORT_TICK_US_MIN ((2000000ul + (PULSE_MSP430_TICK_HZ) - 1ul) / (PULSE_MSP430_TICK_HZ))
+#define PULSE_PORT_TICK_US_MAX ((0xFFFFull * 8ull * 1000000ull) / (PULSE_MSP430_TICK_HZ))
+
+#if (PULSE_MSP430_DRIFT_CORRECTION == 1u)
+/* Bresenham over the remainder: each tick adds rem/den of a count, and a tick
+ * that carries runs one count longer. Reloaded in the CCR0 ISR while TA0R is
+ * still near 0, so it applies to the tick just started.
+ */
+static uint16_t pulse_port_msp430_ccr0;
+static uint32_t pulse_port_msp430_rem;
+static uint32_t pulse_port_msp430_den;
+static uint32_t pulse_port_msp430_acc;
+
+static inline void pulse_port_msp430_trim(void)
+{
+    pulse_port_msp430_acc += pulse_port_msp430_rem;
+    if (pulse_port_msp430_acc >= pulse_port_msp430_den)
+    {
+        pulse_port_msp430_acc -= pulse_port_msp430_den;
+        TA0CCR0 = (uint16_t)(pulse_port_msp430_ccr0 + 1u);
+    }
+    else
+    {
+        TA0CCR0 = pulse_port_msp430_ccr0;
+    }
+}
+
+#define PULSE_PORT_MSP430_TRIM() do { pulse_port_msp430_trim(); } while (0)
+#endif
+
+static inline void pulse_port_msp430_timer_init(uint32_t tick_us)
+{
+    uint32_t counts;
+    uint32_t rem;
+    uint32_t den;
+    uint16_t id;
+
+    TA0CTL = MC__STOP;
+    TA0R = 0u;
 
-    if (ccr0 > 0u)
+    /* At most 0xFFFF whole counts, so a carried tick still fits TA0CCR0. */
+    id = pulse_port_msp430_timer_scale(tick_us, 0xFFFFu, &counts, &rem, &den);
+#if (PULSE_MSP430_DRIFT_CORRECTION == 1u)
+    pulse_port_msp430_ccr0 = (uint16_t)(counts - 1u);
+    pulse_port_msp430_rem = rem;
+    pulse_port_msp430_den = den;
+    pulse_port_msp430_acc = 0u;
+#else
+    if (rem >= (den - rem))
     {
-        ccr0 -= 1u;
+        counts++;
     }
+#endif
 
-    TA0CCR0 = (uint16_t)ccr0;
+    TA0CCR0 = (uint16_t)(counts - 1u);
     TA0CCTL0 = CCIE;
 
-    TA0CTL = (uint16_t)(PULSE_MSP430_TIMER_SRC | MC__UP | TACLR);
+    TA0CTL = (uint16_t)(PULSE_MSP430_TIMER_SRC | id | MC__UP | TACLR);
 }
 
-#define PULSE_PORT_TIMER_INIT(tick_ms) do { pulse_port_msp430_timer_init((tick_ms)); } while (0)
+#if (defined(PULSE_CFG_STATS) && (PULSE_CFG_STATS == 1u)) || (defined(PULSE_CFG_POLL_BUDGET) && (PULSE_CFG_POLL_BUDGET == 1u))
+/* In up mode TA0R restarts every tick, so the timestamp is extended by the
+ * CCR0 ISR, which adds each finished tick's TA0CCR0 + 1 counts to a base.
+ */
+static volatile uint32_t pulse_port_msp430_stamp_base;
+
+#define PULSE_PORT_MSP430_COUNT_TICK() do { pulse_port_msp430_stamp_base += (uint32_t)TA0CCR0 + 1u; } while (0)
+
+static inline uint32_t pulse_port_msp430_timestamp(void)
+{
+    const uint16_t sr = __get_interrupt_state();
+    uint32_t base;
+    uint16_t cnt;
+
+    __disable_interrupt();
+    cnt = TA0R;
+    base = pulse_port_msp430_stamp_base;
+
+    /* CCR0 matched but its ISR has not run yet: count that tick here. */
+    if ((TA0CCTL0 & CCIFG) != 0u)
+    {
+        cnt = TA0R;
+        base += (uint32_t)TA0CCR0 + 1u;
+    }
+    __set_interrupt_state(sr);
+
+    return base + (uint32_t)cnt;
+}
+
+#define PULSE_PORT_TIMESTAMP() pulse_port_msp430_timestamp()
+#endif
+
+/* Sub-tick position for traces: TA0R restarts every tick (TA0CCR0 + 1 counts). */
+#define PULSE_PORT_SUBTICK() ((uint16_t)TA0R)
+
+#endif /* PULSE_CFG_TICKLESS */
+
+#define PULSE_PORT_TIMER_INIT_US(tick_us) do { pulse_port_msp430_timer_init((tick_us)); } while (0)
+
+#ifndef PULSE_PORT_MSP430_COUNT_TICK
+#define PULSE_PORT_MSP430_COUNT_TICK() do { } while (0)
+#endif
+#ifndef PULSE_PORT_MSP430_TRIM
+#define PULSE_PORT_MSP430_TRIM() do { } while (0)
+#endif
 
 #if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
 #pragma vector = TIMER0_A0_VECTOR
 __interrupt void pulse_timer0_a0_isr(void)
 {
     extern void pulse_tick_isr(void);
+    PULSE_PORT_MSP430_COUNT_TICK();
+    PULSE_PORT_MSP430_TRIM();
     pulse_tick_isr();
+    PULSE_MSP430_WAKE_ON_EXIT();
 }
 #else
 void __attribute__((interrupt(TIMER0_A0_VECTOR))) pulse_timer0_a0_isr(void)
 {
     extern void pulse_tick_isr(void);
+    PULSE_PORT_MSP430_COUNT_TICK();
+    PULSE_PORT_MSP430_TRIM();
     pulse_tick_isr();
+    PULSE_MSP430_WAKE_ON_EXIT();
 }
 #endif
 
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * pulse_port_posix.h - POSIX threads port for pulse.h (Linux, C11)
+ *
+ * Runs the kernel on a host at real tick rates. A timer thread sleeps to
+ * absolute CLOCK_MONOTONIC deadlines and signals the thread that called
+ * pulse_start(); the signal handler is the tick interrupt and calls
+ * pulse_tick_isr() once per elapsed tick. Critical sections block that
+ * signal, so main context sees the same preemption as on a single-core
+ * target. Include it before any system header, or build with
+ * -D_POSIX_C_SOURCE=200809L, and link with -pthread.
+ */
+
+#ifndef PULSE_PORT_POSIX_H
+#define PULSE_PORT_POSIX_H
+
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <time.h>
+
+#if defined(PULSE_CFG_TICKLESS) && (PULSE_CFG_TICKLESS == 1u)
+#error "pulse_port_posix.h: tickless builds are not supported"
+#endif
+
+/* Signal that carries the tick to the kernel thread. */
+#ifndef PULSE_POSIX_TICK_SIGNAL
+#define PULSE_POSIX_TICK_SIGNAL SIGUSR1
+#endif
+
+static pthread_t pulse_port_posix_main;
+static pthread_t pulse_port_posix_timer;
+static atomic_uint pulse_port_posix_run;
+static uint32_t pulse_port_posix_tick_ns;
+
+/* Ticks raised by the timer thread and not yet handled. Signals of one kind
+ * do not queue, so the handler drains the count instead of counting signals.
+ */
+static atomic_uint pulse_port_posix_pending;
+
+/* Ticks handled and critical sections entered, for reports. */
+static atomic_uint pulse_port_posix_ticks;
+static atomic_uint pulse_port_posix_criticals;
+
+/* Nesting depth of critical sections and of the handler, which counts as
+ * one. Only the kernel thread touches it.
+ */
+static volatile uint32_t pulse_port_posix_depth;
+
+static inline void pulse_port_posix_mask(int how)
+{
+    sigset_t set;
+
+    (void)sigemptyset(&set);
+    (void)sigaddset(&set, PULSE_POSIX_TICK_SIGNAL);
+    (void)pthread_sigmask(how, &set, (sigset_t *)0);
+}
+
+static inline void pulse_port_posix_enter(void)
+{
+    (void)atomic_fetch_add(&pulse_port_posix_criticals, 1u);
+    pulse_port_posix_depth++;
+    if (pulse_port_posix_depth == 1u)
+    {
+        pulse_port_posix_mask(SIG_BLOCK);
+    }
+}
+
+static inline void pulse_port_posix_exit(void)
+{
+    pulse_port_posix_depth--;
+    if (pulse_port_posix_depth == 0u)
+    {
+        pulse_port_posix_mask(SIG_UNBLOCK);
+    }
+}
+
+/* Waits for the tick signal with it unblocked, then leaves it blocked or
+ * unblocked as `how` says.
+ */
+static inline void pulse_port_posix_wait(int how)
+{
+    sigset_t set;
+
+    (void)pthread_sigmask(SIG_SETMASK, (const sigset_t *)0, &set);
+    (void)sigdelset(&set, PULSE_POSIX_TICK_SIGNAL);
+    (void)sigsuspend(&set);
+    pulse_port_posix_mask(how);
+}
+
+#define PULSE_PORT_ENTER_CRITICAL()     pulse_port_posix_enter()
+#define PULSE_PORT_EXIT_CRITICAL()      pulse_port_posix_exit()
+#define PULSE_PORT_DISABLE_GLOBAL_IRQ() pulse_port_posix_mask(SIG_BLOCK)
+#define PULSE_PORT_ENABLE_GLOBAL_IRQ()  pulse_port_posix_mask(SIG_UNBLOCK)
+
+/* A release published between pulse_poll() returning and the wait is picked
+ * up after the following tick at the latest, as with WFI on a target.
+ */
+#ifndef PULSE_PORT_IDLE_HOOK
+#define PULSE_PORT_IDLE_HOOK()          pulse_port_posix_wait(SIG_UNBLOCK)
+#endif
+
+/* Entered with the signal blocked; sigsuspend() unblocks and waits in one
+ * step.
+ */
+#define PULSE_PORT_SLEEP_ENABLE_IRQ()   pulse_port_posix_wait(SIG_UNBLOCK)
+
+#if defined(__GNUC__) && !defined(PULSE_PORT_CTZ)
+#define PULSE_PORT_CTZ(x) ((uint8_t)__builtin_ctzll((unsigned long long)(x)))
+#endif
+
+/* Word-sized loads and stores are single-copy atomic (pulse_ring.h indices). */
+#ifndef PULSE_PORT_WORD_T
+#define PULSE_PORT_WORD_T uint32_t
+#endif
+
+#define PULSE_PORT_ATOMIC_T                 atomic_uint_least32_t
+#define PULSE_PORT_ATOMIC_BITS              (32u)
+#define PULSE_PORT_ATOMIC_LOAD(p)           ((uint32_t)atomic_load(p))
+#define PULSE_PORT_ATOMIC_STORE(p, v)       atomic_store((p), (uint32_t)(v))
+#define PULSE_PORT_ATOMIC_FETCH_OR(p, v)    ((uint32_t)atomic_fetch_or((p), (uint32_t)(v)))
+#define PULSE_PORT_ATOMIC_FETCH_AND(p, v)   ((uint32_t)atomic_fetch_and((p), (uint32_t)(v)))
+
+/* Microseconds on CLOCK_MONOTONIC, wrapping at 32 bits. */
+static inline uint32_t pulse_port_posix_timestamp(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(((uint64_t)ts.tv_sec * 1000000u) + ((uint64_t)ts.tv_nsec / 1000u));
+}
+
+#define PULSE_PORT_TIMESTAMP()          pulse_port_posix_timestamp()
+
+#if defined(PULSE_CFG_TRACE) && (PULSE_CFG_TRACE == 1u)
+#define PULSE_PORT_SUBTICK()            (0u)
+#endif
+
+static void pulse_port_posix_handler(int sig)
+{
+    extern void pulse_tick_isr(void);
+
+    (void)sig;
+    pulse_port_posix_depth++;
+    while (atomic_load(&pulse_port_posix_pending) != 0u)
+    {
+        (void)atomic_fetch_sub(&pulse_port_posix_pending, 1u);
+        (void)atomic_fetch_add(&pulse_port_posix_ticks, 1u);
+        pulse_tick_isr();
+    }
+    pulse_port_posix_depth--;
+}
+
+static void *pulse_port_posix_thread(void *arg)
+{
+    struct timespec next;
+
+    (void)arg;
+    pulse_port_posix_mask(SIG_BLOCK);
+    (void)clock_gettime(CLOCK_MONOTONIC, &next);
+    while (atomic_load(&pulse_port_posix_run) != 0u)
+    {
+        next.tv_nsec += (long)pulse_port_posix_tick_ns;
+        while (next.tv_nsec >= 1000000000L)
+        {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, (struct timespec *)0) == EINTR)
+        {
+        }
+        (void)atomic_fetch_add(&pulse_port_posix_pending, 1u);
+        (void)pthread_kill(pulse_port_posix_main, PULSE_POSIX_TICK_SIGNAL);
+    }
+    return (void *)0;
+}
+
+/* Starts the timer thread. The calling thread takes the ticks. */
+static inline void pulse_port_posix_start(uint32_t tick_us)
+{
+    struct sigaction sa;
+
+    pulse_port_posix_main = pthread_self();
+    pulse_port_posix_tick_ns = tick_us * 1000u;
+    sa.sa_handler = pulse_port_posix_handler;
+    (void)sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    (void)sigaction(PULSE_POSIX_TICK_SIGNAL, &sa, (struct sigaction *)0);
+
+    atomic_store(&pulse_port_posix_run, 1u);
+    (void)pthread_create(&pulse_port_posix_timer, (const pthread_attr_t *)0, pulse_port_posix_thread, (void *)0);
+}
+
+/* Stops and joins the timer thread. A tick raised just before is still
+ * handled.
+ */
+static inline void pulse_port_posix_stop(void)
+{
+    atomic_store(&pulse_port_posix_run, 0u);
+    (void)pthread_join(pulse_port_posix_timer, (void **)0);
+}
+
+/* Tick lengths the timer thread can keep up with, for PULSE_CFG_TICK_US. */
+#define PULSE_PORT_TICK_US_MIN (10u)
+#define PULSE_PORT_TICK_US_MAX (4000000u)
+
+#define PULSE_PORT_TIMER_INIT_US(tick_us) pulse_port_posix_start((uint32_t)(tick_us))
+
+#endif /* PULSE_PORT_POSIX_H */
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * pulse_ring.h - Lock-free single-producer/single-consumer ring of fixed slots
+ *
+ *   static frame_t rx_slots[16];
+ *   static pulse_ring_t rx;
+ *
+ *   pulse_ring_init(&rx, rx_slots, sizeof(rx_slots[0]), 16u);
+ *
+ *   ISR (producer):                      Task (consumer):
+ *     frame_t *f = pulse_ring_reserve(&rx);  frame_t *f = pulse_ring_peek(&rx);
+ *     if (f != NULL) {                       if (f != NULL) {
+ *         fill(f);                               handle(f);
+ *         pulse_ring_commit(&rx);                pulse_ring_release(&rx);
+ *     }                                      }
+ *
+ * Producer and consumer work in place on the slot storage, so a frame is
+ * never copied. Each side writes only its own index, with one store of a
+ * pulse_ring_idx_t; no critical section is entered on either side. One
+ * context must be the only producer and one the only consumer, e.g. an ISR
+ * and a Pulse task, or two Pulse tasks.
+ *
+ * Indices are free-running counters, so all slots are usable and the fill
+ * level is head - tail. Capacity must be a power of two and at most half
+ * the index range: 128 slots with the default 8-bit index.
+ */
+
+#ifndef PULSE_RING_H
+#define PULSE_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Index type. It must be read and written by a single instruction on the
+ * target, which uint8_t is everywhere. Ports may widen it to their native
+ * word (e.g. uint32_t on Cortex-M) to allow larger rings.
+ */
+#ifndef PULSE_PORT_WORD_T
+#define PULSE_PORT_WORD_T uint8_t
+#endif
+
+/* Orders slot accesses against the index store that publishes or frees them.
+ * An interrupt observes its own core's stores in program order, so between an
+ * ISR and the main loop only the compiler has to be stopped. Define a
+ * hardware fence (e.g. `dmb` on Cortex-M) when the other side is a DMA engine
+ * or another core.
+ */
+#ifndef PULSE_PORT_MEMORY_BARRIER
+#if defined(__GNUC__)
+#define PULSE_PORT_MEMORY_BARRIER() do { __asm volatile ("" ::: "memory"); } while (0)
+#else
+#error "pulse_ring.h: define PULSE_PORT_MEMORY_BARRIER() for this compiler"
+#endif
+#endif
+
+typedef PULSE_PORT_WORD_T pulse_ring_idx_t;
+
+#define PULSE_RING_MAX_CAPACITY ((uint32_t)(((pulse_ring_idx_t)~(pulse_ring_idx_t)0 >> 1u) + 1u))
+
+typedef struct
+{
+    volatile pulse_ring_idx_t head; /* slots committed; written by the producer only */
+    volatile pulse_ring_idx_t tail; /* slots released; written by the consumer only */
+    pulse_ring_idx_t mask;          /* capacity - 1 */
+    uint16_t slot_size;
+    uint8_t *slots;
+} pulse_ring_t;
+
+/* Returns 0, or -1 if capacity is not a power of two in
+ * 1..PULSE_RING_MAX_CAPACITY or the storage is missing. Call before either
+ * side runs; the ring starts empty.
+ */
+static inline int32_t pulse_ring_init(pulse_ring_t *r, void *storage, uint16_t slot_size, uint32_t capacity)
+{
+    const int valid = (r != NULL) && (storage != NULL) && (slot_size != 0u) && (capacity != 0u) &&
+                      (capacity <= PULSE_RING_MAX_CAPACITY) && ((capacity & (capacity - 1u)) == 0u);
+
+    if (!valid)
+    {
+        return -1;
+    }
+
+    r->head = 0u;
+    r->tail = 0u;
+    r->mask = (pulse_ring_idx_t)(capacity - 1u);
+    r->slot_size = slot_size;
+    r->slots = (uint8_t *)storage;
+    return 0;
+}
+
+static inline void *pulse_ring_slot(const pulse_ring_t *r, pulse_ring_idx_t i)
+{
+    return (void *)&r->slots[(size_t)(pulse_ring_idx_t)(i & r->mask) * r->slot_size];
+}
+
+/* Slots committed and not yet released. Exact from either side; a snapshot
+ * from anywhere else.
+ */
+static inline uint32_t pulse_ring_count(const pulse_ring_t *r)
+{
+    return (uint32_t)(pulse_ring_idx_t)(r->head - r->tail);
+}
+
+static inline uint32_t pulse_ring_capacity(const pulse_ring_t *r)
+{
+    return (uint32_t)r->mask + 1u;
+}
+
+static inline int pulse_ring_empty(const pulse_ring_t *r)
+{
+    return r->head == r->tail;
+}
+
+static inline int pulse_ring_full(const pulse_ring_t *r)
+{
+    return pulse_ring_count(r) == pulse_ring_capacity(r);
+}
+
+/* ---------------- Producer side ---------------- */
+
+/* The next free slot to fill in place, or NULL if the ring is full. The slot
+ * stays invisible to the consumer until pulse_ring_commit(); reserving again
+ * before that returns the same slot.
+ */
+static inline void *pulse_ring_reserve(pulse_ring_t *r)
+{
+    const pulse_ring_idx_t head = r->head;
+
+    if ((pulse_ring_idx_t)(head - r->tail) > r->mask)
+    {
+        return NULL;
+    }
+    /* The consumer's last reads of this slot happen before its tail store. */
+    PULSE_PORT_MEMORY_BARRIER();
+    return pulse_ring_slot(r, head);
+}
+
+/* Publishes the reserved slot. Only valid after a reserve that returned a
+ * slot.
+ */
+static inline void pulse_ring_commit(pulse_ring_t *r)
+{
+    PULSE_PORT_MEMORY_BARRIER();
+    r->head = (pulse_ring_idx_t)(r->head + 1u);
+}
+
+/* ---------------- Consumer side ---------------- */
+
+/* The oldest committed slot, read in place, or NULL if the ring is empty.
+ * Peeking again before pulse_ring_release() returns the same slot.
+ */
+static inline void *pulse_ring_peek(pulse_ring_t *r)
+{
+    const pulse_ring_idx_t tail = r->tail;
+
+    if (r->head == tail)
+    {
+        return NULL;
+    }
+    /* Slot contents are read only after the head that published them. */
+    PULSE_PORT_MEMORY_BARRIER();
+    return pulse_ring_slot(r, tail);
+}
+
+/* Hands the peeked slot back to the producer. Only valid after a peek that
+ * returned a slot; the slot must not be touched afterwards.
+ */
+static inline void pulse_ring_release(pulse_ring_t *r)
+{
+    PULSE_PORT_MEMORY_BARRIER();
+    r->tail = (pulse_ring_idx_t)(r->tail + 1u);
+}
+
+#endif /* PULSE_RING_H */
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * pulse_seqlock.h - Sequence lock for consistent multi-word snapshots
+ *
+ *   static telemetry_t g_tlm;
+ *   static pulse_seqlock_t g_tlm_lock = PULSE_SEQLOCK_INIT;
+ *
+ *   Writer (ISR or task):                Reader (task):
+ *     pulse_seqlock_write_begin(&lock);    telemetry_t snap;
+ *     g_tlm.temp_c = t;                    if (PULSE_SEQLOCK_READ(&lock, snap, g_tlm) == 0) {
+ *     g_tlm.tick = now;                        send(&snap);
+ *     pulse_seqlock_write_end(&lock);      }
+ *
+ * The writer never waits: it bumps the sequence to odd, updates the data and
+ * bumps it back to even. A reader copies the data and keeps the copy only if
+ * the sequence was even and unchanged across it. Neither side enters a
+ * critical section.
+ *
+ * All writes to one lock must come from one context at a time: one ISR, or
+ * the main loop (tasks never preempt each other). Readers may be anywhere.
+ * A reader that keeps losing to the writer gives up after
+ * PULSE_SEQLOCK_TRIES attempts and reports it, rather than spinning; that is
+ * what makes reading from an ISR safe when the writer is a task.
+ *
+ * The sequence is a PULSE_PORT_WORD_T, so readers load it in one instruction.
+ * With the default 8-bit word a copy is only mistaken if the reader is held
+ * off for exactly a multiple of 128 complete writes.
+ */
+
+#ifndef PULSE_SEQLOCK_H
+#define PULSE_SEQLOCK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Same meaning and defaults as in pulse_ring.h. */
+#ifndef PULSE_PORT_WORD_T
+#define PULSE_PORT_WORD_T uint8_t
+#endif
+
+#ifndef PULSE_PORT_MEMORY_BARRIER
+#if defined(__GNUC__)
+#define PULSE_PORT_MEMORY_BARRIER() do { __asm volatile ("" ::: "memory"); } while (0)
+#else
+#error "pulse_seqlock.h: define PULSE_PORT_MEMORY_BARRIER() for this compiler"
+#endif
+#endif
+
+/* Copy attempts pulse_seqlock_read() makes before it reports failure. */
+#ifndef PULSE_SEQLOCK_TRIES
+#define PULSE_SEQLOCK_TRIES (4u)
+#endif
+
+#if (PULSE_SEQLOCK_TRIES < 1u) || (PULSE_SEQLOCK_TRIES > 65535u)
+#error "PULSE_SEQLOCK_TRIES must be in range 1..65535"
+#endif
+
+typedef PULSE_PORT_WORD_T pulse_seq_t;
+
+typedef struct
+{
+    volatile pulse_seq_t seq; /* odd while a write is in progress */
+} pulse_seqlock_t;
+
+#define PULSE_SEQLOCK_INIT { 0u }
+
+static inline void pulse_seqlock_init(pulse_seqlock_t *l)
+{
+    l->seq = 0u;
+}
+
+/* ---------------- Writer side ---------------- */
+
+static inline void pulse_seqlock_write_begin(pulse_seqlock_t *l)
+{
+    l->seq = (pulse_seq_t)(l->seq + 1u);
+    /* Odd sequence is visible before any data store. */
+    PULSE_PORT_MEMORY_BARRIER();
+}
+
+static inline void pulse_seqlock_write_end(pulse_seqlock_t *l)
+{
+    /* All data stores land before the sequence turns even again. */
+    PULSE_PORT_MEMORY_BARRIER();
+    l->seq = (pulse_seq_t)(l->seq + 1u);
+}
+
+/* ---------------- Reader side ---------------- */
+
+/* Open-coded read: sample the sequence, copy, then ask whether to retry.
+ * The caller bounds the loop.
+ */
+static inline pulse_seq_t pulse_seqlock_read_begin(const pulse_seqlock_t *l)
+{
+    const pulse_seq_t s = l->seq;
+
+    PULSE_PORT_MEMORY_BARRIER();
+    return s;
+}
+
+/* Nonzero if the copy taken since read_begin() returned start may be torn. */
+static inline int pulse_seqlock_read_retry(const pulse_seqlock_t *l, pulse_seq_t start)
+{
+    PULSE_PORT_MEMORY_BARRIER();
+    return ((start & 1u) != 0u) || (l->seq != start);
+}
+
+/* Copies size bytes from the protected data at src to dst. Returns 0 with a
+ * consistent copy in dst, or -1 after PULSE_SEQLOCK_TRIES torn attempts (dst
+ * then holds the last, possibly torn, copy and must not be used).
+ */
+static inline int32_t pulse_seqlock_read(const pulse_seqlock_t *l, void *dst, const void *src, size_t size)
+{
+    uint32_t tries;
+    pulse_seq_t start;
+
+    for (tries = 0u; tries < PULSE_SEQLOCK_TRIES; tries++)
+    {
+        start = pulse_seqlock_read_begin(l);
+        if ((start & 1u) == 0u)
+        {
+            (void)memcpy(dst, src, size);
+            if (!pulse_seqlock_read_retry(l, start))
+            {
+                return 0;
+            }
+        }
+    }
+    return -1;
+}
+
+/* Typed forms. A dst of a different size than the object does not compile. */
+#define PULSE_SEQLOCK_READ(lock, dst, obj) \
+    pulse_seqlock_read((lock), &(dst), &(obj), sizeof(obj) * sizeof(char[(sizeof(dst) == sizeof(obj)) ? 1 : -1]))
+
+#define PULSE_SEQLOCK_WRITE(lock, obj, src) \
+    do { pulse_seqlock_write_begin((lock)); (obj) = (src); pulse_seqlock_write_end((lock)); } while (0)
+
+#endif /* PULSE_SEQLOCK_H */
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_batch.c - Hosted unit tests for batched dispatch (GCC)
+ *
+ * The host port counts critical sections, so these tests also check how often
+ * the tick ISR and pulse_poll() would mask interrupts on a target.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PULSE_CFG_BATCH_DISPATCH (1u)
+#define PULSE_PORT_HOST_COUNT_CRITICAL
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (8u)
+#include "../src/pulse.h"
+
+/* ---------------- Test logging ---------------- */
+
+typedef struct
+{
+    uint32_t tick;
+    uint8_t  task_id;
+} exec_event_t;
+
+static exec_event_t g_log[64];
+static uint32_t g_log_len = 0u;
+static uint32_t g_now_tick = 0u;
+static uint8_t  g_nested_tick = 0u;
+
+static void log_exec(uint8_t task_id)
+{
+    if (g_log_len < (uint32_t)(sizeof(g_log) / sizeof(g_log[0])))
+    {
+        g_log[g_log_len].tick = g_now_tick;
+        g_log[g_log_len].task_id = task_id;
+        g_log_len++;
+    }
+}
+
+static void reset_log(void)
+{
+    g_log_len = 0u;
+    g_now_tick = 0u;
+    g_nested_tick = 0u;
+}
+
+static void tick_once(void)
+{
+    g_now_tick++;
+    pulse_tick_isr();
+}
+
+static pulse_state_t task0(pulse_state_t s)
+{
+    (void)s;
+    log_exec(0u);
+    return 0;
+}
+
+/* Optionally lets one tick interrupt fire while it runs. */
+static pulse_state_t task1(pulse_state_t s)
+{
+    (void)s;
+    log_exec(1u);
+    if (g_nested_tick != 0u)
+    {
+        g_nested_tick = 0u;
+        tick_once();
+    }
+    return 0;
+}
+
+static pulse_state_t task2(pulse_state_t s)
+{
+    (void)s;
+    log_exec(2u);
+    return 0;
+}
+
+static void expect_event(uint32_t idx, uint32_t tick, uint8_t task_id)
+{
+    assert(idx < g_log_len);
+    assert(g_log[idx].tick == tick);
+    assert(g_log[idx].task_id == task_id);
+}
+
+static void test_one_critical_section_per_release_tick(void)
+{
+    uint32_t before;
+
+    reset_log();
+
+    pulse_init(1u);
+
+    assert(pulse_add_task(0, 4u, task0) == 0);
+    assert(pulse_add_task(0, 4u, task1) == 0);
+    assert(pulse_add_task(0, 4u, task2) == 0);
+
+    pulse_poll();
+    assert(g_log_len == 3u);
+
+    /* Nothing due: the ISR never masks interrupts. */
+    before = pulse_port_host_critical_count;
+    tick_once();
+    tick_once();
+    tick_once();
+    assert(pulse_port_host_critical_count == before);
+
+    /* Three releases on one tick are published together. */
+    before = pulse_port_host_critical_count;
+    tick_once();
+    assert(pulse_port_host_critical_count == (before + 1u));
+
+    /* One batch: claim, retire, then the empty check that ends the poll. */
+    before = pulse_port_host_critical_count;
+    pulse_poll();
+    assert(pulse_port_host_critical_count == (before + 3u));
+
+    assert(g_log_len == 6u);
+    expect_event(3u, 4u, 0u);
+    expect_event(4u, 4u, 1u);
+    expect_event(5u, 4u, 2u);
+}
+
+static void test_mid_batch_release_waits_for_next_batch(void)
+{
+    reset_log();
+
+    pulse_init(1u);
+
+    assert(pulse_add_task(0, 2u, task0) == 0);
+    assert(pulse_add_task(0, 1u, task1) == 0);
+
+    pulse_poll();
+    assert(g_log_len == 2u);
+
+    /* Tick 1 releases task1 only. While it runs, tick 2 releases task0. */
+    tick_once();
+    g_nested_tick = 1u;
+    pulse_poll();
+
+    /* task0 outranks task1 but joins the next batch of the same poll. */
+    assert(g_log_len == 4u);
+    expect_event(2u, 1u, 1u);
+    expect_event(3u, 2u, 0u);
+
+    /* task1 was still marked running at tick 2, so it is due again at 3. */
+    tick_once();
+    pulse_poll();
+    assert(g_log_len == 5u);
+    expect_event(4u, 3u, 1u);
+}
+
+static void test_batch_keeps_priority_order(void)
+{
+    uint32_t i;
+
+    reset_log();
+
+    pulse_init(1u);
+
+    assert(pulse_add_task(0, 4u, task0) == 0);
+    assert(pulse_add_task(0, 2u, task1) == 0);
+    assert(pulse_add_task(0, 6u, task2) == 0);
+
+    for (i = 0u; i < 5u; i++)
+    {
+        tick_once();
+        pulse_poll();
+    }
+
+    assert(g_log_len == 6u);
+    expect_event(0u, 1u, 0u);
+    expect_event(1u, 1u, 1u);
+    expect_event(2u, 1u, 2u);
+    expect_event(3u, 3u, 1u);
+    expect_event(4u, 5u, 0u);
+    expect_event(5u, 5u, 1u);
+}
+
+int main(void)
+{
+    test_one_critical_section_per_release_tick();
+    test_mid_batch_release_waits_for_next_batch();
+    test_batch_keeps_priority_order();
+
+    printf("All batch dispatch tests passed.\n");
+    return 0;
+}
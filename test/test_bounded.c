@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_bounded.c - Hosted unit tests for bounded and time-budget polling (GCC)
+ *
+ * Each task appends its id to a log and advances the host timestamp by its
+ * simulated execution time. Built against the scan and heap backends and
+ * with batch dispatch by the Makefile.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PULSE_CFG_POLL_BUDGET (1u)
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (8u)
+#include "../src/pulse.h"
+
+#define TASK_COUNT (5u)
+#define TASK_COST  (10u)
+
+static uint8_t g_log[64];
+static uint32_t g_log_len = 0u;
+
+static void log_run(uint8_t id)
+{
+    assert(g_log_len < sizeof(g_log));
+    g_log[g_log_len] = id;
+    g_log_len++;
+    pulse_port_host_stamp += TASK_COST;
+}
+
+static pulse_state_t task0(pulse_state_t s)
+{
+    log_run(0u);
+    return s;
+}
+
+static pulse_state_t task1(pulse_state_t s)
+{
+    log_run(1u);
+    return s;
+}
+
+static pulse_state_t task2(pulse_state_t s)
+{
+    log_run(2u);
+    return s;
+}
+
+static pulse_state_t task3(pulse_state_t s)
+{
+    log_run(3u);
+    return s;
+}
+
+static pulse_state_t task4(pulse_state_t s)
+{
+    log_run(4u);
+    return s;
+}
+
+static const pulse_tick_f g_tasks[TASK_COUNT] = { task0, task1, task2, task3, task4 };
+
+/* All tasks every tick; the initial release makes them all ready at once. */
+static void setup(void)
+{
+    uint32_t i;
+
+    g_log_len = 0u;
+    pulse_port_host_stamp = 0u;
+    pulse_init(1u);
+    for (i = 0u; i < TASK_COUNT; i++)
+    {
+        assert(pulse_add_task(0, 1u, g_tasks[i]) == 0);
+    }
+}
+
+static void test_bounded_runs_in_priority_order(void)
+{
+    setup();
+
+    assert(pulse_poll_bounded(0u) == 5u);
+    assert(g_log_len == 0u);
+
+    assert(pulse_poll_bounded(2u) == 3u);
+    assert(g_log_len == 2u);
+    assert((g_log[0] == 0u) && (g_log[1] == 1u));
+
+    assert(pulse_poll_bounded(2u) == 1u);
+    assert(g_log_len == 4u);
+    assert((g_log[2] == 2u) && (g_log[3] == 3u));
+
+    /* Fewer ready than allowed: drains and reports nothing left. */
+    assert(pulse_poll_bounded(2u) == 0u);
+    assert(g_log_len == 5u);
+    assert(g_log[4] == 4u);
+
+    assert(pulse_poll_bounded(255u) == 0u);
+    assert(g_log_len == 5u);
+}
+
+static void test_higher_priority_release_goes_first(void)
+{
+    setup();
+
+    assert(pulse_poll_bounded(1u) == 4u);
+    assert(g_log[0] == 0u);
+
+    /* Task 0 is released again while 1..4 still wait: it runs next. */
+    pulse_tick_isr();
+    assert(pulse_poll_bounded(1u) == 4u);
+    assert(g_log[1] == 0u);
+
+    assert(pulse_poll_bounded(1u) == 3u);
+    assert(g_log[2] == 1u);
+
+    /* An unbounded poll still drains everything. */
+    pulse_poll();
+    assert(g_log_len == 6u);
+    assert(pulse_poll_bounded(1u) == 0u);
+}
+
+static void test_budget_stops_between_tasks(void)
+{
+    setup();
+
+    /* Zero budget runs nothing. */
+    assert(pulse_poll_budget(0u) == 5u);
+    assert(g_log_len == 0u);
+
+    /* Checked before each start: 0, 10 and 20 are inside 25 units, so the
+     * third task runs and the call ends at 30.
+     */
+    assert(pulse_poll_budget(25u) == 2u);
+    assert(g_log_len == 3u);
+    assert((g_log[0] == 0u) && (g_log[1] == 1u) && (g_log[2] == 2u));
+    assert(pulse_port_host_stamp == 30u);
+
+    /* Exactly one task's worth. */
+    assert(pulse_poll_budget(TASK_COST) == 1u);
+    assert(g_log_len == 4u);
+    assert(g_log[3] == 3u);
+
+    assert(pulse_poll_budget(1000u) == 0u);
+    assert(g_log_len == 5u);
+    assert(pulse_port_host_stamp == 50u);
+}
+
+static void test_budget_survives_timestamp_wrap(void)
+{
+    setup();
+
+    pulse_port_host_stamp = 0xFFFFFFF0u;
+    assert(pulse_poll_budget(30u) == 2u);
+    assert(g_log_len == 3u);
+    assert(pulse_port_host_stamp == 14u);
+}
+
+static void test_instance_bounded(void)
+{
+    static pulse_kernel_t k;
+
+    g_log_len = 0u;
+    pulse_kernel_init(&k, 1u);
+    assert(pulse_kernel_add_task(&k, 0, 1u, task3) == 0);
+    assert(pulse_kernel_add_task(&k, 0, 1u, task4) == 0);
+
+    assert(pulse_kernel_poll_bounded(&k, 1u) == 1u);
+    assert(pulse_kernel_poll_budget(&k, 1u) == 0u);
+    assert(g_log_len == 2u);
+    assert((g_log[0] == 3u) && (g_log[1] == 4u));
+}
+
+int main(void)
+{
+    test_bounded_runs_in_priority_order();
+    test_higher_priority_release_goes_first();
+    test_budget_stops_between_tasks();
+    test_budget_survives_timestamp_wrap();
+    test_instance_bounded();
+
+    printf("All bounded poll tests passed.\n");
+    return 0;
+}
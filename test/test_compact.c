@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_compact.c - Hosted unit tests for 16-bit ticks and 8-bit state (GCC)
+ *
+ * Runs the kernel past the point where a 16-bit tick counter wraps and
+ * checks the period limits of the narrow type. Built against each release
+ * backend by the Makefile.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PULSE_CFG_TICK_T       uint16_t
+#define PULSE_CFG_STATE_T      int8_t
+#define PULSE_CFG_WHEEL_LEVELS (2u)
+#define PULSE_CFG_OVERRUN      (1u)
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (4u)
+#include "../src/pulse.h"
+
+#define BEACON_PERIOD (1000u)
+PULSE_PERIOD_CHECK(beacon, BEACON_PERIOD);
+
+static uint32_t g_now = 0u;
+static uint32_t g_runs[PULSE_MAX_TASKS];
+static uint32_t g_last[PULSE_MAX_TASKS];
+
+/* State is the task id in the low two bits and a run count above them. */
+static pulse_state_t counter(pulse_state_t s)
+{
+    const uint8_t id = (uint8_t)((uint8_t)s & 3u);
+
+    if (g_runs[id] != 0u)
+    {
+        /* Every run lands exactly one period after the previous one. */
+        assert((g_now - g_last[id]) == ((id == 0u) ? BEACON_PERIOD : 7u));
+    }
+    g_last[id] = g_now;
+    g_runs[id]++;
+    return (pulse_state_t)(uint8_t)((uint8_t)s + 4u);
+}
+
+static void reset(void)
+{
+    uint32_t i;
+
+    g_now = 0u;
+    for (i = 0u; i < PULSE_MAX_TASKS; i++)
+    {
+        g_runs[i] = 0u;
+    }
+    pulse_init(1u);
+}
+
+static void test_types_are_narrow(void)
+{
+    pulse_task_t t;
+
+    assert(sizeof(t.state) == 1u);
+    assert(sizeof(t.period_ticks) == 2u);
+    assert(PULSE_TICK_MAX == 0xFFFFu);
+    assert(PULSE_PERIOD_MAX == 0x7FFFu);
+}
+
+static void test_runs_across_the_wrap(void)
+{
+    reset();
+    assert(pulse_add_task(0, BEACON_PERIOD, counter) == 0);
+    assert(pulse_add_task(1, 7u, counter) == 0);
+    pulse_poll();
+
+    /* Past two wraps of the 16-bit counter. */
+    while (g_now < 140000u)
+    {
+        pulse_tick_isr();
+        g_now++;
+        pulse_poll();
+    }
+    assert(g_runs[0] == 141u);
+    assert(g_runs[1] == 20001u);
+    assert(pulse_get_overruns(0u) == 0u);
+    assert(pulse_get_overruns(1u) == 0u);
+}
+
+static void test_period_limits(void)
+{
+    reset();
+    assert(pulse_add_task(0, PULSE_PERIOD_MAX, counter) == 0);
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    assert(pulse_add_task(0, (uint32_t)PULSE_PERIOD_MAX + 1u, counter) == -1);
+#else
+    /* Only the scan backend takes the full range. */
+    assert(pulse_add_task(0, PULSE_TICK_MAX, counter) == 0);
+#endif
+    assert(pulse_add_task(0, (uint32_t)PULSE_TICK_MAX + 1u, counter) == -1);
+}
+
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_SCAN)
+static void test_elapsed_saturates(void)
+{
+    uint32_t t;
+
+    /* Task id 0, recorded in slot 1 so the 7-tick spacing check applies. */
+    reset();
+    assert(pulse_add_task(1, 7u, counter) == 0);
+    pulse_poll();
+
+    /* Longer than the counter can hold: pinned at the top, not wrapped. */
+    for (t = 0u; t < 70000u; t++)
+    {
+        pulse_tick_isr();
+    }
+    g_now = 70000u;
+    g_last[1] = g_now - 7u;
+    pulse_poll();
+    assert(g_runs[1] == 2u);
+    assert(pulse_get_overruns(0u) == ((PULSE_TICK_MAX - 7u) / 7u));
+}
+#endif
+
+int main(void)
+{
+    test_types_are_narrow();
+    test_runs_across_the_wrap();
+    test_period_limits();
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_SCAN)
+    test_elapsed_saturates();
+#endif
+
+    printf("All compact build tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_control.c - Hosted unit tests for suspend, resume and period change (GCC)
+ *
+ * Every task records the tick of each run, so a test can check exactly when
+ * releases resume and when a new period takes over. Built against each
+ * release backend and with SoA storage and batch dispatch by the Makefile.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PULSE_CFG_TASK_CONTROL (1u)
+#define PULSE_CFG_OVERRUN      (1u)
+#define PULSE_CFG_SPORADIC     (1u)
+#define PULSE_CFG_PRIORITY     (1u)
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (4u)
+#include "../src/pulse.h"
+
+#define MAX_RUNS (64u)
+
+static uint32_t g_now = 0u;
+static uint32_t g_run_at[PULSE_MAX_TASKS][MAX_RUNS];
+static uint32_t g_runs[PULSE_MAX_TASKS];
+static uint32_t g_stop_after = 0xFFFFFFFFu; /* task 0 suspends itself after this many runs */
+
+/* Each task's state is its id. */
+static pulse_state_t recorder(pulse_state_t s)
+{
+    assert(g_runs[s] < MAX_RUNS);
+    g_run_at[s][g_runs[s]] = g_now;
+    g_runs[s]++;
+    if ((s == 0) && (g_runs[0] == g_stop_after))
+    {
+        assert(pulse_suspend(0u) == 0);
+    }
+    return s;
+}
+
+static void reset(void)
+{
+    uint32_t i;
+
+    g_now = 0u;
+    g_stop_after = 0xFFFFFFFFu;
+    for (i = 0u; i < PULSE_MAX_TASKS; i++)
+    {
+        g_runs[i] = 0u;
+    }
+    pulse_init(1u);
+}
+
+/* Advances to tick `until`, polling after every tick. */
+static void run_to(uint32_t until)
+{
+    while (g_now < until)
+    {
+        pulse_tick_isr();
+        g_now++;
+        pulse_poll();
+    }
+}
+
+static void test_suspend_and_resume(void)
+{
+    reset();
+    assert(pulse_add_task(0, 4u, recorder) == 0);
+    assert(pulse_add_task(1, 4u, recorder) == 0);
+    pulse_poll();
+    run_to(5u);
+    assert((g_runs[0] == 2u) && (g_run_at[0][1] == 4u));
+
+    /* Suspended at 5: the releases at 8 and 12 are held as one. */
+    assert(pulse_suspend(0u) == 0);
+    run_to(14u);
+    assert(g_runs[0] == 2u);
+    assert(g_runs[1] == 4u);
+
+    /* Delivered at once, with the period restarted from there. */
+    assert(pulse_resume(0u) == 0);
+    pulse_poll();
+    assert((g_runs[0] == 3u) && (g_run_at[0][2] == 14u));
+    run_to(22u);
+    assert((g_runs[0] == 5u) && (g_run_at[0][3] == 18u) && (g_run_at[0][4] == 22u));
+
+    /* Waiting out the pause is not an overrun. */
+    assert(pulse_get_overruns(0u) == 0u);
+
+    /* A pause inside one period keeps the phase. */
+    assert(pulse_suspend(1u) == 0);
+    run_to(23u);
+    assert(pulse_resume(1u) == 0);
+    assert(pulse_resume(1u) == 0);
+    run_to(24u);
+    assert((g_runs[1] == 7u) && (g_run_at[1][6] == 24u));
+
+    assert(pulse_suspend(4u) == -1);
+    assert(pulse_resume(4u) == -1);
+}
+
+static void test_pending_release_is_held(void)
+{
+    reset();
+    assert(pulse_add_task(0, 3u, recorder) == 0);
+    assert(pulse_set_overrun_policy(0u, PULSE_OVERRUN_CATCHUP, 4u) == 0);
+    pulse_poll();
+
+    /* Released at 3 but not polled before the suspend. */
+    pulse_tick_isr();
+    pulse_tick_isr();
+    pulse_tick_isr();
+    g_now = 3u;
+    assert(pulse_suspend(0u) == 0);
+    pulse_poll();
+    assert(g_runs[0] == 1u);
+
+    run_to(20u);
+    assert(g_runs[0] == 1u);
+    assert(pulse_resume(0u) == 0);
+    pulse_poll();
+
+    /* One run, no catch-up burst, back on a 3-tick grid from 20. */
+    assert((g_runs[0] == 2u) && (g_run_at[0][1] == 20u));
+    run_to(26u);
+    assert((g_runs[0] == 4u) && (g_run_at[0][2] == 23u) && (g_run_at[0][3] == 26u));
+    assert(pulse_get_overruns(0u) == 0u);
+}
+
+static void test_task_suspends_itself(void)
+{
+    reset();
+    g_stop_after = 3u;
+    assert(pulse_add_task(0, 2u, recorder) == 0);
+    pulse_poll();
+    run_to(20u);
+    assert((g_runs[0] == 3u) && (g_run_at[0][2] == 4u));
+
+    assert(pulse_resume(0u) == 0);
+    pulse_poll();
+    assert((g_runs[0] == 4u) && (g_run_at[0][3] == 20u));
+}
+
+static void test_set_period_at_boundary(void)
+{
+    reset();
+    assert(pulse_add_task(0, 10u, recorder) == 0);
+    assert(pulse_add_task(1, 2u, recorder) == 0);
+    pulse_poll();
+    run_to(3u);
+
+    /* Faster: the release at 10 stands, then every 2 ticks. */
+    assert(pulse_set_period(0u, 2u) == 0);
+    /* Slower: the release at 4 stands, then every 10 ticks. */
+    assert(pulse_set_period(1u, 10u) == 0);
+    run_to(14u);
+    assert((g_runs[0] == 4u) && (g_run_at[0][1] == 10u) && (g_run_at[0][2] == 12u) && (g_run_at[0][3] == 14u));
+    assert((g_runs[1] == 4u) && (g_run_at[1][2] == 4u) && (g_run_at[1][3] == 14u));
+
+    /* Changed again while suspended: applies from the resumed run. */
+    assert(pulse_suspend(0u) == 0);
+    assert(pulse_set_period(0u, 5u) == 0);
+    run_to(16u);
+    assert(pulse_resume(0u) == 0);
+    pulse_poll();
+    run_to(21u);
+    assert((g_runs[0] == 6u) && (g_run_at[0][4] == 16u) && (g_run_at[0][5] == 21u));
+
+    assert(pulse_set_period(0u, 0u) == -1);
+    assert(pulse_set_period(4u, 5u) == -1);
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    assert(pulse_set_period(0u, 0x80000000u) == -1);
+#endif
+    assert(pulse_get_overruns(0u) == 0u);
+}
+
+static void test_set_period_then_late_poll(void)
+{
+    uint32_t i;
+
+    reset();
+    assert(pulse_add_task(0, 15u, recorder) == 0);
+    assert(pulse_add_task(1, 4u, recorder) == 0);
+    assert(pulse_set_overrun_policy(0u, PULSE_OVERRUN_CATCHUP, 3u) == 0);
+    assert(pulse_set_overrun_policy(1u, PULSE_OVERRUN_PHASE, 0u) == 0);
+    pulse_poll();
+    assert(pulse_set_period(0u, 7u) == 0);
+    assert(pulse_set_period(1u, 9u) == 0);
+
+    /* Not polled until 30: the releases at 15 and 4 stand, the ones missed
+     * after them follow the new periods.
+     */
+    for (i = 0u; i < 30u; i++)
+    {
+        pulse_tick_isr();
+        g_now++;
+    }
+    pulse_poll();
+    pulse_poll();
+    pulse_poll();
+    assert((g_runs[0] == 4u) && (g_run_at[0][1] == 30u) && (g_run_at[0][3] == 30u));
+    assert((g_runs[1] == 2u) && (g_run_at[1][1] == 30u));
+    assert((pulse_get_overruns(0u) == 2u) && (pulse_get_overruns(1u) == 2u));
+
+    /* Back on the new grids: 15 + 3 * 7 and 4 + 3 * 9. */
+    run_to(40u);
+    assert((g_runs[0] == 5u) && (g_run_at[0][4] == 36u));
+    assert((g_runs[1] == 4u) && (g_run_at[1][2] == 31u) && (g_run_at[1][3] == 40u));
+}
+
+static void test_sporadic_signal_held(void)
+{
+    reset();
+    assert(pulse_add_sporadic(0, 0u, recorder) == 0);
+    pulse_poll();
+
+    assert(pulse_suspend(0u) == 0);
+    assert(pulse_signal_isr(0u) == 0);
+    run_to(5u);
+    assert(g_runs[0] == 0u);
+
+    assert(pulse_resume(0u) == 0);
+    pulse_poll();
+    assert((g_runs[0] == 1u) && (g_run_at[0][0] == 5u));
+
+    /* Not signalled while suspended: nothing to deliver. */
+    assert(pulse_suspend(0u) == 0);
+    run_to(8u);
+    assert(pulse_resume(0u) == 0);
+    run_to(10u);
+    assert(g_runs[0] == 1u);
+
+    /* The guard can change too; 0 stays valid for a sporadic task. */
+    assert(pulse_set_period(0u, 3u) == 0);
+    assert(pulse_set_period(0u, 0u) == 0);
+}
+
+static void test_ids_follow_priority_moves(void)
+{
+    reset();
+    assert(pulse_add_task(0, 2u, recorder) == 0);
+    assert(pulse_add_task(1, 2u, recorder) == 0);
+    assert(pulse_add_task(2, 2u, recorder) == 0);
+
+    /* Suspended before the sort, then moved to position 0. */
+    assert(pulse_suspend(2u) == 0);
+    assert(pulse_set_period(2u, 4u) == 0);
+    assert(pulse_set_priority(2u, 0u) == 0);
+    pulse_apply_priorities();
+    pulse_poll();
+    run_to(6u);
+    assert((g_runs[0] == 4u) && (g_runs[1] == 4u) && (g_runs[2] == 0u));
+
+    /* Task 0 is suspended by id after the move; task 2's release is held. */
+    assert(pulse_suspend(0u) == 0);
+    assert(pulse_resume(2u) == 0);
+    pulse_poll();
+    run_to(14u);
+    assert(g_runs[0] == 4u);
+    assert((g_runs[2] == 3u) && (g_run_at[2][0] == 6u) && (g_run_at[2][1] == 10u) && (g_run_at[2][2] == 14u));
+}
+
+int main(void)
+{
+    test_suspend_and_resume();
+    test_pending_release_is_held();
+    test_task_suspends_itself();
+    test_set_period_at_boundary();
+    test_set_period_then_late_poll();
+    test_sporadic_signal_held();
+    test_ids_follow_priority_moves();
+
+    printf("All task control tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,259 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_coroutine.c - Hosted unit tests for coroutine tasks (GCC)
+ *
+ * Each job logs its slices with the tick they ran on, so a test can check
+ * how waits and yields pace a job and what runs between its slices. Built
+ * against each release backend and with SoA storage and batch dispatch by
+ * the Makefile.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PULSE_CFG_COROUTINES (1u)
+#define PULSE_CFG_OVERRUN    (1u)
+#define PULSE_CFG_SPORADIC   (1u)
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (4u)
+#include "../src/pulse.h"
+
+#define MAX_LOG (64u)
+
+typedef struct
+{
+    uint32_t tick;
+    uint8_t  id;
+    uint8_t  slice;
+} entry_t;
+
+static uint32_t g_now = 0u;
+static entry_t g_log[MAX_LOG];
+static uint32_t g_count = 0u;
+static pulse_kernel_t g_other;
+
+static void note(uint8_t id, uint8_t slice)
+{
+    assert(g_count < MAX_LOG);
+    g_log[g_count].tick = g_now;
+    g_log[g_count].id = id;
+    g_log[g_count].slice = slice;
+    g_count++;
+}
+
+static void expect(uint32_t n, uint32_t tick, uint8_t id, uint8_t slice)
+{
+    assert(n < g_count);
+    assert((g_log[n].tick == tick) && (g_log[n].id == id) && (g_log[n].slice == slice));
+}
+
+static void reset(void)
+{
+    g_now = 0u;
+    g_count = 0u;
+    pulse_init(1u);
+}
+
+/* Advances to tick `until`, polling after every tick. */
+static void run_to(uint32_t until)
+{
+    while (g_now < until)
+    {
+        pulse_tick_isr();
+        g_now++;
+        pulse_poll();
+    }
+}
+
+/* Three slices, 3 and then 2 ticks apart. */
+static pulse_state_t paced(pulse_state_t pc)
+{
+    PULSE_BEGIN(pc);
+    note(0u, 1u);
+    PULSE_WAIT_TICKS(pc, 3u);
+    note(0u, 2u);
+    PULSE_WAIT_TICKS(pc, 2u);
+    note(0u, 3u);
+    PULSE_END(pc);
+}
+
+/* Raises a signal as an interrupt would in the middle of the job. */
+static pulse_state_t yielding(pulse_state_t pc)
+{
+    PULSE_BEGIN(pc);
+    note(1u, 1u);
+    assert(pulse_signal_isr(0u) == 0);
+    PULSE_YIELD(pc);
+    note(1u, 2u);
+    PULSE_YIELD(pc);
+    note(1u, 3u);
+    PULSE_END(pc);
+}
+
+static pulse_state_t urgent(pulse_state_t s)
+{
+    note(0u, 0u);
+    return s;
+}
+
+/* Waits longer than its period. */
+static pulse_state_t slow(pulse_state_t pc)
+{
+    PULSE_BEGIN(pc);
+    note(0u, 1u);
+    PULSE_WAIT_TICKS(pc, 10u);
+    note(0u, 2u);
+    PULSE_END(pc);
+}
+
+/* Started by a signal; the slices are not held back by the guard. */
+static pulse_state_t on_signal(pulse_state_t pc)
+{
+    PULSE_BEGIN(pc);
+    note(0u, 1u);
+    PULSE_WAIT_TICKS(pc, 1u);
+    note(0u, 2u);
+    PULSE_END(pc);
+}
+
+static pulse_state_t limits(pulse_state_t s)
+{
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    assert(pulse_wait_ticks((uint32_t)PULSE_PERIOD_MAX + 1u) == -1);
+#endif
+    /* The other kernel has no task running. */
+    assert(pulse_kernel_wait_ticks(&g_other, 1u) == -1);
+    note(0u, 0u);
+    return s;
+}
+
+static pulse_state_t instance_job(pulse_state_t pc)
+{
+    PULSE_BEGIN(pc);
+    note(3u, 1u);
+    PULSE_KERNEL_WAIT_TICKS(&g_other, pc, 2u);
+    note(3u, 2u);
+    PULSE_END(pc);
+}
+
+static void test_slices_paced_by_wait(void)
+{
+    reset();
+    assert(pulse_add_task(0, 10u, paced) == 0);
+    pulse_poll();
+    run_to(21u);
+
+    /* The period counts from the slice that ends the job. */
+    assert(g_count == 6u);
+    expect(0u, 0u, 0u, 1u);
+    expect(1u, 3u, 0u, 2u);
+    expect(2u, 5u, 0u, 3u);
+    expect(3u, 15u, 0u, 1u);
+    expect(4u, 18u, 0u, 2u);
+    expect(5u, 20u, 0u, 3u);
+}
+
+static void test_yield_lets_urgent_work_in(void)
+{
+    reset();
+    assert(pulse_add_sporadic(0, 0u, urgent) == 0);
+    assert(pulse_add_task(0, 100u, yielding) == 0);
+    pulse_poll();
+
+    /* One poll runs the whole job; the signalled task goes between slices. */
+    assert(g_count == 4u);
+    expect(0u, 0u, 1u, 1u);
+    expect(1u, 0u, 0u, 0u);
+    expect(2u, 0u, 1u, 2u);
+    expect(3u, 0u, 1u, 3u);
+
+    run_to(100u);
+    assert(g_count == 8u);
+    expect(4u, 100u, 1u, 1u);
+    expect(5u, 100u, 0u, 0u);
+}
+
+static void test_wait_is_not_an_overrun(void)
+{
+    reset();
+    assert(pulse_add_task(0, 4u, slow) == 0);
+    assert(pulse_set_overrun_policy(0u, PULSE_OVERRUN_CATCHUP, 4u) == 0);
+    pulse_poll();
+    run_to(29u);
+
+    /* No catch-up burst after the wait, and nothing counted. */
+    assert(g_count == 5u);
+    expect(1u, 10u, 0u, 2u);
+    expect(2u, 14u, 0u, 1u);
+    expect(3u, 24u, 0u, 2u);
+    expect(4u, 28u, 0u, 1u);
+    assert(pulse_get_overruns(0u) == 0u);
+}
+
+static void test_sporadic_job(void)
+{
+    reset();
+    assert(pulse_add_sporadic(0, 5u, on_signal) == 0);
+    pulse_poll();
+    assert(pulse_signal_isr(0u) == 0);
+    pulse_poll();
+    run_to(1u);
+    assert(g_count == 2u);
+    expect(0u, 0u, 0u, 1u);
+    expect(1u, 1u, 0u, 2u);
+
+    /* Done: the guard counts from the last slice. */
+    assert(pulse_signal_isr(0u) == 0);
+    run_to(6u);
+    assert(g_count == 3u);
+    expect(2u, 6u, 0u, 1u);
+}
+
+static void test_wait_needs_a_running_task(void)
+{
+    reset();
+    pulse_kernel_init(&g_other, 1u);
+    assert(pulse_wait_ticks(0u) == -1);
+    assert(pulse_add_task(0, 5u, limits) == 0);
+    pulse_poll();
+    assert(g_count == 1u);
+    assert(pulse_wait_ticks(1u) == -1);
+}
+
+static void test_instance_kernel(void)
+{
+    uint32_t t;
+
+    reset();
+    pulse_kernel_init(&g_other, 1u);
+    assert(pulse_kernel_add_task(&g_other, 0, 8u, instance_job) == 0);
+    pulse_kernel_poll(&g_other);
+    for (t = 1u; t <= 10u; t++)
+    {
+        pulse_kernel_tick_isr(&g_other);
+        g_now = t;
+        pulse_kernel_poll(&g_other);
+    }
+    assert(g_count == 3u);
+    expect(1u, 2u, 3u, 2u);
+    expect(2u, 10u, 3u, 1u);
+}
+
+int main(void)
+{
+    test_slices_paced_by_wait();
+    test_yield_lets_urgent_work_in();
+    test_wait_is_not_an_overrun();
+    test_sporadic_job();
+    test_wait_needs_a_running_task();
+    test_instance_kernel();
+
+    printf("All coroutine tests passed.\n");
+    return 0;
+}
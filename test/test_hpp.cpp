@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_hpp.cpp - Hosted unit tests for the C++17 front end (G++)
+ *
+ * Mirrors test_static.c through pulse::Kernel, and checks the compile-time
+ * properties with static_assert.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (4u)
+#include "../src/pulse.hpp"
+
+struct exec_event_t
+{
+    std::uint32_t tick;
+    std::uint8_t  task_id;
+    pulse_state_t state;
+};
+
+static exec_event_t g_log[64];
+static std::uint32_t g_log_len = 0u;
+static std::uint32_t g_now_tick = 0u;
+
+static pulse_state_t log_exec(std::uint8_t task_id, pulse_state_t s)
+{
+    if (g_log_len < (sizeof(g_log) / sizeof(g_log[0])))
+    {
+        g_log[g_log_len].tick = g_now_tick;
+        g_log[g_log_len].task_id = task_id;
+        g_log[g_log_len].state = s;
+        g_log_len++;
+    }
+    return s + 1;
+}
+
+static pulse_state_t fast_tick(pulse_state_t s) { return log_exec(0u, s); }
+static pulse_state_t mid_tick(pulse_state_t s) { return log_exec(1u, s); }
+static pulse_state_t slow_tick(pulse_state_t s) { return log_exec(2u, s); }
+
+using App = pulse::Kernel<pulse::Task<1u, fast_tick>,
+                          pulse::Task<2u, mid_tick, 10>,
+                          pulse::Task<3u, slow_tick, 20>>;
+PULSE_HPP_KERNEL(App)
+
+static_assert(App::count == 3u, "task count");
+static_assert(App::hyperperiod == 6u, "hyperperiod of 1, 2, 3");
+static_assert(!App::harmonic, "3 does not divide 2");
+static_assert(App::id<fast_tick>() == 0u, "id of fast_tick");
+static_assert(App::id<slow_tick>() == 2u, "id of slow_tick");
+
+static_assert(pulse::Kernel<pulse::Task<10u, fast_tick>, pulse::Task<100u, mid_tick>,
+                            pulse::Task<1000u, slow_tick>>::harmonic, "10/100/1000 is harmonic");
+static_assert(pulse::Kernel<pulse::Task<0x7FFFFFFFu, fast_tick>,
+                            pulse::Task<0x7FFFFFFEu, mid_tick>>::hyperperiod ==
+              (std::uint64_t)0x7FFFFFFFu * 0x7FFFFFFEu, "hyperperiod wider than 32 bits");
+
+static void expect_event(std::uint32_t idx, std::uint32_t tick, std::uint8_t task_id, pulse_state_t state)
+{
+    assert(idx < g_log_len);
+    assert(g_log[idx].tick == tick);
+    assert(g_log[idx].task_id == task_id);
+    assert(g_log[idx].state == state);
+}
+
+static void test_runtime_lookups(void)
+{
+    assert(App::period(0u) == 1u);
+    assert(App::period(2u) == 3u);
+    assert(App::init_state(1u) == 10);
+    assert(App::dispatch(3u, 7) == 7);
+}
+
+static void test_kernel_runs_task_set(void)
+{
+    std::uint32_t i;
+
+    g_log_len = 0u;
+    g_now_tick = 0u;
+
+    App::init(1u);
+    App::poll();
+
+    assert(g_log_len == 3u);
+    expect_event(0u, 0u, 0u, 0);
+    expect_event(1u, 0u, 1u, 10);
+    expect_event(2u, 0u, 2u, 20);
+
+    for (i = 0u; i < 6u; i++)
+    {
+        g_now_tick++;
+        App::tick_isr();
+        App::poll();
+    }
+
+    assert(g_log_len == 14u);
+    expect_event(5u, 2u, 1u, 11);
+    expect_event(7u, 3u, 2u, 21);
+    expect_event(11u, 6u, 0u, 6);
+    expect_event(12u, 6u, 1u, 13);
+    expect_event(13u, 6u, 2u, 22);
+}
+
+int main(void)
+{
+    test_runtime_lookups();
+    test_kernel_runs_task_set();
+
+    std::printf("All C++ front end tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_idle.c - Hosted unit tests for the idle-sleep path (GCC)
+ *
+ * The host port counts how often the kernel enters sleep, so the tests can
+ * check that pulse_idle() never sleeps over a pending release.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PULSE_CFG_IDLE_SLEEP (1u)
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (8u)
+#include "../src/pulse.h"
+
+static uint32_t g_runs = 0u;
+
+static pulse_state_t task0(pulse_state_t s)
+{
+    (void)s;
+    g_runs++;
+    return 0;
+}
+
+static void test_sleeps_only_when_idle(void)
+{
+    pulse_port_host_sleeps = 0u;
+    g_runs = 0u;
+
+    pulse_init(1u);
+
+    assert(pulse_add_task(0, 2u, task0) == 0);
+
+    /* Released at registration and not yet run: must not sleep. */
+    pulse_idle();
+    assert(pulse_port_host_sleeps == 0u);
+
+    pulse_poll();
+    assert(g_runs == 1u);
+
+    /* Nothing ready: sleep. */
+    pulse_idle();
+    assert(pulse_port_host_sleeps == 1u);
+
+    /* The first tick only advances elapsed_ticks: still nothing ready. */
+    pulse_tick_isr();
+    pulse_idle();
+    assert(pulse_port_host_sleeps == 2u);
+
+    /* A release that lands after the poll but before the idle check keeps
+     * the CPU awake.
+     */
+    pulse_tick_isr();
+    pulse_idle();
+    assert(pulse_port_host_sleeps == 2u);
+
+    pulse_poll();
+    assert(g_runs == 2u);
+
+    pulse_idle();
+    assert(pulse_port_host_sleeps == 3u);
+}
+
+int main(void)
+{
+    test_sleeps_only_when_idle();
+
+    printf("All idle sleep tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_instance.c - Hosted unit tests for kernel instances and cross-kernel signals (GCC)
+ *
+ * Two explicit kernels model a fast control loop and slow housekeeping, or
+ * the kernels of two cores; the default kernel runs alongside them. Built
+ * against each release backend by the Makefile.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PULSE_CFG_SPORADIC    (1u)
+#define PULSE_CFG_XSIGNAL_MAX (2u)
+#define PULSE_PORT_HOST_COUNT_CRITICAL
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (8u)
+#include "../src/pulse.h"
+
+static pulse_kernel_t g_fast;
+static pulse_kernel_t g_slow;
+
+static uint32_t g_fast_runs = 0u;
+static uint32_t g_slow_runs = 0u;
+static uint32_t g_default_runs = 0u;
+static uint32_t g_worker_runs = 0u;
+static uint32_t g_handoff = 0u;
+static uint32_t g_handoff_seen = 0u;
+
+static pulse_xsignal_t g_chan;
+static pulse_xsignal_t g_chan2;
+static pulse_xsignal_t g_chan3;
+
+static pulse_state_t fast_task(pulse_state_t s)
+{
+    g_fast_runs++;
+    return s + 1;
+}
+
+static pulse_state_t slow_task(pulse_state_t s)
+{
+    g_slow_runs++;
+    return s;
+}
+
+static pulse_state_t default_task(pulse_state_t s)
+{
+    g_default_runs++;
+    return s;
+}
+
+/* Runs in g_fast; hands a value over to g_slow's worker. */
+static pulse_state_t producer_task(pulse_state_t s)
+{
+    g_handoff = (uint32_t)s;
+    pulse_xsignal_send(&g_chan);
+    return s + 1;
+}
+
+static pulse_state_t worker_task(pulse_state_t s)
+{
+    g_worker_runs++;
+    g_handoff_seen = g_handoff;
+    return s;
+}
+
+static void test_instances_are_independent(void)
+{
+    uint32_t t;
+
+    g_fast_runs = 0u;
+    g_slow_runs = 0u;
+    g_default_runs = 0u;
+
+    pulse_init(1u);
+    pulse_kernel_init(&g_fast, 1u);
+    pulse_kernel_init(&g_slow, 10u);
+
+    /* Ids are per kernel. */
+    assert(pulse_kernel_add_task(&g_fast, 0, 1u, fast_task) == 0);
+    assert(pulse_kernel_add_task(&g_slow, 0, 1u, slow_task) == 0);
+    assert(pulse_add_task(0, 5u, default_task) == 0);
+
+    pulse_kernel_start(&g_fast);
+    pulse_kernel_start(&g_slow);
+    assert(pulse_kernel_is_started(&g_fast) == 1u);
+    assert(pulse_kernel_is_started(&g_slow) == 1u);
+    assert(pulse_is_started() == 0u);
+    assert(pulse_kernel_tick_period_ms(&g_fast) == 1u);
+    assert(pulse_kernel_tick_period_ms(&g_slow) == 10u);
+
+    pulse_kernel_poll(&g_fast);
+    pulse_kernel_poll(&g_slow);
+    pulse_poll();
+
+    /* The slow timer fires once per ten fast ticks. */
+    for (t = 1u; t <= 20u; t++)
+    {
+        pulse_kernel_tick_isr(&g_fast);
+        if ((t % 10u) == 0u)
+        {
+            pulse_kernel_tick_isr(&g_slow);
+        }
+        pulse_tick_isr();
+
+        pulse_kernel_poll(&g_fast);
+        pulse_kernel_poll(&g_slow);
+        pulse_poll();
+    }
+
+    /* Initial release plus one per own tick. */
+    assert(g_fast_runs == 21u);
+    assert(g_slow_runs == 3u);
+    assert(g_default_runs == 5u);
+
+    /* Re-initialising one kernel leaves the others alone. */
+    pulse_kernel_init(&g_slow, 10u);
+    pulse_kernel_tick_isr(&g_fast);
+    pulse_kernel_tick_isr(&g_slow);
+    pulse_kernel_poll(&g_fast);
+    pulse_kernel_poll(&g_slow);
+    assert(g_fast_runs == 22u);
+    assert(g_slow_runs == 3u);
+}
+
+static void test_xsignal_hands_work_over(void)
+{
+    uint32_t before;
+
+    g_worker_runs = 0u;
+
+    pulse_kernel_init(&g_fast, 1u);
+    pulse_kernel_init(&g_slow, 1u);
+
+    assert(pulse_kernel_add_task(&g_fast, 40, 2u, producer_task) == 0);
+    assert(pulse_kernel_add_sporadic(&g_slow, 0, 0u, worker_task) == 0);
+    assert(pulse_kernel_add_task(&g_slow, 0, 100u, slow_task) == 0);
+
+    g_chan.sent = 7u;
+    assert(pulse_kernel_xsignal_attach(&g_slow, &g_chan, 0u) == 0);
+
+    /* Nothing sent yet: the receiver ignores the channel. */
+    pulse_kernel_poll(&g_slow);
+    assert(g_worker_runs == 0u);
+
+    /* Sending masks no interrupts on either side. */
+    before = pulse_port_host_critical_count;
+    pulse_xsignal_send(&g_chan);
+    assert(pulse_port_host_critical_count == before);
+
+    pulse_kernel_poll(&g_slow);
+    assert(g_worker_runs == 1u);
+    pulse_kernel_poll(&g_slow);
+    assert(g_worker_runs == 1u);
+
+    /* Signals sent before the receiver looks are merged into one run. */
+    pulse_xsignal_send(&g_chan);
+    pulse_xsignal_send(&g_chan);
+    pulse_xsignal_send(&g_chan);
+    pulse_kernel_poll(&g_slow);
+    assert(g_worker_runs == 2u);
+
+    /* Producer in g_fast, consumer in g_slow. */
+    pulse_kernel_poll(&g_fast);
+    pulse_kernel_poll(&g_slow);
+    assert(g_worker_runs == 3u);
+    assert(g_handoff_seen == 40u);
+
+    pulse_kernel_tick_isr(&g_fast);
+    pulse_kernel_tick_isr(&g_fast);
+    pulse_kernel_poll(&g_fast);
+    pulse_kernel_poll(&g_slow);
+    assert(g_worker_runs == 4u);
+    assert(g_handoff_seen == 41u);
+}
+
+static void test_xsignal_attach_api(void)
+{
+    pulse_kernel_init(&g_slow, 1u);
+
+    assert(pulse_kernel_add_sporadic(&g_slow, 0, 0u, worker_task) == 0);
+    assert(pulse_kernel_add_task(&g_slow, 0, 10u, slow_task) == 0);
+
+    assert(pulse_kernel_xsignal_attach(&g_slow, (pulse_xsignal_t *)0, 0u) == -1);
+    assert(pulse_kernel_xsignal_attach(&g_slow, &g_chan, 1u) == -1);
+    assert(pulse_kernel_xsignal_attach(&g_slow, &g_chan, 2u) == -1);
+
+    assert(pulse_kernel_xsignal_attach(&g_slow, &g_chan, 0u) == 0);
+    assert(pulse_kernel_xsignal_attach(&g_slow, &g_chan2, 0u) == 0);
+    assert(pulse_kernel_xsignal_attach(&g_slow, &g_chan3, 0u) == -3);
+
+    /* pulse_kernel_init() forgets the channels. */
+    pulse_kernel_init(&g_slow, 1u);
+    assert(pulse_kernel_add_sporadic(&g_slow, 0, 0u, worker_task) == 0);
+    assert(pulse_kernel_xsignal_attach(&g_slow, &g_chan3, 0u) == 0);
+}
+
+int main(void)
+{
+    test_instances_are_independent();
+    test_xsignal_hands_work_over();
+    test_xsignal_attach_api();
+
+    printf("All kernel instance tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_large.c - Hosted tests for task sets beyond 64 tasks (GCC)
+ *
+ * Registers 150 tasks with a spread of fast and slow periods and checks every
+ * release against a simple reference model. Built against each release
+ * backend by the Makefile.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (160u)
+#include "../src/pulse.h"
+
+#define N_TASKS (150u)
+
+static uint32_t g_now_tick = 0u;
+static uint32_t g_runs[N_TASKS];
+static uint32_t g_last_run[N_TASKS];
+static uint8_t  g_order_ok = 1u;
+static int32_t  g_prev_id = -1;
+
+/* The task id travels in the state value, so one function serves all tasks. */
+static pulse_state_t task_any(pulse_state_t s)
+{
+    const uint32_t id = (uint32_t)s;
+
+    /* Within one poll pass, lower ids must run first. */
+    if ((int32_t)id <= g_prev_id)
+    {
+        g_order_ok = 0u;
+    }
+    g_prev_id = (int32_t)id;
+
+    g_runs[id]++;
+    g_last_run[id] = g_now_tick;
+    return s;
+}
+
+static uint32_t period_of(uint32_t id)
+{
+    /* A few fast tasks, many slow ones, some longer than small wheel spans. */
+    if (id < 10u)
+    {
+        return id + 1u;
+    }
+    return 10u * ((id * 37u) % 500u + 1u);
+}
+
+static void poll_pass(void)
+{
+    g_prev_id = -1;
+    pulse_poll();
+}
+
+static void test_150_tasks_release_on_time(void)
+{
+    const uint32_t end_tick = 20000u;
+    uint32_t i;
+
+    pulse_init(1u);
+
+    for (i = 0u; i < N_TASKS; i++)
+    {
+        g_runs[i] = 0u;
+        g_last_run[i] = 0u;
+        assert(pulse_add_task((pulse_state_t)i, period_of(i), task_any) == 0);
+    }
+
+    /* Every task is released immediately at registration. */
+    poll_pass();
+
+    for (i = 0u; i < end_tick; i++)
+    {
+        g_now_tick = i + 1u;
+        pulse_tick_isr();
+        poll_pass();
+    }
+
+    assert(g_order_ok != 0u);
+
+    for (i = 0u; i < N_TASKS; i++)
+    {
+        const uint32_t p = period_of(i);
+        assert(g_runs[i] == (end_tick / p) + 1u);
+        assert(g_last_run[i] == (end_tick / p) * p);
+    }
+}
+
+static void test_capacity_limit(void)
+{
+    uint32_t i;
+
+    pulse_init(1u);
+
+    for (i = 0u; i < PULSE_MAX_TASKS; i++)
+    {
+        assert(pulse_add_task(0, 100u, task_any) == 0);
+    }
+    assert(pulse_add_task(0, 100u, task_any) == -3);
+}
+
+int main(void)
+{
+    test_150_tasks_release_on_time();
+    test_capacity_limit();
+
+    printf("All large task set tests passed.\n");
+    return 0;
+}
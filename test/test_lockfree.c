@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_lockfree.c - Hosted unit tests for lock-free ready-set publication (GCC)
+ *
+ * The host port counts critical sections, so these tests check that ticks
+ * and polls mask nothing once tasks are registered, and that releases made
+ * by a tick that lands while a task runs are neither lost nor doubled.
+ * Built with batch dispatch and with SoA storage by the Makefile.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PULSE_CFG_LOCK_FREE (1u)
+#define PULSE_PORT_HOST_COUNT_CRITICAL
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (8u)
+#include "../src/pulse.h"
+
+static uint32_t g_now = 0u;
+static uint32_t g_runs[PULSE_MAX_TASKS];
+static uint32_t g_last[PULSE_MAX_TASKS];
+static uint8_t  g_nest = 0u;
+
+/* Each task's state is its id. */
+static pulse_state_t recorder(pulse_state_t s)
+{
+    const uint8_t id = (uint8_t)s;
+
+    /* Claimed: out of the ready set and marked running. */
+    assert(pulse_ready_test(&pulse_kernel, id) == 0u);
+    assert(pulse_running_test(&pulse_kernel, id) != 0u);
+    g_last[id] = g_now;
+    g_runs[id]++;
+    return s;
+}
+
+/* Takes a tick in the middle of its run, as the timer interrupt would. */
+static pulse_state_t interrupted(pulse_state_t s)
+{
+    if (g_nest != 0u)
+    {
+        g_nest = 0u;
+        g_now++;
+        pulse_tick_isr();
+    }
+    return recorder(s);
+}
+
+static void reset(void)
+{
+    uint32_t i;
+
+    g_now = 0u;
+    g_nest = 0u;
+    for (i = 0u; i < PULSE_MAX_TASKS; i++)
+    {
+        g_runs[i] = 0u;
+    }
+    pulse_init(1u);
+}
+
+/* Advances to tick `until`, polling after every tick. */
+static void run_to(uint32_t until)
+{
+    while (g_now < until)
+    {
+        g_now++;
+        pulse_tick_isr();
+        pulse_poll();
+    }
+}
+
+static void test_no_critical_sections(void)
+{
+    reset();
+    assert(pulse_add_task(0, 1u, recorder) == 0);
+    assert(pulse_add_task(1, 2u, recorder) == 0);
+    assert(pulse_add_task(2, 3u, recorder) == 0);
+
+    pulse_port_host_critical_count = 0u;
+    pulse_poll();
+    run_to(12u);
+    assert((g_runs[0] == 13u) && (g_runs[1] == 7u) && (g_runs[2] == 5u));
+    assert(pulse_port_host_critical_count == 0u);
+}
+
+static void test_bounded_poll_counts_the_rest(void)
+{
+    reset();
+    assert(pulse_add_task(0, 4u, recorder) == 0);
+    assert(pulse_add_task(1, 4u, recorder) == 0);
+    assert(pulse_add_task(2, 4u, recorder) == 0);
+
+    pulse_port_host_critical_count = 0u;
+    assert(pulse_poll_bounded(1u) == 2u);
+    assert(g_runs[0] == 1u);
+    assert(pulse_poll_bounded(4u) == 0u);
+    assert((g_runs[1] == 1u) && (g_runs[2] == 1u));
+    assert(pulse_port_host_critical_count == 0u);
+}
+
+static void test_tick_during_a_run(void)
+{
+    reset();
+    assert(pulse_add_task(0, 1u, interrupted) == 0);
+    assert(pulse_add_task(1, 3u, recorder) == 0);
+    pulse_poll();
+    run_to(1u);
+    assert((g_runs[0] == 2u) && (g_runs[1] == 1u));
+
+    /* Task 0 is released at 2 and the tick to 3 arrives while it runs. */
+    g_now++;
+    pulse_tick_isr();
+    g_nest = 1u;
+    pulse_poll();
+
+    /* Task 1's release from that tick is kept; task 0 is not run twice. */
+    assert((g_runs[0] == 3u) && (g_last[0] == 3u));
+    assert((g_runs[1] == 2u) && (g_last[1] == 3u));
+    assert(pulse_ready_any(&pulse_kernel) == 0u);
+
+    /* Task 0's next release comes from the following tick. */
+    run_to(4u);
+    assert((g_runs[0] == 4u) && (g_last[0] == 4u));
+}
+
+int main(void)
+{
+    test_no_critical_sections();
+    test_bounded_poll_counts_the_rest();
+    test_tick_during_a_run();
+
+    printf("All lock-free tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_modes.c - Hosted unit tests for mode tables (GCC)
+ *
+ * Every task records the tick of each run, so a test can check on which tick
+ * a switch took effect and how each task came through it. Built against each
+ * release backend and with SoA storage and batch dispatch by the Makefile.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PULSE_CFG_TASK_CONTROL (1u)
+#define PULSE_CFG_MODES        (1u)
+#define PULSE_CFG_OVERRUN      (1u)
+#define PULSE_CFG_SPORADIC     (1u)
+#define PULSE_CFG_PRIORITY     (1u)
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (4u)
+#include "../src/pulse.h"
+
+#define MAX_RUNS (64u)
+
+static uint32_t g_now = 0u;
+static uint32_t g_run_at[PULSE_MAX_TASKS][MAX_RUNS];
+static uint32_t g_runs[PULSE_MAX_TASKS];
+
+static const uint32_t safe_periods[] = { 10u };
+static const uint32_t science_periods[] = { PULSE_MODE_KEEP, 3u, PULSE_MODE_OFF };
+static const uint32_t downlink_periods[] = { PULSE_MODE_OFF, 4u, 2u };
+
+static const pulse_mode_t safe = { safe_periods, 1u };
+static const pulse_mode_t science = { science_periods, 3u };
+static const pulse_mode_t downlink = { downlink_periods, 3u };
+
+/* Each task's state is its id. */
+static pulse_state_t recorder(pulse_state_t s)
+{
+    assert(g_runs[s] < MAX_RUNS);
+    g_run_at[s][g_runs[s]] = g_now;
+    g_runs[s]++;
+    return s;
+}
+
+static void reset(void)
+{
+    uint32_t i;
+
+    g_now = 0u;
+    for (i = 0u; i < PULSE_MAX_TASKS; i++)
+    {
+        g_runs[i] = 0u;
+    }
+    pulse_init(1u);
+}
+
+/* Advances to tick `until`, polling after every tick. */
+static void run_to(uint32_t until)
+{
+    while (g_now < until)
+    {
+        pulse_tick_isr();
+        g_now++;
+        pulse_poll();
+    }
+}
+
+static void test_switch_at_tick(void)
+{
+    reset();
+    assert(pulse_add_task(0, 5u, recorder) == 0);
+    assert(pulse_add_task(1, 5u, recorder) == 0);
+    assert(pulse_add_task(2, 5u, recorder) == 0);
+    pulse_poll();
+    run_to(2u);
+    assert(pulse_get_mode() == (const pulse_mode_t *)0);
+
+    /* Requested at 2, taken by the tick to 3. */
+    assert(pulse_set_mode(&safe) == 0);
+    assert(pulse_get_mode() == (const pulse_mode_t *)0);
+    run_to(3u);
+    assert(pulse_get_mode() == &safe);
+
+    /* Task 0 keeps its release at 5, then runs every 10; the rest stop. */
+    run_to(20u);
+    assert((g_runs[0] == 3u) && (g_run_at[0][1] == 5u) && (g_run_at[0][2] == 15u));
+    assert((g_runs[1] == 1u) && (g_runs[2] == 1u));
+
+    /* Task 1 enters and runs on the switch tick; task 0 keeps its period. */
+    assert(pulse_set_mode(&science) == 0);
+    run_to(28u);
+    assert((g_runs[1] == 4u) && (g_run_at[1][1] == 21u) && (g_run_at[1][2] == 24u) && (g_run_at[1][3] == 27u));
+    assert((g_runs[0] == 4u) && (g_run_at[0][3] == 25u));
+    assert(g_runs[2] == 1u);
+
+    /* Entering and leaving are not overruns. */
+    assert(pulse_get_overruns(0u) == 0u);
+    assert(pulse_get_overruns(1u) == 0u);
+    assert(pulse_get_overruns(2u) == 0u);
+}
+
+static void test_pending_release_dropped(void)
+{
+    reset();
+    assert(pulse_add_task(0, 5u, recorder) == 0);
+    assert(pulse_add_task(1, 2u, recorder) == 0);
+    assert(pulse_set_overrun_policy(1u, PULSE_OVERRUN_CATCHUP, 4u) == 0);
+    pulse_poll();
+
+    /* Task 1 is released at 2 but not polled before it leaves at 3. */
+    pulse_tick_isr();
+    pulse_tick_isr();
+    assert(pulse_set_mode(&safe) == 0);
+    pulse_tick_isr();
+    g_now = 3u;
+    pulse_poll();
+    assert(g_runs[1] == 1u);
+    run_to(20u);
+    assert(g_runs[1] == 1u);
+    assert((g_runs[0] == 3u) && (g_run_at[0][1] == 5u) && (g_run_at[0][2] == 15u));
+
+    /* Back as new: one run on the switch tick, no catch-up, no overruns. */
+    assert(pulse_set_mode(&downlink) == 0);
+    run_to(26u);
+    assert((g_runs[1] == 3u) && (g_run_at[1][1] == 21u) && (g_run_at[1][2] == 25u));
+    assert(pulse_get_overruns(1u) == 0u);
+
+    /* Task 0 left on the same tick, before its release at 25. */
+    assert(g_runs[0] == 3u);
+}
+
+static void test_last_request_wins(void)
+{
+    reset();
+    assert(pulse_add_task(0, 4u, recorder) == 0);
+    assert(pulse_add_task(1, 4u, recorder) == 0);
+    assert(pulse_add_task(2, 4u, recorder) == 0);
+    pulse_poll();
+
+    assert(pulse_set_mode(&safe) == 0);
+    assert(pulse_set_mode(&downlink) == 0);
+    run_to(1u);
+    assert(pulse_get_mode() == &downlink);
+
+    /* Task 2 was active all along: it keeps its phase and takes period 2
+     * after the release at 4.
+     */
+    run_to(8u);
+    assert(g_runs[0] == 1u);
+    assert((g_runs[2] == 4u) && (g_run_at[2][1] == 4u) && (g_run_at[2][2] == 6u) && (g_run_at[2][3] == 8u));
+
+    /* A user suspend is overridden by the next switch. */
+    assert(pulse_suspend(2u) == 0);
+    run_to(12u);
+    assert(g_runs[2] == 4u);
+    assert(pulse_set_mode(&downlink) == 0);
+    run_to(13u);
+    assert((g_runs[2] == 5u) && (g_run_at[2][4] == 13u));
+
+    /* Bad requests leave the pending one alone. */
+    assert(pulse_set_mode(&safe) == 0);
+    {
+        static const uint32_t too_long[PULSE_MAX_TASKS + 1u] = { 1u, 1u, 1u, 1u, 1u };
+        const pulse_mode_t long_mode = { too_long, (uint8_t)(PULSE_MAX_TASKS + 1u) };
+        const pulse_mode_t no_table = { (const uint32_t *)0, 2u };
+
+        assert(pulse_set_mode((const pulse_mode_t *)0) == -1);
+        assert(pulse_set_mode(&long_mode) == -1);
+        assert(pulse_set_mode(&no_table) == -1);
+    }
+#if (PULSE_CFG_RELEASE_BACKEND != PULSE_RELEASE_SCAN)
+    {
+        static const uint32_t too_slow[] = { 0x80000000u };
+        const pulse_mode_t slow_mode = { too_slow, 1u };
+
+        assert(pulse_set_mode(&slow_mode) == -1);
+    }
+#endif
+    run_to(14u);
+    assert(pulse_get_mode() == &safe);
+}
+
+static void test_sporadic_in_mode(void)
+{
+    static const uint32_t listen_periods[] = { PULSE_MODE_KEEP };
+    static const pulse_mode_t listen = { listen_periods, 1u };
+    static const pulse_mode_t quiet = { (const uint32_t *)0, 0u };
+
+    reset();
+    assert(pulse_add_sporadic(0, 0u, recorder) == 0);
+    pulse_poll();
+
+    assert(pulse_set_mode(&listen) == 0);
+    run_to(1u);
+    assert(pulse_signal_isr(0u) == 0);
+    pulse_poll();
+    assert((g_runs[0] == 1u) && (g_run_at[0][0] == 1u));
+
+    /* A signal while inactive is not carried into the next mode. */
+    assert(pulse_set_mode(&quiet) == 0);
+    run_to(2u);
+    assert(pulse_signal_isr(0u) == 0);
+    run_to(5u);
+    assert(pulse_set_mode(&listen) == 0);
+    run_to(8u);
+    assert(g_runs[0] == 1u);
+
+    assert(pulse_signal_isr(0u) == 0);
+    pulse_poll();
+    assert((g_runs[0] == 2u) && (g_run_at[0][1] == 8u));
+}
+
+static void test_ids_follow_priority_moves(void)
+{
+    static const uint32_t only_two[] = { PULSE_MODE_OFF, PULSE_MODE_OFF, 3u };
+    static const pulse_mode_t two = { only_two, 3u };
+
+    reset();
+    assert(pulse_add_task(0, 2u, recorder) == 0);
+    assert(pulse_add_task(1, 2u, recorder) == 0);
+    assert(pulse_add_task(2, 2u, recorder) == 0);
+    assert(pulse_set_priority(2u, 0u) == 0);
+    pulse_apply_priorities();
+    pulse_poll();
+
+    /* Table entries are ids, wherever the task sits in the ready set. */
+    assert(pulse_set_mode(&two) == 0);
+    run_to(9u);
+    assert((g_runs[0] == 1u) && (g_runs[1] == 1u));
+    assert((g_runs[2] == 4u) && (g_run_at[2][1] == 2u) && (g_run_at[2][2] == 5u) && (g_run_at[2][3] == 8u));
+}
+
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+static void test_inactive_tasks_leave_the_queue(void)
+{
+    static pulse_kernel_t k;
+
+    pulse_kernel_init(&k, 1u);
+    assert(pulse_kernel_add_task(&k, 0, 5u, recorder) == 0);
+    assert(pulse_kernel_add_task(&k, 1, 7u, recorder) == 0);
+    assert(pulse_kernel_add_task(&k, 2, 9u, recorder) == 0);
+    pulse_kernel_poll(&k);
+    assert(k.release_count == 3u);
+
+    assert(pulse_kernel_set_mode(&k, &safe) == 0);
+    pulse_kernel_tick_isr(&k);
+    assert(k.release_count == 1u);
+    assert(pulse_kernel_get_mode(&k) == &safe);
+}
+#endif
+
+int main(void)
+{
+    test_switch_at_tick();
+    test_pending_release_dropped();
+    test_last_request_wins();
+    test_sporadic_in_mode();
+    test_ids_follow_priority_moves();
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+    test_inactive_tasks_leave_the_queue();
+#endif
+
+    printf("All mode tests passed.\n");
+    return 0;
+}
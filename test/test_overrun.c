@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_overrun.c - Hosted unit tests for overrun counting and policies (GCC)
+ *
+ * Each test registers one period-3 task, stalls the main loop for 10 ticks
+ * and checks what the policy does with the two releases missed at ticks 6
+ * and 9. Built against each release backend by the Makefile.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PULSE_CFG_OVERRUN (1u)
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (8u)
+#include "../src/pulse.h"
+
+static uint32_t g_runs[32];
+static uint32_t g_run_len = 0u;
+static uint32_t g_now_tick = 0u;
+
+static pulse_state_t task0(pulse_state_t s)
+{
+    if (g_run_len < (uint32_t)(sizeof(g_runs) / sizeof(g_runs[0])))
+    {
+        g_runs[g_run_len] = g_now_tick;
+        g_run_len++;
+    }
+    return s;
+}
+
+static void tick(void)
+{
+    g_now_tick++;
+    pulse_tick_isr();
+}
+
+static void setup(uint8_t policy, uint8_t catchup_max)
+{
+    uint32_t i;
+
+    g_run_len = 0u;
+    g_now_tick = 0u;
+
+    pulse_init(1u);
+    assert(pulse_add_task(0, 3u, task0) == 0);
+    assert(pulse_set_overrun_policy(0u, policy, catchup_max) == 0);
+
+    /* Regular run at tick 0, then the main loop stalls until tick 10. */
+    pulse_poll();
+    for (i = 0u; i < 10u; i++)
+    {
+        tick();
+    }
+    pulse_poll();
+}
+
+static void run_to(uint32_t end_tick)
+{
+    while (g_now_tick < end_tick)
+    {
+        tick();
+        pulse_poll();
+    }
+}
+
+static void test_skip_restarts_period(void)
+{
+    setup(PULSE_OVERRUN_SKIP, 0u);
+
+    assert(g_run_len == 2u);
+    assert(g_runs[1] == 10u);
+    assert(pulse_get_overruns(0u) == 2u);
+
+    /* Next period counts from the late dispatch. */
+    run_to(16u);
+    assert(g_run_len == 4u);
+    assert(g_runs[2] == 13u);
+    assert(g_runs[3] == 16u);
+    assert(pulse_get_overruns(0u) == 2u);
+}
+
+static void test_phase_keeps_grid(void)
+{
+    setup(PULSE_OVERRUN_PHASE, 0u);
+
+    assert(g_run_len == 2u);
+    assert(g_runs[1] == 10u);
+    assert(pulse_get_overruns(0u) == 2u);
+
+    /* Back on the 0, 3, 6, ... grid. */
+    run_to(15u);
+    assert(g_run_len == 4u);
+    assert(g_runs[2] == 12u);
+    assert(g_runs[3] == 15u);
+}
+
+static void test_catchup_is_capped(void)
+{
+    setup(PULSE_OVERRUN_CATCHUP, 1u);
+
+    /* One of the two missed releases is made up, back-to-back. */
+    assert(g_run_len == 3u);
+    assert(g_runs[1] == 10u);
+    assert(g_runs[2] == 10u);
+    assert(pulse_get_overruns(0u) == 2u);
+
+    run_to(12u);
+    assert(g_run_len == 4u);
+    assert(g_runs[3] == 12u);
+}
+
+static void test_catchup_runs_all_missed(void)
+{
+    setup(PULSE_OVERRUN_CATCHUP, 8u);
+
+    assert(g_run_len == 4u);
+    assert(g_runs[3] == 10u);
+
+    run_to(15u);
+    assert(g_run_len == 6u);
+    assert(g_runs[4] == 12u);
+    assert(g_runs[5] == 15u);
+    assert(pulse_get_overruns(0u) == 2u);
+}
+
+static void test_on_time_runs_count_nothing(void)
+{
+    g_run_len = 0u;
+    g_now_tick = 0u;
+
+    pulse_init(1u);
+    assert(pulse_add_task(0, 2u, task0) == 0);
+    assert(pulse_set_overrun_policy(0u, PULSE_OVERRUN_CATCHUP, 4u) == 0);
+
+    pulse_poll();
+    run_to(20u);
+
+    assert(g_run_len == 11u);
+    assert(pulse_get_overruns(0u) == 0u);
+}
+
+static void test_policy_api(void)
+{
+    pulse_init(1u);
+    assert(pulse_add_task(0, 2u, task0) == 0);
+
+    assert(pulse_set_overrun_policy(1u, PULSE_OVERRUN_SKIP, 0u) == -1);
+    assert(pulse_set_overrun_policy(0u, 3u, 0u) == -1);
+    assert(pulse_get_overruns(1u) == 0u);
+}
+
+int main(void)
+{
+    test_skip_restarts_period();
+    test_phase_keeps_grid();
+    test_catchup_is_capped();
+    test_catchup_runs_all_missed();
+    test_on_time_runs_count_nothing();
+    test_policy_api();
+
+    printf("All overrun tests passed.\n");
+    return 0;
+}
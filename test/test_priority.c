@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_priority.c - Hosted unit tests for explicit and rate-monotonic priorities (GCC)
+ *
+ * Tasks log their ids as they run, so each test can check dispatch order
+ * after registration order and priority order have been pulled apart.
+ * Built against each release backend and with SoA storage by the Makefile.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PULSE_CFG_PRIORITY (1u)
+#define PULSE_CFG_AUTO_RM  (1u)
+#define PULSE_CFG_SPORADIC (1u)
+#define PULSE_CFG_OVERRUN  (1u)
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (12u)
+#include "../src/pulse.h"
+
+static uint8_t g_log[256];
+static uint32_t g_log_len = 0u;
+static uint32_t g_runs[4];
+
+/* Each task's state is its id. */
+static pulse_state_t logger(pulse_state_t s)
+{
+    assert(g_log_len < sizeof(g_log));
+    g_log[g_log_len] = (uint8_t)s;
+    g_log_len++;
+    g_runs[s]++;
+    return s;
+}
+
+static void reset_log(void)
+{
+    uint32_t i;
+
+    g_log_len = 0u;
+    for (i = 0u; i < 4u; i++)
+    {
+        g_runs[i] = 0u;
+    }
+}
+
+static void test_explicit_priority(void)
+{
+    uint32_t t;
+
+    reset_log();
+    pulse_init(1u);
+
+    assert(pulse_add_task(0, 10u, logger) == 0);
+    assert(pulse_add_task(1, 10u, logger) == 0);
+    assert(pulse_add_task(2, 10u, logger) == 0);
+
+    assert(pulse_set_priority(2u, 0u) == 0);
+    assert(pulse_set_priority(3u, 0u) == -1);
+
+    pulse_apply_priorities();
+    pulse_poll();
+
+    assert(g_log_len == 3u);
+    assert((g_log[0] == 2u) && (g_log[1] == 0u) && (g_log[2] == 1u));
+
+    /* Priorities can be changed and applied again between polls. */
+    assert(pulse_set_priority(0u, 200u) == 0);
+    pulse_apply_priorities();
+    reset_log();
+    for (t = 0u; t < 10u; t++)
+    {
+        pulse_tick_isr();
+    }
+    pulse_poll();
+    assert(g_log_len == 3u);
+    assert((g_log[0] == 2u) && (g_log[1] == 1u) && (g_log[2] == 0u));
+}
+
+static void test_rate_monotonic_at_start(void)
+{
+    static pulse_kernel_t k;
+    uint32_t t;
+
+    reset_log();
+    pulse_kernel_init(&k, 1u);
+
+    assert(pulse_kernel_add_task(&k, 0, 100u, logger) == 0);
+    assert(pulse_kernel_add_task(&k, 1, 10u, logger) == 0);
+    assert(pulse_kernel_add_task(&k, 2, 50u, logger) == 0);
+    assert(pulse_kernel_add_task(&k, 3, 10u, logger) == 0);
+
+    /* Starting sorts by period; equal periods keep registration order. */
+    pulse_kernel_start(&k);
+    pulse_kernel_poll(&k);
+    assert(g_log_len == 4u);
+    assert((g_log[0] == 1u) && (g_log[1] == 3u) && (g_log[2] == 2u) && (g_log[3] == 0u));
+
+    /* Every task keeps its own period after the move. */
+    reset_log();
+    for (t = 0u; t < 1000u; t++)
+    {
+        pulse_kernel_tick_isr(&k);
+        pulse_kernel_poll(&k);
+    }
+    assert(g_runs[0] == 10u);
+    assert(g_runs[1] == 100u);
+    assert(g_runs[2] == 20u);
+    assert(g_runs[3] == 100u);
+
+    /* Tick 1000 released all four: shortest period first. */
+    assert((g_log[g_log_len - 4u] == 1u) && (g_log[g_log_len - 3u] == 3u));
+    assert((g_log[g_log_len - 2u] == 2u) && (g_log[g_log_len - 1u] == 0u));
+}
+
+static void test_explicit_priority_beats_period(void)
+{
+    static pulse_kernel_t k;
+
+    reset_log();
+    pulse_kernel_init(&k, 1u);
+
+    assert(pulse_kernel_add_task(&k, 0, 1000u, logger) == 0);
+    assert(pulse_kernel_add_task(&k, 1, 5u, logger) == 0);
+    assert(pulse_kernel_add_task(&k, 2, 20u, logger) == 0);
+
+    assert(pulse_kernel_set_priority(&k, 0u, 1u) == 0);
+    pulse_kernel_start(&k);
+    pulse_kernel_poll(&k);
+
+    assert(g_log_len == 3u);
+    assert((g_log[0] == 0u) && (g_log[1] == 1u) && (g_log[2] == 2u));
+}
+
+static void test_id_api_after_remap(void)
+{
+    static pulse_kernel_t k;
+    uint32_t t;
+
+    reset_log();
+    pulse_kernel_init(&k, 1u);
+
+    /* Id 0 ends up last, id 2 first. */
+    assert(pulse_kernel_add_sporadic(&k, 0, 0u, logger) == 0);
+    assert(pulse_kernel_add_task(&k, 1, 50u, logger) == 0);
+    assert(pulse_kernel_add_task(&k, 2, 1u, logger) == 0);
+    assert(pulse_kernel_set_priority(&k, 0u, 255u) == 0);
+    assert(pulse_kernel_set_overrun_policy(&k, 2u, PULSE_OVERRUN_SKIP, 0u) == 0);
+
+    pulse_kernel_start(&k);
+    pulse_kernel_poll(&k);
+    assert(g_log_len == 2u);
+    assert((g_log[0] == 2u) && (g_log[1] == 1u));
+
+    /* Ids still name the same tasks. */
+    assert(pulse_kernel_signal_isr(&k, 1u) == -1);
+    assert(pulse_kernel_signal_isr(&k, 0u) == 0);
+    pulse_kernel_tick_isr(&k);
+    pulse_kernel_poll(&k);
+    assert(g_log_len == 4u);
+    assert((g_log[2] == 2u) && (g_log[3] == 0u));
+
+    for (t = 0u; t < 3u; t++)
+    {
+        pulse_kernel_tick_isr(&k);
+    }
+    pulse_kernel_poll(&k);
+    assert(pulse_kernel_get_overruns(&k, 2u) != 0u);
+    assert(pulse_kernel_get_overruns(&k, 1u) == 0u);
+    assert(pulse_kernel_get_overruns(&k, 0u) == 0u);
+
+    /* Added after the sort: lowest until sorted again. */
+    assert(pulse_kernel_add_task(&k, 3, 1u, logger) == 0);
+    reset_log();
+    assert(pulse_kernel_signal_isr(&k, 0u) == 0);
+    pulse_kernel_tick_isr(&k);
+    pulse_kernel_poll(&k);
+    assert(g_log_len == 3u);
+    assert((g_log[0] == 2u) && (g_log[1] == 0u) && (g_log[2] == 3u));
+
+    pulse_kernel_apply_priorities(&k);
+    assert(pulse_kernel_signal_isr(&k, 0u) == 0);
+    assert(pulse_kernel_signal_isr(&k, 3u) == -1);
+    pulse_kernel_tick_isr(&k);
+    pulse_kernel_poll(&k);
+    assert(g_log_len == 6u);
+    assert((g_log[3] == 2u) && (g_log[4] == 3u) && (g_log[5] == 0u));
+}
+
+int main(void)
+{
+    test_explicit_priority();
+    test_rate_monotonic_at_start();
+    test_explicit_priority_beats_period();
+    test_id_api_after_remap();
+
+    printf("All priority tests passed.\n");
+    return 0;
+}
@@ -144,11 +144,68 @@ static void test_three_tasks_staggered(void)
     expect_event(5u, 5u, 1u);
 }
 
+static void test_late_poll_keeps_release(void)
+{
+    uint32_t i;
+
+    reset_log();
+
+    pulse_init(1u);
+
+    assert(pulse_add_task(0, 3u, task0) == 0);
+
+    pulse_poll();
+    assert(g_log_len == 1u);
+
+    /* Main loop stalls for 10 ticks: the release is held, not lost, and the
+     * task runs exactly once when polling resumes.
+     */
+    for (i = 0u; i < 10u; i++)
+    {
+        g_now_tick = i + 1u;
+        pulse_tick_isr();
+    }
+
+    pulse_poll();
+    assert(g_log_len == 2u);
+    expect_event(1u, 10u, 0u);
+
+    /* The next period counts from the late dispatch. */
+    for (i = 10u; i < 13u; i++)
+    {
+        g_now_tick = i + 1u;
+        pulse_tick_isr();
+        pulse_poll();
+    }
+
+    assert(g_log_len == 3u);
+    expect_event(2u, 13u, 0u);
+}
+
+static void test_tick_length(void)
+{
+    pulse_init_us(250u);
+    assert(pulse_tick_period_us() == 250u);
+    assert(pulse_tick_period_ms() == 0u);
+
+    pulse_init(10u);
+    assert(pulse_tick_period_us() == 10000u);
+    assert(pulse_tick_period_ms() == 10u);
+
+    /* 0 selects the 1 ms default; milliseconds saturate in microseconds. */
+    pulse_init(0u);
+    assert(pulse_tick_period_us() == 1000u);
+    pulse_init(5000000u);
+    assert(pulse_tick_period_us() == 0xFFFFFFFFu);
+}
+
 int main(void)
 {
     test_same_tick_priority_order();
     test_period_timing();
     test_three_tasks_staggered();
+    test_late_poll_keeps_release();
+    test_tick_length();
 
     printf("All Pulse tests passed.\n");
     return 0;
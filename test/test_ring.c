@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_ring.c - Hosted unit tests for the SPSC slot ring (GCC)
+ *
+ * The last test plays the radio ISR from the tick handler and drains frames
+ * in a Pulse task. The Makefile also builds it with a 32-bit index.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (8u)
+#include "../src/pulse.h"
+#include "../src/pulse_ring.h"
+
+typedef struct
+{
+    uint32_t seq;
+    uint8_t  payload[60];
+} frame_t;
+
+static frame_t g_slots[8];
+static pulse_ring_t g_ring;
+
+static void test_init_rejects_bad_capacity(void)
+{
+    assert(pulse_ring_init(&g_ring, g_slots, sizeof(frame_t), 0u) == -1);
+    assert(pulse_ring_init(&g_ring, g_slots, sizeof(frame_t), 6u) == -1);
+    assert(pulse_ring_init(&g_ring, g_slots, sizeof(frame_t), PULSE_RING_MAX_CAPACITY * 2u) == -1);
+    assert(pulse_ring_init(&g_ring, (void *)0, sizeof(frame_t), 8u) == -1);
+    assert(pulse_ring_init(&g_ring, g_slots, 0u, 8u) == -1);
+
+    assert(pulse_ring_init(&g_ring, g_slots, sizeof(frame_t), 8u) == 0);
+    assert(pulse_ring_capacity(&g_ring) == 8u);
+    assert(pulse_ring_count(&g_ring) == 0u);
+    assert(pulse_ring_empty(&g_ring));
+    assert(pulse_ring_peek(&g_ring) == (void *)0);
+}
+
+static void test_slots_are_used_in_place(void)
+{
+    frame_t *w;
+    frame_t *r;
+
+    assert(pulse_ring_init(&g_ring, g_slots, sizeof(frame_t), 8u) == 0);
+
+    /* A reserved slot is the storage itself and stays hidden until commit. */
+    w = (frame_t *)pulse_ring_reserve(&g_ring);
+    assert(w == &g_slots[0]);
+    assert(pulse_ring_reserve(&g_ring) == (void *)w);
+    w->seq = 7u;
+    assert(pulse_ring_peek(&g_ring) == (void *)0);
+
+    pulse_ring_commit(&g_ring);
+    assert(pulse_ring_count(&g_ring) == 1u);
+
+    r = (frame_t *)pulse_ring_peek(&g_ring);
+    assert(r == w);
+    assert(pulse_ring_peek(&g_ring) == (void *)r);
+    assert(r->seq == 7u);
+
+    pulse_ring_release(&g_ring);
+    assert(pulse_ring_empty(&g_ring));
+    assert(pulse_ring_reserve(&g_ring) == (void *)&g_slots[1]);
+}
+
+static void test_every_slot_is_usable(void)
+{
+    uint32_t i;
+    frame_t *f;
+
+    assert(pulse_ring_init(&g_ring, g_slots, sizeof(frame_t), 8u) == 0);
+
+    for (i = 0u; i < 8u; i++)
+    {
+        f = (frame_t *)pulse_ring_reserve(&g_ring);
+        assert(f != (frame_t *)0);
+        f->seq = i;
+        pulse_ring_commit(&g_ring);
+    }
+    assert(pulse_ring_full(&g_ring));
+    assert(pulse_ring_reserve(&g_ring) == (void *)0);
+
+    /* Freeing one slot makes exactly one available again. */
+    f = (frame_t *)pulse_ring_peek(&g_ring);
+    assert(f->seq == 0u);
+    pulse_ring_release(&g_ring);
+    assert(pulse_ring_reserve(&g_ring) == (void *)&g_slots[0]);
+    pulse_ring_commit(&g_ring);
+    assert(pulse_ring_reserve(&g_ring) == (void *)0);
+
+    for (i = 1u; i < 8u; i++)
+    {
+        f = (frame_t *)pulse_ring_peek(&g_ring);
+        assert(f->seq == i);
+        pulse_ring_release(&g_ring);
+    }
+    assert(pulse_ring_count(&g_ring) == 1u);
+}
+
+static void test_indices_wrap(void)
+{
+    uint32_t i;
+    frame_t *f;
+
+    assert(pulse_ring_init(&g_ring, g_slots, sizeof(frame_t), 8u) == 0);
+
+    /* Start just below the top of the index range. */
+    g_ring.head = (pulse_ring_idx_t)(0u - 3u);
+    g_ring.tail = g_ring.head;
+
+    for (i = 0u; i < 8u; i++)
+    {
+        f = (frame_t *)pulse_ring_reserve(&g_ring);
+        assert(f != (frame_t *)0);
+        f->seq = 100u + i;
+        pulse_ring_commit(&g_ring);
+    }
+    assert(g_ring.head == 5u);
+    assert(pulse_ring_count(&g_ring) == 8u);
+    assert(pulse_ring_reserve(&g_ring) == (void *)0);
+
+    for (i = 0u; i < 8u; i++)
+    {
+        f = (frame_t *)pulse_ring_peek(&g_ring);
+        assert(f->seq == (100u + i));
+        pulse_ring_release(&g_ring);
+    }
+    assert(pulse_ring_empty(&g_ring));
+}
+
+/* ---------------- ISR to task hand-off ---------------- */
+
+static uint32_t g_sent = 0u;
+static uint32_t g_dropped = 0u;
+static uint32_t g_received = 0u;
+static uint32_t g_next_seq = 0u;
+
+static void radio_isr(uint32_t frames)
+{
+    uint32_t i;
+    frame_t *f;
+
+    for (i = 0u; i < frames; i++)
+    {
+        f = (frame_t *)pulse_ring_reserve(&g_ring);
+        if (f == (frame_t *)0)
+        {
+            g_dropped++;
+            continue;
+        }
+        f->seq = g_sent;
+        (void)memset(f->payload, (int)(g_sent & 0xFFu), sizeof(f->payload));
+        pulse_ring_commit(&g_ring);
+        g_sent++;
+    }
+}
+
+static pulse_state_t packet_task(pulse_state_t s)
+{
+    const frame_t *f;
+
+    while ((f = (const frame_t *)pulse_ring_peek(&g_ring)) != (const frame_t *)0)
+    {
+        assert(f->seq == g_next_seq);
+        assert(f->payload[0] == (uint8_t)(g_next_seq & 0xFFu));
+        assert(f->payload[sizeof(f->payload) - 1u] == (uint8_t)(g_next_seq & 0xFFu));
+        g_next_seq++;
+        g_received++;
+        pulse_ring_release(&g_ring);
+    }
+    return s;
+}
+
+static void test_isr_to_task_handoff(void)
+{
+    uint32_t t;
+
+    assert(pulse_ring_init(&g_ring, g_slots, sizeof(frame_t), 8u) == 0);
+
+    pulse_init(1u);
+    assert(pulse_add_task(0, 4u, packet_task) == 0);
+
+    /* Up to seven frames per tick against a task that drains every fourth
+     * tick: bursts overflow, but no frame is delivered twice or out of order.
+     */
+    for (t = 0u; t < 600u; t++)
+    {
+        radio_isr(t % 8u);
+        pulse_tick_isr();
+        pulse_poll();
+    }
+    pulse_poll();
+
+    assert(g_dropped != 0u);
+    assert((g_received + pulse_ring_count(&g_ring)) == g_sent);
+    assert(g_sent + g_dropped == (600u / 8u) * 28u);
+}
+
+int main(void)
+{
+    test_init_rejects_bad_capacity();
+    test_slots_are_used_in_place();
+    test_every_slot_is_usable();
+    test_indices_wrap();
+    test_isr_to_task_handoff();
+
+    printf("All ring buffer tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_sporadic.c - Hosted unit tests for signal-released sporadic tasks (GCC)
+ *
+ * Signals are raised from the test body, standing in for a UART or radio
+ * interrupt. Built against each release backend by the Makefile.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PULSE_CFG_SPORADIC (1u)
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (8u)
+#include "../src/pulse.h"
+
+typedef struct
+{
+    uint32_t tick;
+    uint8_t  task_id;
+} exec_event_t;
+
+static exec_event_t g_log[64];
+static uint32_t g_log_len = 0u;
+static uint32_t g_now_tick = 0u;
+static uint8_t  g_resignal = 0u;
+
+static void log_exec(uint8_t task_id)
+{
+    if (g_log_len < (uint32_t)(sizeof(g_log) / sizeof(g_log[0])))
+    {
+        g_log[g_log_len].tick = g_now_tick;
+        g_log[g_log_len].task_id = task_id;
+        g_log_len++;
+    }
+}
+
+/* Init state carries the task id. */
+static pulse_state_t task(pulse_state_t s)
+{
+    log_exec((uint8_t)s);
+    if (g_resignal != 0u)
+    {
+        g_resignal = 0u;
+        assert(pulse_signal_isr((uint8_t)s) == 0);
+    }
+    return s;
+}
+
+static void reset(void)
+{
+    g_log_len = 0u;
+    g_now_tick = 0u;
+    g_resignal = 0u;
+    pulse_init(1u);
+}
+
+static void tick_and_poll(void)
+{
+    g_now_tick++;
+    pulse_tick_isr();
+    pulse_poll();
+}
+
+static void expect_event(uint32_t idx, uint32_t tick, uint8_t task_id)
+{
+    assert(idx < g_log_len);
+    assert(g_log[idx].tick == tick);
+    assert(g_log[idx].task_id == task_id);
+}
+
+static void test_signals_release_in_priority_order(void)
+{
+    uint32_t i;
+
+    reset();
+
+    assert(pulse_add_task(0, 4u, task) == 0);
+    assert(pulse_add_sporadic(1, 0u, task) == 0);
+    assert(pulse_add_sporadic(2, 0u, task) == 0);
+
+    /* Without signals only the periodic task ever runs. */
+    pulse_poll();
+    for (i = 0u; i < 8u; i++)
+    {
+        tick_and_poll();
+    }
+    assert(g_log_len == 3u);
+    expect_event(2u, 8u, 0u);
+
+    assert(pulse_signal_isr(2u) == 0);
+    assert(pulse_signal_isr(1u) == 0);
+    pulse_poll();
+
+    assert(g_log_len == 5u);
+    expect_event(3u, 8u, 1u);
+    expect_event(4u, 8u, 2u);
+}
+
+static void test_signals_coalesce(void)
+{
+    reset();
+
+    assert(pulse_add_sporadic(0, 0u, task) == 0);
+
+    assert(pulse_signal_isr(0u) == 0);
+    assert(pulse_signal_isr(0u) == 0);
+    assert(pulse_signal_isr(0u) == 0);
+    pulse_poll();
+    assert(g_log_len == 1u);
+
+    tick_and_poll();
+    assert(g_log_len == 1u);
+}
+
+static void test_min_gap_defers_release(void)
+{
+    reset();
+
+    assert(pulse_add_sporadic(0, 3u, task) == 0);
+
+    /* Guard is met at registration. */
+    assert(pulse_signal_isr(0u) == 0);
+    pulse_poll();
+    assert(g_log_len == 1u);
+    expect_event(0u, 0u, 0u);
+
+    /* Inside the guard: held until 3 ticks after the dispatch at 0. */
+    tick_and_poll();
+    assert(pulse_signal_isr(0u) == 0);
+    pulse_poll();
+    tick_and_poll();
+    assert(g_log_len == 1u);
+    tick_and_poll();
+    assert(g_log_len == 2u);
+    expect_event(1u, 3u, 0u);
+
+    /* A burst at 4 and 5 becomes one run at 6. */
+    tick_and_poll();
+    assert(pulse_signal_isr(0u) == 0);
+    tick_and_poll();
+    assert(pulse_signal_isr(0u) == 0);
+    tick_and_poll();
+    tick_and_poll();
+    tick_and_poll();
+    assert(g_log_len == 3u);
+    expect_event(2u, 6u, 0u);
+}
+
+static void test_signal_while_running(void)
+{
+    reset();
+
+    assert(pulse_add_sporadic(0, 0u, task) == 0);
+
+    g_resignal = 1u;
+    assert(pulse_signal_isr(0u) == 0);
+    pulse_poll();
+
+    /* Released again as it returned, within the same poll. */
+    assert(g_log_len == 2u);
+    expect_event(1u, 0u, 0u);
+}
+
+static void test_signal_api(void)
+{
+    reset();
+
+    assert(pulse_add_task(0, 2u, task) == 0);
+    assert(pulse_add_sporadic(1, 0u, task) == 0);
+
+    assert(pulse_signal_isr(0u) == -1);
+    assert(pulse_signal_isr(2u) == -1);
+    assert(pulse_add_sporadic(2, 0u, (pulse_tick_f)0) == -2);
+}
+
+int main(void)
+{
+    test_signals_release_in_priority_order();
+    test_signals_coalesce();
+    test_min_gap_defers_release();
+    test_signal_while_running();
+    test_signal_api();
+
+    printf("All sporadic task tests passed.\n");
+    return 0;
+}
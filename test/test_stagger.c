@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_stagger.c - Hosted unit tests for release offsets and auto staggering (GCC)
+ *
+ * Every task logs its init state as id together with the tick it ran on, so
+ * the tests can check both first releases and the number of releases per
+ * tick. Built against each release backend by the Makefile.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PULSE_CFG_AUTO_STAGGER (1u)
+#define PULSE_CFG_SPORADIC     (1u)
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (8u)
+#include "../src/pulse.h"
+
+#define LOG_TICKS (32u)
+
+static uint8_t  g_per_tick[LOG_TICKS];
+static uint32_t g_first[PULSE_MAX_TASKS];
+static uint32_t g_now_tick = 0u;
+
+static pulse_state_t task(pulse_state_t s)
+{
+    const uint8_t id = (uint8_t)s;
+
+    if (g_now_tick < LOG_TICKS)
+    {
+        g_per_tick[g_now_tick]++;
+    }
+    if (g_first[id] == 0xFFFFFFFFu)
+    {
+        g_first[id] = g_now_tick;
+    }
+    return s;
+}
+
+static void reset(void)
+{
+    uint32_t i;
+
+    for (i = 0u; i < LOG_TICKS; i++)
+    {
+        g_per_tick[i] = 0u;
+    }
+    for (i = 0u; i < PULSE_MAX_TASKS; i++)
+    {
+        g_first[i] = 0xFFFFFFFFu;
+    }
+    g_now_tick = 0u;
+
+    pulse_init(1u);
+}
+
+static void run_to(uint32_t end_tick)
+{
+    pulse_poll();
+    while (g_now_tick < end_tick)
+    {
+        g_now_tick++;
+        pulse_tick_isr();
+        pulse_poll();
+    }
+}
+
+static uint8_t peak_load(uint32_t end_tick)
+{
+    uint8_t peak = 0u;
+    uint32_t t;
+
+    for (t = 0u; t < end_tick; t++)
+    {
+        if (g_per_tick[t] > peak)
+        {
+            peak = g_per_tick[t];
+        }
+    }
+    return peak;
+}
+
+static void test_explicit_offsets(void)
+{
+    reset();
+
+    assert(pulse_add_task_ex(0, 4u, 2u, task) == 0);
+    assert(pulse_add_task_ex(1, 4u, 0u, task) == 0);
+    assert(pulse_add_task_ex(2, 4u, 4u, task) == 0);
+    assert(pulse_add_task_ex(3, 4u, 5u, task) == -1);
+    assert(pulse_add_task_ex(3, 0u, 0u, task) == -1);
+
+    run_to(12u);
+
+    assert(g_first[0] == 2u);
+    assert(g_first[1] == 0u);
+    assert(g_first[2] == 4u);
+    assert(g_per_tick[6] == 1u);
+    assert(g_per_tick[8] == 2u);
+}
+
+static void test_equal_periods_spread(void)
+{
+    uint8_t i;
+
+    reset();
+
+    for (i = 0u; i < 4u; i++)
+    {
+        assert(pulse_add_task(i, 4u, task) == 0);
+    }
+
+    pulse_auto_stagger();
+    run_to(16u);
+
+    for (i = 0u; i < 4u; i++)
+    {
+        assert(g_first[i] == i);
+    }
+    assert(peak_load(16u) == 1u);
+    assert(g_per_tick[15] == 1u);
+}
+
+static void test_harmonic_peak(void)
+{
+    reset();
+
+    assert(pulse_add_task(0, 2u, task) == 0);
+    assert(pulse_add_task(1, 4u, task) == 0);
+    assert(pulse_add_task(2, 2u, task) == 0);
+    assert(pulse_add_task(3, 8u, task) == 0);
+    assert(pulse_add_task(4, 4u, task) == 0);
+
+    /* Unstaggered, all five tasks meet at tick 0 and every 8 ticks. */
+    pulse_auto_stagger();
+    run_to(24u);
+
+    /* 13 releases per 8-tick hyperperiod: 2 on some tick is the floor. */
+    assert(peak_load(24u) == 2u);
+    assert(g_first[0] == 0u);
+    assert(g_first[2] == 1u);
+}
+
+static void test_fixed_phase_kept(void)
+{
+    uint8_t i;
+
+    reset();
+
+    assert(pulse_add_task_ex(0, 4u, 1u, task) == 0);
+    for (i = 1u; i < 4u; i++)
+    {
+        assert(pulse_add_task(i, 4u, task) == 0);
+    }
+
+    pulse_auto_stagger();
+    run_to(16u);
+
+    assert(g_first[0] == 1u);
+    assert(g_first[1] == 0u);
+    assert(g_first[2] == 2u);
+    assert(g_first[3] == 3u);
+    assert(peak_load(16u) == 1u);
+}
+
+static void test_sporadic_guard_ignored(void)
+{
+    uint8_t i;
+
+    /* A zero guard first, then last: neither enters the hyperperiod. */
+    reset();
+    assert(pulse_add_sporadic(7, 0u, task) == 0);
+    for (i = 1u; i < 4u; i++)
+    {
+        assert(pulse_add_task(i, 4u, task) == 0);
+    }
+    assert(pulse_add_sporadic(6, 0u, task) == 0);
+
+    pulse_auto_stagger();
+    run_to(16u);
+
+    assert(g_first[1] == 0u);
+    assert(g_first[2] == 1u);
+    assert(g_first[3] == 2u);
+    assert((g_first[6] == 0xFFFFFFFFu) && (g_first[7] == 0xFFFFFFFFu));
+    assert(peak_load(16u) == 1u);
+}
+
+int main(void)
+{
+    test_explicit_offsets();
+    test_equal_periods_spread();
+    test_harmonic_peak();
+    test_fixed_phase_kept();
+    test_sporadic_guard_ignored();
+
+    printf("All stagger tests passed.\n");
+    return 0;
+}
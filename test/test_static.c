@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_static.c - Hosted unit tests for the compile-time task table (GCC)
+ *
+ * Same checks as the priority and period tests of test_pulse.c, with the
+ * tasks taken from PULSE_TASK_TABLE instead of pulse_add_task(). Built
+ * against each release backend by the Makefile.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (4u)
+#define PULSE_CFG_STATIC_TASKS (1u)
+
+#define PULSE_TASK_TABLE(X) \
+    X(fast, 1u, fast_tick, 0) \
+    X(mid,  2u, mid_tick,  10) \
+    X(slow, 3u, slow_tick, 20)
+
+#include "../src/pulse.h"
+
+typedef struct
+{
+    uint32_t tick;
+    uint8_t  task_id;
+    pulse_state_t state;
+} exec_event_t;
+
+static exec_event_t g_log[64];
+static uint32_t g_log_len = 0u;
+static uint32_t g_now_tick = 0u;
+
+static pulse_state_t log_exec(uint8_t task_id, pulse_state_t s)
+{
+    if (g_log_len < (uint32_t)(sizeof(g_log) / sizeof(g_log[0])))
+    {
+        g_log[g_log_len].tick = g_now_tick;
+        g_log[g_log_len].task_id = task_id;
+        g_log[g_log_len].state = s;
+        g_log_len++;
+    }
+    return s + 1;
+}
+
+pulse_state_t fast_tick(pulse_state_t s)
+{
+    return log_exec((uint8_t)PULSE_TASK_ID_fast, s);
+}
+
+pulse_state_t mid_tick(pulse_state_t s)
+{
+    return log_exec((uint8_t)PULSE_TASK_ID_mid, s);
+}
+
+pulse_state_t slow_tick(pulse_state_t s)
+{
+    return log_exec((uint8_t)PULSE_TASK_ID_slow, s);
+}
+
+static void expect_event(uint32_t idx, uint32_t tick, uint8_t task_id, pulse_state_t state)
+{
+    assert(idx < g_log_len);
+    assert(g_log[idx].tick == tick);
+    assert(g_log[idx].task_id == task_id);
+    assert(g_log[idx].state == state);
+}
+
+static void test_table_ids(void)
+{
+    assert(PULSE_STATIC_TASK_COUNT == 3);
+    assert(PULSE_TASK_ID_fast == 0);
+    assert(PULSE_TASK_ID_mid == 1);
+    assert(PULSE_TASK_ID_slow == 2);
+}
+
+static void test_table_is_registered_by_init(void)
+{
+    uint32_t i;
+
+    g_log_len = 0u;
+    g_now_tick = 0u;
+
+    pulse_init(1u);
+
+    /* All released at registration, dispatched in table order. */
+    pulse_poll();
+    assert(g_log_len == 3u);
+    expect_event(0u, 0u, (uint8_t)PULSE_TASK_ID_fast, 0);
+    expect_event(1u, 0u, (uint8_t)PULSE_TASK_ID_mid, 10);
+    expect_event(2u, 0u, (uint8_t)PULSE_TASK_ID_slow, 20);
+
+    for (i = 0u; i < 6u; i++)
+    {
+        g_now_tick++;
+        pulse_tick_isr();
+        pulse_poll();
+    }
+
+    /* fast every tick, mid at 2/4/6, slow at 3/6. */
+    assert(g_log_len == 14u);
+    expect_event(3u, 1u, (uint8_t)PULSE_TASK_ID_fast, 1);
+    expect_event(5u, 2u, (uint8_t)PULSE_TASK_ID_mid, 11);
+    expect_event(7u, 3u, (uint8_t)PULSE_TASK_ID_slow, 21);
+    expect_event(11u, 6u, (uint8_t)PULSE_TASK_ID_fast, 6);
+    expect_event(12u, 6u, (uint8_t)PULSE_TASK_ID_mid, 13);
+    expect_event(13u, 6u, (uint8_t)PULSE_TASK_ID_slow, 22);
+}
+
+static void test_reinit_restores_initial_states(void)
+{
+    g_log_len = 0u;
+    g_now_tick = 0u;
+
+    pulse_init(1u);
+    pulse_poll();
+
+    assert(g_log_len == 3u);
+    expect_event(1u, 0u, (uint8_t)PULSE_TASK_ID_mid, 10);
+}
+
+int main(void)
+{
+    test_table_ids();
+    test_table_is_registered_by_init();
+    test_reinit_restores_initial_states();
+
+    printf("All static task table tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_stats.c - Hosted unit tests for per-task statistics (GCC)
+ *
+ * The host port's timestamp is a plain variable: the test sets it before each
+ * tick and poll, and each task advances it by its simulated execution time.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PULSE_CFG_STATS (1u)
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (8u)
+#include "../src/pulse.h"
+
+static uint32_t g_cost[2];
+
+static pulse_state_t task0(pulse_state_t s)
+{
+    pulse_port_host_stamp += g_cost[0];
+    return s;
+}
+
+static pulse_state_t task1(pulse_state_t s)
+{
+    pulse_port_host_stamp += g_cost[1];
+    return s;
+}
+
+static void tick_at(uint32_t stamp)
+{
+    pulse_port_host_stamp = stamp;
+    pulse_tick_isr();
+}
+
+static void poll_at(uint32_t stamp)
+{
+    pulse_port_host_stamp = stamp;
+    pulse_poll();
+}
+
+static void test_exec_time_and_latency(void)
+{
+    pulse_task_stats_t st;
+
+    pulse_port_host_stamp = 0u;
+    pulse_init(1u);
+
+    g_cost[0] = 5u;
+    g_cost[1] = 3u;
+    assert(pulse_add_task(0, 2u, task0) == 0);
+    assert(pulse_add_task(0, 2u, task1) == 0);
+
+    /* Released at 0; task1 also waits for task0 to finish. */
+    poll_at(10u);
+
+    tick_at(1000u);
+    tick_at(2000u);
+
+    g_cost[1] = 7u;
+    poll_at(2004u);
+
+    assert(pulse_get_task_stats(0u, &st) == 0);
+    assert(st.runs == 2u);
+    assert(st.exec_min == 5u);
+    assert(st.exec_max == 5u);
+    assert(st.exec_total == 10u);
+    assert(st.latency_max == 10u);
+
+    assert(pulse_get_task_stats(1u, &st) == 0);
+    assert(st.runs == 2u);
+    assert(st.exec_min == 3u);
+    assert(st.exec_max == 7u);
+    assert(st.exec_total == 10u);
+    assert(st.latency_max == 15u);
+}
+
+static void test_held_release_keeps_first_stamp(void)
+{
+    pulse_task_stats_t st;
+
+    pulse_port_host_stamp = 0u;
+    pulse_init(1u);
+
+    g_cost[0] = 1u;
+    assert(pulse_add_task(0, 1u, task0) == 0);
+    poll_at(0u);
+
+    /* Main loop stalls across three ticks: latency counts from the first. */
+    tick_at(1000u);
+    tick_at(2000u);
+    tick_at(3000u);
+    poll_at(3500u);
+
+    assert(pulse_get_task_stats(0u, &st) == 0);
+    assert(st.runs == 2u);
+    assert(st.latency_max == 2500u);
+}
+
+static void test_stats_api(void)
+{
+    pulse_task_stats_t st;
+
+    pulse_port_host_stamp = 0u;
+    pulse_init(1u);
+
+    g_cost[0] = 4u;
+    assert(pulse_add_task(0, 1u, task0) == 0);
+
+    assert(pulse_get_task_stats(0u, &st) == 0);
+    assert(st.runs == 0u);
+
+    poll_at(0u);
+
+    assert(pulse_get_task_stats(1u, &st) == -1);
+    assert(pulse_get_task_stats(0u, (pulse_task_stats_t *)0) == -1);
+
+    pulse_reset_task_stats(0u);
+    assert(pulse_get_task_stats(0u, &st) == 0);
+    assert(st.runs == 0u);
+    assert(st.exec_max == 0u);
+    assert(st.exec_total == 0u);
+    assert(st.exec_min == 0xFFFFFFFFu);
+}
+
+int main(void)
+{
+    test_exec_time_and_latency();
+    test_held_release_keeps_first_stamp();
+    test_stats_api();
+
+    printf("All statistics tests passed.\n");
+    return 0;
+}
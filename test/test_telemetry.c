@@ -1,6 +1,6 @@
 /*
  * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
- * Licensed under the MIT License. See LICENSE file in the project root for details. 
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
  * test_telemetry.c - Telemetry data-sharing pattern example test for Pulse (hosted)
  *
  * This test demonstrates an IPC-like pattern (snapshot + sequence counter) used
@@ -9,7 +9,7 @@
  *
  * The goal is to validate:
  *   1) Producer/consumer task wiring and scheduling order under Pulse.
- *   2) Snapshot consistency logic (seqlock-style) under simulated interference.
+ *   2) Snapshot consistency logic (pulse_seqlock.h) under simulated interference.
  *
  * Build notes:
  *   - This file is intended to be compiled alongside Pulse headers using the
@@ -21,6 +21,7 @@
 
 #include <assert.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <string.h>
 
 #include "pulse_port_host.h"
@@ -30,6 +31,7 @@
 #define PULSE_IMPLEMENTATION
 #define PULSE_MAX_TASKS (8u)
 #include "pulse.h"
+#include "pulse_seqlock.h"
 
 /* ---------------- Telemetry snapshot + seqlock ---------------- */
 
@@ -40,40 +42,38 @@ typedef struct
     uint16_t vbat_mv;
 } telemetry_t;
 
-static volatile uint32_t g_seq = 0u;
-static telemetry_t       g_tlm;
+static pulse_seqlock_t g_lock = PULSE_SEQLOCK_INIT;
+static telemetry_t     g_tlm;
 
 /* Test-only hook used to simulate a writer "interrupting" a read. */
 static uint8_t g_inject_once = 0u;
 
 static void tlm_write_begin(void)
 {
-    g_seq++; /* odd => write in progress */
+    pulse_seqlock_write_begin(&g_lock);
 }
 
 static void tlm_write_end(void)
 {
-    g_seq++; /* even => stable */
+    pulse_seqlock_write_end(&g_lock);
 }
 
-/* Returns 1 if snapshot is consistent. */
+/* Returns 1 if snapshot is consistent. Open-coded with read_begin/read_retry
+ * so the test can interfere between the two.
+ */
 static uint8_t tlm_read_snapshot(telemetry_t * const out)
 {
-    uint32_t s0;
-    uint32_t s1;
+    uint32_t tries;
+    pulse_seq_t s0;
 
     if (out == (telemetry_t *)0)
     {
         return 0u;
     }
 
-    for (;;)
+    for (tries = 0u; tries < PULSE_SEQLOCK_TRIES; tries++)
     {
-        s0 = g_seq;
-        if ((s0 & 1u) != 0u)
-        {
-            continue; /* writer in progress */
-        }
+        s0 = pulse_seqlock_read_begin(&g_lock);
 
         /* Simulate interference exactly once: after seeing an even seq, a writer
          * starts and completes an update, forcing a retry.
@@ -89,14 +89,13 @@ static uint8_t tlm_read_snapshot(telemetry_t * const out)
 
         *out = g_tlm;
 
-        s1 = g_seq;
-        if ((s0 == s1) && ((s1 & 1u) == 0u))
+        if (!pulse_seqlock_read_retry(&g_lock, s0))
         {
-            break;
+            return 1u;
         }
     }
 
-    return 1u;
+    return 0u;
 }
 
 /* ---------------- Test harness logging ---------------- */
@@ -218,7 +217,7 @@ static void test_telemetry_pipeline_basic(void)
     reset_log();
 
     /* Clear shared telemetry */
-    g_seq = 0u;
+    pulse_seqlock_init(&g_lock);
     (void)memset(&g_tlm, 0, sizeof(g_tlm));
 
     pulse_init(1u);
@@ -265,9 +264,55 @@ static void test_telemetry_pipeline_basic(void)
     assert(g_log[8].snap.temp_c == 31);
 }
 
+static void test_seqlock_read_is_bounded(void)
+{
+    telemetry_t snap;
+
+    pulse_seqlock_init(&g_lock);
+    g_tlm.tick = 5u;
+    g_tlm.temp_c = -3;
+    g_tlm.vbat_mv = 3700u;
+
+    assert(PULSE_SEQLOCK_READ(&g_lock, snap, g_tlm) == 0);
+    assert(snap.tick == 5u);
+    assert(snap.temp_c == -3);
+    assert(snap.vbat_mv == 3700u);
+
+    /* A writer that never finishes (e.g. a task preempted by the reading
+     * ISR) makes the reader give up instead of spinning.
+     */
+    tlm_write_begin();
+    assert(PULSE_SEQLOCK_READ(&g_lock, snap, g_tlm) == -1);
+    tlm_write_end();
+
+    g_inject_once = 1u;
+    assert(tlm_read_snapshot(&snap) == 1u);
+}
+
+static void test_seqlock_typed_write(void)
+{
+    telemetry_t next;
+    telemetry_t snap;
+    const pulse_seq_t before = g_lock.seq;
+
+    next.tick = 9u;
+    next.temp_c = 12;
+    next.vbat_mv = 4100u;
+
+    PULSE_SEQLOCK_WRITE(&g_lock, g_tlm, next);
+    assert(g_lock.seq == (pulse_seq_t)(before + 2u));
+
+    assert(pulse_seqlock_read(&g_lock, &snap, &g_tlm, sizeof(snap)) == 0);
+    assert(snap.tick == 9u);
+    assert(snap.temp_c == 12);
+    assert(snap.vbat_mv == 4100u);
+}
+
 int main(void)
 {
     test_telemetry_pipeline_basic();
-     printf("All telemetry tests passed.\n");
+    test_seqlock_read_is_bounded();
+    test_seqlock_typed_write();
+    printf("All telemetry tests passed.\n");
     return 0;
 }
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_tickless.c - Hosted unit tests for the tickless kernel (GCC)
+ *
+ * The host port exposes a simulated free-running counter. The test plays the
+ * role of the timer hardware: it jumps the counter straight to the interval the
+ * kernel last programmed, then runs the "compare ISR" and the main loop poll.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PULSE_CFG_TICKLESS (1u)
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (8u)
+#include "../src/pulse.h"
+
+/* ---------------- Test logging ---------------- */
+
+typedef struct
+{
+    uint32_t tick;
+    uint8_t  task_id;
+} exec_event_t;
+
+static exec_event_t g_log[128];
+static uint32_t g_log_len = 0u;
+static uint32_t g_wakeups = 0u;
+
+static void log_exec(uint8_t task_id)
+{
+    if (g_log_len < (uint32_t)(sizeof(g_log) / sizeof(g_log[0])))
+    {
+        g_log[g_log_len].tick = pulse_port_host_ticks;
+        g_log[g_log_len].task_id = task_id;
+        g_log_len++;
+    }
+}
+
+static void reset_sim(void)
+{
+    g_log_len = 0u;
+    g_wakeups = 0u;
+    pulse_port_host_ticks = 0u;
+    pulse_port_host_ref = 0u;
+    pulse_port_host_next = 0u;
+}
+
+/* Jump from compare to compare until end_tick, as the hardware would. */
+static void run_until(uint32_t end_tick)
+{
+    pulse_poll();
+
+    while ((pulse_port_host_ticks + pulse_port_host_next) <= end_tick)
+    {
+        pulse_port_host_ticks += pulse_port_host_next;
+        g_wakeups++;
+
+        pulse_tick_isr();
+        pulse_poll();
+    }
+}
+
+static pulse_state_t task0(pulse_state_t s)
+{
+    (void)s;
+    log_exec(0u);
+    return 0;
+}
+
+static pulse_state_t task1(pulse_state_t s)
+{
+    (void)s;
+    log_exec(1u);
+    return 0;
+}
+
+static void expect_event(uint32_t idx, uint32_t tick, uint8_t task_id)
+{
+    assert(idx < g_log_len);
+    assert(g_log[idx].tick == tick);
+    assert(g_log[idx].task_id == task_id);
+}
+
+static void test_wakes_only_at_releases(void)
+{
+    reset_sim();
+
+    pulse_init(1u);
+
+    assert(pulse_add_task(0, 2u, task0) == 0);
+    assert(pulse_add_task(0, 3u, task1) == 0);
+
+    run_until(6u);
+
+    /* Releases at 0 (immediate), 2, 3, 4, 6: one wakeup per distinct tick. */
+    assert(g_wakeups == 4u);
+    assert(g_log_len == 7u);
+
+    expect_event(0u, 0u, 0u);
+    expect_event(1u, 0u, 1u);
+    expect_event(2u, 2u, 0u);
+    expect_event(3u, 3u, 1u);
+    expect_event(4u, 4u, 0u);
+    expect_event(5u, 6u, 0u);
+    expect_event(6u, 6u, 1u);
+}
+
+static void test_slow_tasks_sleep_long(void)
+{
+    reset_sim();
+
+    pulse_init(1u);
+
+    assert(pulse_add_task(0, 1000u, task0) == 0);
+    assert(pulse_add_task(0, 2500u, task1) == 0);
+
+    run_until(10000u);
+
+    /* task0: 0..10000 step 1000 (11 runs), task1: 0..10000 step 2500 (5 runs). */
+    assert(g_log_len == 16u);
+
+    /* Ticks 1000..10000 plus 2500 and 7500: 12 wakeups instead of 10000. */
+    assert(g_wakeups == 12u);
+
+    expect_event(0u, 0u, 0u);
+    expect_event(1u, 0u, 1u);
+    expect_event(2u, 1000u, 0u);
+    expect_event(3u, 2000u, 0u);
+    expect_event(4u, 2500u, 1u);
+    expect_event(15u, 10000u, 1u);
+}
+
+static void test_late_wake_catches_up(void)
+{
+    reset_sim();
+
+    pulse_init(1u);
+
+    assert(pulse_add_task(0, 4u, task0) == 0);
+
+    pulse_poll();
+    assert(pulse_port_host_next == 4u);
+
+    /* Wake 3 ticks past the compare (e.g. interrupts were masked): the task
+     * is released once and its next period counts from the late run.
+     */
+    pulse_port_host_ticks = 7u;
+    pulse_tick_isr();
+    pulse_poll();
+
+    assert(g_log_len == 2u);
+    expect_event(1u, 7u, 0u);
+    assert(pulse_port_host_next == 4u);
+
+    /* A spurious wake with no elapsed time only rearms the compare. */
+    pulse_tick_isr();
+    pulse_poll();
+    assert(g_log_len == 2u);
+    assert(pulse_port_host_next == 4u);
+}
+
+int main(void)
+{
+    test_wakes_only_at_releases();
+    test_slow_tasks_sleep_long();
+    test_late_wake_catches_up();
+
+    printf("All tickless tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * test_trace.c - Hosted unit tests for the trace ring (GCC)
+ *
+ * The host port's sub-tick counter is set by the tests and advanced by the
+ * tasks, so every record's position inside its tick is known. Built against
+ * each release backend and with batch dispatch by the Makefile.
+ */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define PULSE_CFG_TRACE       (1u)
+#define PULSE_CFG_TRACE_DEPTH (8u)
+#define PULSE_CFG_OVERRUN     (1u)
+#define PULSE_CFG_PRIORITY    (1u)
+#define PULSE_CFG_IDLE_SLEEP  (1u)
+
+#include "../src/pulse_port_host.h"
+#include "../src/pulse_version.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (4u)
+#include "../src/pulse.h"
+
+#define TASK_COST (3u)
+
+static pulse_kernel_t g_k;
+static pulse_trace_rec_t g_rec[PULSE_CFG_TRACE_DEPTH];
+
+static pulse_state_t busy_task(pulse_state_t s)
+{
+    pulse_port_host_subtick = (uint16_t)(pulse_port_host_subtick + TASK_COST);
+    return s;
+}
+
+static void expect(uint16_t i, uint8_t event, uint8_t id, uint32_t tick, uint16_t sub)
+{
+    assert(g_rec[i].event == event);
+    assert(g_rec[i].id == id);
+    assert(g_rec[i].tick == tick);
+    assert(g_rec[i].sub == sub);
+}
+
+static uint16_t drain(void)
+{
+    return pulse_kernel_trace_read(&g_k, g_rec, (uint16_t)PULSE_CFG_TRACE_DEPTH);
+}
+
+static void test_records_in_order(void)
+{
+    pulse_port_host_subtick = 7u;
+    pulse_kernel_init(&g_k, 5u);
+
+    assert(pulse_kernel_add_task(&g_k, 0, 2u, busy_task) == 0);
+    assert(pulse_kernel_add_task(&g_k, 0, 3u, busy_task) == 0);
+    pulse_kernel_start(&g_k);
+    pulse_kernel_poll(&g_k);
+
+    assert(drain() == 7u);
+    expect(0u, PULSE_TRACE_RELEASE, 0u, 0u, 7u);
+    expect(1u, PULSE_TRACE_RELEASE, 1u, 0u, 7u);
+    expect(2u, PULSE_TRACE_START, PULSE_TRACE_NO_TASK, 0u, 5000u);
+    expect(3u, PULSE_TRACE_RUN, 0u, 0u, 7u);
+    expect(4u, PULSE_TRACE_DONE, 0u, 0u, 10u);
+    expect(5u, PULSE_TRACE_RUN, 1u, 0u, 10u);
+    expect(6u, PULSE_TRACE_DONE, 1u, 0u, 13u);
+    assert(drain() == 0u);
+
+    /* Tick 1 releases nothing, tick 2 releases task 0. */
+    pulse_kernel_tick_isr(&g_k);
+    pulse_kernel_poll(&g_k);
+    assert(drain() == 0u);
+
+    pulse_port_host_subtick = 1u;
+    pulse_kernel_tick_isr(&g_k);
+    pulse_port_host_subtick = 4u;
+    pulse_kernel_poll(&g_k);
+    assert(drain() == 3u);
+    expect(0u, PULSE_TRACE_RELEASE, 0u, 2u, 1u);
+    expect(1u, PULSE_TRACE_RUN, 0u, 2u, 4u);
+    expect(2u, PULSE_TRACE_DONE, 0u, 2u, 7u);
+
+    /* A task that stays ready over several ticks is released once. */
+    pulse_kernel_tick_isr(&g_k);
+    pulse_kernel_tick_isr(&g_k);
+    pulse_kernel_tick_isr(&g_k);
+    assert(drain() == 2u);
+    assert((g_rec[0].event == PULSE_TRACE_RELEASE) && (g_rec[0].id == 1u) && (g_rec[0].tick == 3u));
+    assert((g_rec[1].event == PULSE_TRACE_RELEASE) && (g_rec[1].id == 0u) && (g_rec[1].tick == 4u));
+}
+
+static void test_full_ring_reports_loss(void)
+{
+    uint32_t t;
+
+    pulse_port_host_subtick = 0u;
+    pulse_kernel_init(&g_k, 1u);
+    assert(pulse_kernel_add_task(&g_k, 0, 1u, busy_task) == 0);
+
+    /* Three records per tick: release, run, done. The ring holds eight, so
+     * the last four are dropped.
+     */
+    pulse_kernel_poll(&g_k);
+    for (t = 0u; t < 3u; t++)
+    {
+        pulse_kernel_tick_isr(&g_k);
+        pulse_kernel_poll(&g_k);
+    }
+    assert(drain() == 8u);
+    expect(7u, PULSE_TRACE_RUN, 0u, 2u, 6u);
+    assert(drain() == 0u);
+
+    /* The count comes out ahead of the next record. */
+    pulse_kernel_tick_isr(&g_k);
+    assert(drain() == 2u);
+    expect(0u, PULSE_TRACE_LOST, PULSE_TRACE_NO_TASK, 4u, 4u);
+    assert((g_rec[1].event == PULSE_TRACE_RELEASE) && (g_rec[1].tick == 4u));
+
+    /* Short reads leave the rest in place. */
+    pulse_kernel_poll(&g_k);
+    assert(pulse_kernel_trace_read(&g_k, g_rec, 1u) == 1u);
+    assert(g_rec[0].event == PULSE_TRACE_RUN);
+    assert(pulse_kernel_trace_read(&g_k, g_rec, 4u) == 1u);
+    assert(g_rec[0].event == PULSE_TRACE_DONE);
+    assert(pulse_kernel_trace_read(&g_k, (pulse_trace_rec_t *)0, 4u) == 0u);
+}
+
+static void test_overrun_and_ids(void)
+{
+    uint32_t t;
+    uint16_t n;
+    uint16_t i;
+    uint8_t saw_overrun = 0u;
+    uint8_t saw_run = 0u;
+
+    pulse_kernel_init(&g_k, 1u);
+    assert(pulse_kernel_add_task(&g_k, 0, 2u, busy_task) == 0);
+    assert(pulse_kernel_add_task(&g_k, 0, 2u, busy_task) == 0);
+
+    /* Id 1 moves to position 0; records still name it 1. */
+    assert(pulse_kernel_set_priority(&g_k, 1u, 0u) == 0);
+    pulse_kernel_start(&g_k);
+    pulse_kernel_poll(&g_k);
+    assert(drain() == 7u);
+    assert((g_rec[3].event == PULSE_TRACE_RUN) && (g_rec[3].id == 1u));
+    assert((g_rec[5].event == PULSE_TRACE_RUN) && (g_rec[5].id == 0u));
+
+    /* Eight ticks without a poll: both tasks miss releases. */
+    for (t = 0u; t < 8u; t++)
+    {
+        pulse_kernel_tick_isr(&g_k);
+    }
+    (void)drain();
+    pulse_kernel_poll(&g_k);
+    n = drain();
+
+    /* Logged when the late dispatch is claimed, ahead of its run. */
+    for (i = 0u; i < n; i++)
+    {
+        if ((g_rec[i].event == PULSE_TRACE_OVERRUN) && (g_rec[i].id == 1u))
+        {
+            assert(g_rec[i].tick == 8u);
+            assert(g_rec[i].sub == (uint16_t)pulse_kernel_get_overruns(&g_k, 1u));
+            assert(saw_run == 0u);
+            saw_overrun = 1u;
+        }
+        if ((g_rec[i].event == PULSE_TRACE_RUN) && (g_rec[i].id == 1u))
+        {
+            saw_run = 1u;
+        }
+    }
+    assert((saw_overrun == 1u) && (saw_run == 1u));
+}
+
+static void test_idle_sleep(void)
+{
+    pulse_kernel_init(&g_k, 1u);
+    assert(pulse_kernel_add_task(&g_k, 0, 4u, busy_task) == 0);
+
+    /* Something ready: no sleep, nothing logged. */
+    (void)drain();
+    pulse_kernel_idle(&g_k);
+    assert(drain() == 0u);
+
+    pulse_kernel_poll(&g_k);
+    (void)drain();
+    pulse_port_host_subtick = 20u;
+    pulse_kernel_idle(&g_k);
+    assert(pulse_port_host_sleeps != 0u);
+    assert(drain() == 2u);
+    expect(0u, PULSE_TRACE_IDLE, PULSE_TRACE_NO_TASK, 0u, 20u);
+    expect(1u, PULSE_TRACE_WAKE, PULSE_TRACE_NO_TASK, 0u, 20u);
+}
+
+static void test_start_tick_length(void)
+{
+    pulse_kernel_init_us(&g_k, 250u);
+    pulse_kernel_start(&g_k);
+    assert(drain() == 1u);
+    expect(0u, PULSE_TRACE_START, PULSE_TRACE_NO_TASK, 0u, 250u);
+
+    /* Too long for microseconds: milliseconds, flagged. */
+    pulse_kernel_init(&g_k, 100u);
+    pulse_kernel_start(&g_k);
+    assert(drain() == 1u);
+    assert(g_rec[0].sub == (uint16_t)(PULSE_TRACE_TICK_MS | 100u));
+
+    pulse_kernel_init(&g_k, 60000u);
+    pulse_kernel_start(&g_k);
+    assert(drain() == 1u);
+    assert(g_rec[0].sub == (uint16_t)(PULSE_TRACE_TICK_MS | 0x7FFFu));
+}
+
+static void test_default_instance_and_encoding(void)
+{
+    pulse_trace_rec_t rec;
+    uint8_t buf[PULSE_TRACE_WIRE_SIZE];
+
+    pulse_init(1u);
+    assert(pulse_add_task(0, 1u, busy_task) == 0);
+    assert(pulse_trace_read(&rec, 1u) == 1u);
+    assert((rec.event == PULSE_TRACE_RELEASE) && (rec.id == 0u));
+    assert(pulse_trace_read(&rec, 1u) == 0u);
+
+    rec.tick = 0x12345678u;
+    rec.sub = 0xBEEFu;
+    rec.event = PULSE_TRACE_DONE;
+    rec.id = 9u;
+    pulse_trace_encode(&rec, buf);
+    assert((buf[0] == 0x78u) && (buf[1] == 0x56u) && (buf[2] == 0x34u) && (buf[3] == 0x12u));
+    assert((buf[4] == 0xEFu) && (buf[5] == 0xBEu));
+    assert((buf[6] == PULSE_TRACE_DONE) && (buf[7] == 9u));
+}
+
+int main(void)
+{
+    test_records_in_order();
+    test_full_ring_reports_loss();
+    test_overrun_and_ids();
+    test_idle_sleep();
+    test_start_tick_length();
+    test_default_instance_and_encoding();
+
+    printf("All trace tests passed.\n");
+    return 0;
+}
@@ -0,0 +1,515 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * pulse_analyze.c - Host-side schedulability and per-tick load analyzer (C11)
+ *
+ * Reads a task table in registration order (index 0 = highest priority, as
+ * pulse_poll() dispatches it) and reports:
+ *   - hyperperiod and utilization,
+ *   - per task, the worst-case level-i busy window and response time under
+ *     non-preemptive fixed-priority dispatch (Davis, Burns, Bril, Lukkien,
+ *     "Controller Area Network (CAN) schedulability analysis: Refuted,
+ *     revisited and revised", Real-Time Systems 35(3), 2007),
+ *   - a histogram of per-tick release load over the hyperperiod.
+ *
+ * The response-time bound assumes the critical instant (every task released
+ * on the same tick), so it holds for any phase offsets. Offsets only shape the
+ * per-tick histogram. A task is schedulable if it completes before its next
+ * release (implicit deadline), since a later release would be an overrun.
+ *
+ * Input, one directive per line, '#' starts a comment:
+ *   tick_us  <n>                            kernel tick length (required)
+ *   isr_us   <n>                            tick ISR cost per tick (optional)
+ *   stamp_hz <n>                            WCETs are PULSE_PORT_TIMESTAMP()
+ *                                           counts at this rate, e.g. exec_max
+ *                                           from pulse_get_task_stats()
+ *   task <name> <period> <offset> <wcet>    period/offset in ticks, wcet in
+ *                                           us (or stamps, see stamp_hz)
+ *
+ * Exit status: 0 schedulable, 1 not schedulable, 2 bad input.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_TASKS     (256u)
+#define NAME_LEN      (24u)
+#define LINE_LEN      (256u)
+
+/* The histogram walks at most this many ticks of the hyperperiod. */
+#define HIST_TICKS    (1u << 20)
+
+/* Busy windows longer than this are reported as unbounded. */
+#define BUSY_LIMIT_NS (UINT64_C(1) << 62)
+
+typedef struct
+{
+    char     name[NAME_LEN];
+    uint64_t period;   /* ticks */
+    uint64_t offset;   /* ticks */
+    uint64_t wcet_in;  /* as written in the table */
+    uint64_t period_ns;
+    uint64_t wcet_ns;
+} task_t;
+
+typedef struct
+{
+    uint64_t blocking_ns;
+    uint64_t busy_ns;
+    uint64_t jobs;
+    uint64_t response_ns;
+    int      bounded;
+} result_t;
+
+static task_t   g_tasks[MAX_TASKS];
+static result_t g_results[MAX_TASKS];
+static uint32_t g_count = 0u;
+
+static uint64_t g_tick_ns = 0u;
+static uint64_t g_isr_ns = 0u;
+static uint64_t g_stamp_hz = 0u;
+
+static uint64_t div_ceil(uint64_t a, uint64_t b)
+{
+    return (a + b - 1u) / b;
+}
+
+static uint64_t gcd_u64(uint64_t a, uint64_t b)
+{
+    while (b != 0u)
+    {
+        const uint64_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+/* Returns 0 if the lcm does not fit in 64 bits. */
+static uint64_t lcm_u64(uint64_t a, uint64_t b)
+{
+    const uint64_t step = b / gcd_u64(a, b);
+
+    if (step > (UINT64_MAX / a))
+    {
+        return 0u;
+    }
+    return a * step;
+}
+
+static int parse_u64(const char *s, uint64_t *out)
+{
+    char *end;
+    unsigned long long v;
+
+    if ((s == NULL) || (*s == '-'))
+    {
+        return -1;
+    }
+    errno = 0;
+    v = strtoull(s, &end, 10);
+    if ((errno != 0) || (end == s) || (*end != '\0'))
+    {
+        return -1;
+    }
+    *out = (uint64_t)v;
+    return 0;
+}
+
+static int parse_error(const char *path, unsigned line, const char *what)
+{
+    fprintf(stderr, "%s:%u: %s\n", path, line, what);
+    return -1;
+}
+
+static int load_table(const char *path)
+{
+    char buf[LINE_LEN];
+    unsigned line = 0u;
+    FILE *f = fopen(path, "r");
+
+    if (f == NULL)
+    {
+        fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    while (fgets(buf, (int)sizeof(buf), f) != NULL)
+    {
+        char *argv[6];
+        int argc = 0;
+        char *hash = strchr(buf, '#');
+        char *tok;
+        uint64_t v;
+
+        line++;
+        if (hash != NULL)
+        {
+            *hash = '\0';
+        }
+
+        for (tok = strtok(buf, " \t\r\n"); (tok != NULL) && (argc < 6); tok = strtok(NULL, " \t\r\n"))
+        {
+            argv[argc++] = tok;
+        }
+        if (argc == 0)
+        {
+            continue;
+        }
+
+        if ((strcmp(argv[0], "tick_us") == 0) || (strcmp(argv[0], "isr_us") == 0) ||
+            (strcmp(argv[0], "stamp_hz") == 0))
+        {
+            if ((argc != 2) || (parse_u64(argv[1], &v) != 0))
+            {
+                fclose(f);
+                return parse_error(path, line, "expected one unsigned value");
+            }
+            if (argv[0][0] == 't')
+            {
+                g_tick_ns = v * 1000u;
+            }
+            else if (argv[0][0] == 'i')
+            {
+                g_isr_ns = v * 1000u;
+            }
+            else
+            {
+                g_stamp_hz = v;
+            }
+        }
+        else if (strcmp(argv[0], "task") == 0)
+        {
+            task_t *t = &g_tasks[g_count];
+
+            if (argc != 5)
+            {
+                fclose(f);
+                return parse_error(path, line, "expected: task <name> <period> <offset> <wcet>");
+            }
+            if (g_count >= MAX_TASKS)
+            {
+                fclose(f);
+                return parse_error(path, line, "too many tasks");
+            }
+            if ((parse_u64(argv[2], &t->period) != 0) || (parse_u64(argv[3], &t->offset) != 0) ||
+                (parse_u64(argv[4], &t->wcet_in) != 0))
+            {
+                fclose(f);
+                return parse_error(path, line, "period, offset and wcet must be unsigned integers");
+            }
+            /* Same limits as pulse_add_task_ex(). */
+            if ((t->period == 0u) || (t->period > UINT64_C(0x7FFFFFFF)) || (t->offset > t->period))
+            {
+                fclose(f);
+                return parse_error(path, line, "period must be 1..2^31-1 and offset <= period");
+            }
+            snprintf(t->name, sizeof(t->name), "%s", argv[1]);
+            g_count++;
+        }
+        else
+        {
+            fclose(f);
+            return parse_error(path, line, "unknown directive");
+        }
+    }
+    fclose(f);
+
+    if (g_tick_ns == 0u)
+    {
+        return parse_error(path, line, "missing or zero tick_us");
+    }
+    if (g_count == 0u)
+    {
+        return parse_error(path, line, "no tasks");
+    }
+    return 0;
+}
+
+static void convert_units(void)
+{
+    uint32_t i;
+
+    for (i = 0u; i < g_count; i++)
+    {
+        task_t *t = &g_tasks[i];
+
+        t->period_ns = t->period * g_tick_ns;
+        if (g_stamp_hz != 0u)
+        {
+            t->wcet_ns = div_ceil(t->wcet_in * UINT64_C(1000000000), g_stamp_hz);
+        }
+        else
+        {
+            t->wcet_ns = t->wcet_in * 1000u;
+        }
+    }
+}
+
+/* Work released by tasks 0..level and the tick ISR in [0, t]: the ISR
+ * preempts everything, tasks only wait.
+ */
+static uint64_t demand_upto(uint32_t level, uint64_t t, int inclusive)
+{
+    uint64_t sum = 0u;
+    uint32_t j;
+
+    for (j = 0u; j < level; j++)
+    {
+        const uint64_t n = inclusive ? ((t / g_tasks[j].period_ns) + 1u) : div_ceil(t, g_tasks[j].period_ns);
+        sum += n * g_tasks[j].wcet_ns;
+    }
+    if (g_isr_ns != 0u)
+    {
+        sum += (inclusive ? ((t / g_tick_ns) + 1u) : div_ceil(t, g_tick_ns)) * g_isr_ns;
+    }
+    return sum;
+}
+
+static void analyze_task(uint32_t i)
+{
+    result_t *r = &g_results[i];
+    const task_t *ti = &g_tasks[i];
+    uint64_t t;
+    uint64_t q;
+    uint32_t j;
+
+    r->blocking_ns = 0u;
+    for (j = i + 1u; j < g_count; j++)
+    {
+        if (g_tasks[j].wcet_ns > r->blocking_ns)
+        {
+            r->blocking_ns = g_tasks[j].wcet_ns;
+        }
+    }
+
+    /* Level-i busy window: t = B + sum_{j<=i} ceil(t/T_j) C_j (+ ISR). */
+    t = r->blocking_ns + ti->wcet_ns;
+    for (;;)
+    {
+        const uint64_t next = r->blocking_ns + demand_upto(i + 1u, (t == 0u) ? 1u : t, 0);
+
+        if (next > BUSY_LIMIT_NS)
+        {
+            r->bounded = 0;
+            return;
+        }
+        if (next == t)
+        {
+            break;
+        }
+        t = next;
+    }
+    r->busy_ns = t;
+    r->jobs = div_ceil(t, ti->period_ns);
+    r->response_ns = 0u;
+    r->bounded = 1;
+
+    for (q = 0u; q < r->jobs; q++)
+    {
+        /* Start of job q: w = B + q C_i + sum_{j<i} (floor(w/T_j) + 1) C_j. */
+        uint64_t w = r->blocking_ns + (q * ti->wcet_ns);
+        uint64_t f;
+
+        for (;;)
+        {
+            const uint64_t next = r->blocking_ns + (q * ti->wcet_ns) + demand_upto(i, w, 1);
+
+            if (next > BUSY_LIMIT_NS)
+            {
+                r->bounded = 0;
+                return;
+            }
+            if (next == w)
+            {
+                break;
+            }
+            w = next;
+        }
+
+        /* Runs to completion once started, except for tick ISRs. */
+        f = w + ti->wcet_ns;
+        if (g_isr_ns != 0u)
+        {
+            for (;;)
+            {
+                const uint64_t next = w + ti->wcet_ns + (div_ceil(f - w, g_tick_ns) * g_isr_ns);
+
+                if (next == f)
+                {
+                    break;
+                }
+                f = next;
+            }
+        }
+
+        if ((f - (q * ti->period_ns)) > r->response_ns)
+        {
+            r->response_ns = f - (q * ti->period_ns);
+        }
+    }
+}
+
+static void print_histogram(uint64_t hyper)
+{
+    static uint32_t releases[HIST_TICKS];
+    static uint64_t work[HIST_TICKS];
+    /* Buckets: releases 0..7, 8+; load 0, <=25 %, <=50 %, <=75 %, <=100 %, > 100 %. */
+    uint64_t by_count[9] = { 0u };
+    uint64_t by_load[6] = { 0u };
+    static const char *const load_label[6] = { "idle", "<= 25%", "<= 50%", "<= 75%", "<= 100%", "> 100%" };
+    const uint64_t span = ((hyper == 0u) || (hyper > HIST_TICKS)) ? HIST_TICKS : hyper;
+    uint64_t peak_tick = 0u;
+    uint64_t t;
+    uint32_t i;
+
+    memset(releases, 0, sizeof(releases));
+    memset(work, 0, sizeof(work));
+
+    for (i = 0u; i < g_count; i++)
+    {
+        for (t = g_tasks[i].offset % g_tasks[i].period; t < span; t += g_tasks[i].period)
+        {
+            releases[t]++;
+            work[t] += g_tasks[i].wcet_ns;
+        }
+    }
+
+    for (t = 0u; t < span; t++)
+    {
+        const uint64_t pct = (work[t] * 100u) / g_tick_ns;
+        uint32_t b;
+
+        by_count[(releases[t] < 8u) ? releases[t] : 8u]++;
+
+        if (releases[t] == 0u)
+        {
+            b = 0u;
+        }
+        else if (pct <= 25u)
+        {
+            b = 1u;
+        }
+        else if (pct <= 50u)
+        {
+            b = 2u;
+        }
+        else if (pct <= 75u)
+        {
+            b = 3u;
+        }
+        else if (work[t] <= g_tick_ns)
+        {
+            b = 4u;
+        }
+        else
+        {
+            b = 5u;
+        }
+        by_load[b]++;
+
+        if (work[t] > work[peak_tick])
+        {
+            peak_tick = t;
+        }
+    }
+
+    printf("\nper-tick load over %" PRIu64 " ticks%s\n", span, (span < hyper) || (hyper == 0u) ? " (truncated)" : "");
+    printf("  releases      ticks\n");
+    for (i = 0u; i < 9u; i++)
+    {
+        if (by_count[i] != 0u)
+        {
+            printf("  %s%-10u  %" PRIu64 "\n", (i == 8u) ? ">=" : "  ", i, by_count[i]);
+        }
+    }
+    printf("  wcet / tick   ticks\n");
+    for (i = 0u; i < 6u; i++)
+    {
+        printf("  %-12s  %" PRIu64 "\n", load_label[i], by_load[i]);
+    }
+    printf("  peak: tick %" PRIu64 ", %u releases, %.1f us (%.1f%% of a tick)\n",
+           peak_tick, releases[peak_tick], (double)work[peak_tick] / 1000.0,
+           ((double)work[peak_tick] * 100.0) / (double)g_tick_ns);
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t hyper = 1u;
+    double util = 0.0;
+    int ok = 1;
+    uint32_t i;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <task-table>\n", argv[0]);
+        return 2;
+    }
+    if (load_table(argv[1]) != 0)
+    {
+        return 2;
+    }
+    convert_units();
+
+    for (i = 0u; i < g_count; i++)
+    {
+        util += (double)g_tasks[i].wcet_ns / (double)g_tasks[i].period_ns;
+        if (hyper != 0u)
+        {
+            hyper = lcm_u64(hyper, g_tasks[i].period);
+        }
+    }
+
+    printf("Pulse schedulability analysis: %s\n", argv[1]);
+    printf("tick %.1f us, tick ISR %.1f us, %u tasks\n", (double)g_tick_ns / 1000.0,
+           (double)g_isr_ns / 1000.0, g_count);
+    if (hyper != 0u)
+    {
+        printf("hyperperiod   %" PRIu64 " ticks\n", hyper);
+    }
+    else
+    {
+        printf("hyperperiod   > 2^64 ticks\n");
+    }
+    printf("utilization   %.1f%% (tasks %.1f%%, tick ISR %.1f%%)\n",
+           (util + ((double)g_isr_ns / (double)g_tick_ns)) * 100.0, util * 100.0,
+           ((double)g_isr_ns * 100.0) / (double)g_tick_ns);
+
+    printf("\n%-3s %-16s %8s %7s %10s %10s %12s %6s %12s %7s  %s\n", "id", "name", "period", "offset",
+           "wcet_us", "block_us", "busy_us", "jobs", "resp_us", "resp_t", "verdict");
+
+    for (i = 0u; i < g_count; i++)
+    {
+        const task_t *t = &g_tasks[i];
+        const result_t *r = &g_results[i];
+
+        analyze_task(i);
+
+        if (r->bounded == 0)
+        {
+            printf("%-3u %-16s %8" PRIu64 " %7" PRIu64 " %10.1f %10.1f %12s %6s %12s %7s  %s\n", i, t->name,
+                   t->period, t->offset, (double)t->wcet_ns / 1000.0, (double)r->blocking_ns / 1000.0,
+                   "unbounded", "-", "-", "-", "FAIL");
+            ok = 0;
+            continue;
+        }
+
+        printf("%-3u %-16s %8" PRIu64 " %7" PRIu64 " %10.1f %10.1f %12.1f %6" PRIu64 " %12.1f %7" PRIu64 "  %s\n",
+               i, t->name, t->period, t->offset, (double)t->wcet_ns / 1000.0, (double)r->blocking_ns / 1000.0,
+               (double)r->busy_ns / 1000.0, r->jobs, (double)r->response_ns / 1000.0,
+               div_ceil(r->response_ns, g_tick_ns), (r->response_ns <= t->period_ns) ? "ok" : "FAIL");
+        if (r->response_ns > t->period_ns)
+        {
+            ok = 0;
+        }
+    }
+
+    print_histogram(hyper);
+
+    printf("\n%s\n", ok ? "schedulable" : "NOT schedulable: a task can miss its next release");
+    return ok ? 0 : 1;
+}
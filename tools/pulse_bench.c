@@ -0,0 +1,450 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * pulse_bench.c - Virtual-time scheduler benchmark for hosted builds (C11, POSIX)
+ *
+ * Runs generated task sets through the real kernel for a number of simulated
+ * ticks. Time inside the simulation is virtual: each tick is TICK_US
+ * microseconds, and each task advances the host port's timestamp by its
+ * simulated execution time instead of doing work. After every
+ * pulse_tick_isr() the driver hands pulse_poll_budget() the time left until
+ * the next tick, so an overloaded tick pushes work into the next one and
+ * releases are missed exactly as on a target.
+ *
+ * Kernel overhead is real: the host clock times every pulse_tick_isr() and
+ * pulse_poll_budget() call, less the measured cost of reading the clock.
+ * The task bodies are a few instructions, so the poll time is dominated by
+ * dispatch.
+ *
+ * Usage: pulse_bench [ticks] [seed]
+ *
+ * Prints one JSON object per task set on stdout:
+ *   backend, ready, storage          kernel configuration of this binary
+ *   set, tasks, ticks, seed          task set and run length
+ *   utilization                      simulated CPU load of the set
+ *   dispatches                       tasks run
+ *   ns_per_tick                      host time per pulse_tick_isr()
+ *   ns_per_dispatch                  host time in pulse_poll_budget() per task
+ *                                    run, over the calls that ran any
+ *   ns_per_idle_poll                 host time of a call that ran nothing
+ *   peak_dispatches_per_tick         most tasks run after a single tick
+ *   peak_work_us                     most simulated execution time after a tick
+ *   overloaded_ticks                 ticks that started with no time left
+ *   missed_releases                  sum of pulse_get_overruns() over the set
+ *
+ * Exit status: 0 on success, 2 for bad arguments.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifndef PULSE_CFG_OVERRUN
+#define PULSE_CFG_OVERRUN (1u)
+#endif
+#ifndef PULSE_CFG_POLL_BUDGET
+#define PULSE_CFG_POLL_BUDGET (1u)
+#endif
+
+#include "pulse_port_host.h"
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (32u)
+#include "pulse.h"
+
+#if (PULSE_CFG_OVERRUN != 1u) || (PULSE_CFG_POLL_BUDGET != 1u)
+#error "pulse_bench needs PULSE_CFG_OVERRUN=1 and PULSE_CFG_POLL_BUDGET=1"
+#endif
+
+#define TICK_US       (1000u)
+#define DEFAULT_TICKS (1000000u)
+#define CALIBRATE_N   (100000u)
+
+typedef struct
+{
+    uint32_t period; /* ticks */
+    uint32_t offset; /* ticks, 0..period */
+    uint32_t cost;   /* simulated us per run */
+} bench_task_t;
+
+typedef struct
+{
+    const char  *name;
+    uint32_t     count;
+    bench_task_t tasks[PULSE_MAX_TASKS];
+} bench_set_t;
+
+/* ---------------- Simulated execution ---------------- */
+
+static uint64_t g_vt = 0u; /* virtual time, us */
+static uint32_t g_cost[PULSE_MAX_TASKS];
+static uint64_t g_dispatches = 0u;
+static uint64_t g_work = 0u;
+
+/* Every task runs this; its state is its index in the set. */
+static pulse_state_t bench_task(pulse_state_t s)
+{
+    const uint32_t cost = g_cost[(uint32_t)s];
+
+    g_vt += cost;
+    pulse_port_host_stamp = (uint32_t)g_vt;
+    g_dispatches++;
+    g_work += cost;
+    return s;
+}
+
+/* ---------------- Host clock ---------------- */
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * UINT64_C(1000000000)) + (uint64_t)ts.tv_nsec;
+}
+
+/* Cost of one timed region with nothing in it. The minimum, not the mean:
+ * the occasional preempted sample would otherwise be charged to every
+ * measured call.
+ */
+static uint64_t g_clock_ns = 0u;
+
+static void calibrate_clock(void)
+{
+    uint64_t best = UINT64_MAX;
+    uint32_t i;
+
+    for (i = 0u; i < CALIBRATE_N; i++)
+    {
+        const uint64_t t0 = now_ns();
+        const uint64_t t1 = now_ns();
+
+        if ((t1 - t0) < best)
+        {
+            best = t1 - t0;
+        }
+    }
+    g_clock_ns = best;
+}
+
+static double net_ns(uint64_t measured, uint64_t regions, uint64_t per)
+{
+    const uint64_t overhead = regions * g_clock_ns;
+
+    if ((per == 0u) || (measured <= overhead))
+    {
+        return 0.0;
+    }
+    return (double)(measured - overhead) / (double)per;
+}
+
+/* ---------------- Task sets ---------------- */
+
+static uint32_t g_rng = 1u;
+
+static uint32_t rng_next(void)
+{
+    /* xorshift32 */
+    g_rng ^= g_rng << 13u;
+    g_rng ^= g_rng >> 17u;
+    g_rng ^= g_rng << 5u;
+    return g_rng;
+}
+
+static uint32_t rng_range(uint32_t lo, uint32_t hi)
+{
+    return lo + (rng_next() % ((hi - lo) + 1u));
+}
+
+static void set_task(bench_set_t *set, uint32_t period, uint32_t offset, uint32_t cost)
+{
+    bench_task_t *t = &set->tasks[set->count];
+
+    t->period = period;
+    t->offset = offset;
+    t->cost = (cost == 0u) ? 1u : cost;
+    set->count++;
+}
+
+/* Gives every task of the set the same cost, chosen so the whole set loads
+ * the CPU to u_total per mille.
+ */
+static void share_load(bench_set_t *set, uint32_t u_total)
+{
+    double rate = 0.0;
+    uint32_t i;
+
+    for (i = 0u; i < set->count; i++)
+    {
+        rate += 1.0 / (double)set->tasks[i].period;
+    }
+    for (i = 0u; i < set->count; i++)
+    {
+        const uint32_t cost = (uint32_t)(((double)u_total * (double)TICK_US) / (1000.0 * rate));
+
+        set->tasks[i].cost = (cost == 0u) ? 1u : cost;
+    }
+}
+
+/* Periods dividing each other, 50% load. Every 128 ticks all 16 tasks are
+ * released together.
+ */
+static void make_harmonic(bench_set_t *set)
+{
+    static const uint32_t periods[8] = { 1u, 2u, 4u, 8u, 16u, 32u, 64u, 128u };
+    uint32_t i;
+
+    set->name = "harmonic";
+    set->count = 0u;
+    for (i = 0u; i < 16u; i++)
+    {
+        set_task(set, periods[i % 8u], 0u, 1u);
+    }
+    share_load(set, 500u);
+}
+
+/* Pairwise co-prime periods, so release patterns almost never repeat; 60%. */
+static void make_coprime(bench_set_t *set)
+{
+    static const uint32_t primes[16] = { 2u, 3u, 5u, 7u, 11u, 13u, 17u, 19u,
+                                         23u, 29u, 31u, 37u, 41u, 43u, 47u, 53u };
+    uint32_t i;
+
+    set->name = "coprime";
+    set->count = 0u;
+    for (i = 0u; i < 16u; i++)
+    {
+        set_task(set, primes[i], 0u, 1u);
+    }
+    share_load(set, 600u);
+}
+
+/* 24 tasks released together every 50 ticks with 2.4 ticks of work, above a
+ * lowest-priority task due every tick: it misses releases on each burst.
+ */
+static void make_bursty(bench_set_t *set)
+{
+    uint32_t i;
+
+    set->name = "bursty";
+    set->count = 0u;
+    for (i = 0u; i < 24u; i++)
+    {
+        set_task(set, 50u, 0u, 100u);
+    }
+    set_task(set, 1u, 0u, 50u);
+}
+
+/* Random periods 1..1000 ticks, offsets, and costs of up to a quarter tick,
+ * as a cooperative task set would be built.
+ */
+static void make_random(bench_set_t *set)
+{
+    uint32_t i;
+
+    set->name = "random";
+    set->count = 0u;
+    for (i = 0u; i < PULSE_MAX_TASKS; i++)
+    {
+        const uint32_t period = rng_range(1u, 1000u);
+
+        set_task(set, period, rng_range(0u, period), rng_range(1u, TICK_US / 4u));
+    }
+}
+
+/* Worst case per tick: every task released on every tick. */
+static void make_dense(bench_set_t *set)
+{
+    uint32_t i;
+
+    set->name = "dense";
+    set->count = 0u;
+    for (i = 0u; i < PULSE_MAX_TASKS; i++)
+    {
+        set_task(set, 1u, 0u, 10u);
+    }
+}
+
+/* Long periods: almost every tick releases nothing. */
+static void make_sparse(bench_set_t *set)
+{
+    uint32_t i;
+
+    set->name = "sparse";
+    set->count = 0u;
+    for (i = 0u; i < PULSE_MAX_TASKS; i++)
+    {
+        set_task(set, 1000u + (i * 37u), i * 29u, 20u);
+    }
+}
+
+/* ---------------- Driver ---------------- */
+
+static const char *backend_name(void)
+{
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+    return "heap";
+#elif (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+    return "wheel";
+#else
+    return "scan";
+#endif
+}
+
+static int run_set(const bench_set_t *set, uint32_t ticks, uint32_t seed)
+{
+    uint64_t isr_ns = 0u;
+    uint64_t busy_ns = 0u;
+    uint64_t idle_ns = 0u;
+    uint64_t idle_polls = 0u;
+    uint64_t missed = 0u;
+    uint64_t overloaded = 0u;
+    uint32_t peak_dispatches = 0u;
+    uint64_t peak_work = 0u;
+    double utilization = 0.0;
+    uint32_t n;
+    uint32_t i;
+
+    g_vt = 0u;
+    g_dispatches = 0u;
+    g_work = 0u;
+    pulse_port_host_stamp = 0u;
+
+    pulse_init(1u);
+    for (i = 0u; i < set->count; i++)
+    {
+        const bench_task_t *t = &set->tasks[i];
+
+        g_cost[i] = t->cost;
+        utilization += (double)t->cost / ((double)t->period * (double)TICK_US);
+        if (pulse_add_task_ex((pulse_state_t)i, t->period, t->offset, bench_task) != 0)
+        {
+            fprintf(stderr, "pulse_bench: %s: cannot add task %" PRIu32 "\n", set->name, i);
+            return -1;
+        }
+    }
+
+    for (n = 1u; n <= ticks; n++)
+    {
+        const uint64_t tick_at = (uint64_t)n * TICK_US;
+        const uint64_t dispatches_before = g_dispatches;
+        const uint64_t work_before = g_work;
+        pulse_stamp_t budget = 0u;
+        uint64_t t0;
+        uint64_t t1;
+
+        if (g_vt < tick_at)
+        {
+            g_vt = tick_at;
+        }
+        pulse_port_host_stamp = (uint32_t)g_vt;
+
+        t0 = now_ns();
+        pulse_tick_isr();
+        t1 = now_ns();
+        isr_ns += t1 - t0;
+
+        if (g_vt < (tick_at + TICK_US))
+        {
+            budget = (pulse_stamp_t)((tick_at + TICK_US) - g_vt);
+        }
+        else
+        {
+            overloaded++;
+        }
+
+        t0 = now_ns();
+        (void)pulse_poll_budget(budget);
+        t1 = now_ns();
+        if (g_dispatches == dispatches_before)
+        {
+            idle_ns += t1 - t0;
+            idle_polls++;
+        }
+        else
+        {
+            busy_ns += t1 - t0;
+        }
+
+        if ((uint32_t)(g_dispatches - dispatches_before) > peak_dispatches)
+        {
+            peak_dispatches = (uint32_t)(g_dispatches - dispatches_before);
+        }
+        if ((g_work - work_before) > peak_work)
+        {
+            peak_work = g_work - work_before;
+        }
+    }
+
+    for (i = 0u; i < set->count; i++)
+    {
+        missed += pulse_get_overruns((uint8_t)i);
+    }
+
+    printf("{\"backend\":\"%s\",\"ready\":\"%s\",\"storage\":\"%s\","
+           "\"set\":\"%s\",\"tasks\":%" PRIu32 ",\"ticks\":%" PRIu32 ",\"seed\":%" PRIu32 ","
+           "\"utilization\":%.3f,\"dispatches\":%" PRIu64 ","
+           "\"ns_per_tick\":%.2f,\"ns_per_dispatch\":%.2f,\"ns_per_idle_poll\":%.2f,"
+           "\"peak_dispatches_per_tick\":%" PRIu32 ",\"peak_work_us\":%" PRIu64 ","
+           "\"overloaded_ticks\":%" PRIu64 ",\"missed_releases\":%" PRIu64 "}\n",
+           backend_name(),
+           (PULSE_CFG_READY_BITMAP == 1u) ? "bitmap" : "flat",
+           (PULSE_CFG_TASK_SOA == 1u) ? "soa" : "aos",
+           set->name, set->count, ticks, seed,
+           utilization, g_dispatches,
+           net_ns(isr_ns, ticks, ticks),
+           net_ns(busy_ns, ticks - idle_polls, g_dispatches),
+           net_ns(idle_ns, idle_polls, idle_polls),
+           peak_dispatches, peak_work,
+           overloaded, missed);
+    return 0;
+}
+
+static int parse_u32(const char *s, uint32_t *out)
+{
+    char *end = NULL;
+    const unsigned long v = strtoul(s, &end, 10);
+
+    if ((end == s) || (*end != '\0') || (v == 0u) || (v > 0xFFFFFFFFul))
+    {
+        return -1;
+    }
+    *out = (uint32_t)v;
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    static bench_set_t set;
+    void (*const makers[])(bench_set_t *) = {
+        make_harmonic, make_coprime, make_bursty, make_random, make_dense, make_sparse
+    };
+    uint32_t ticks = DEFAULT_TICKS;
+    uint32_t seed = 1u;
+    uint32_t i;
+
+    if ((argc > 3) ||
+        ((argc > 1) && (parse_u32(argv[1], &ticks) != 0)) ||
+        ((argc > 2) && (parse_u32(argv[2], &seed) != 0)))
+    {
+        fprintf(stderr, "usage: pulse_bench [ticks] [seed]\n");
+        return 2;
+    }
+
+    g_rng = seed;
+    calibrate_clock();
+
+    for (i = 0u; i < (uint32_t)(sizeof(makers) / sizeof(makers[0])); i++)
+    {
+        makers[i](&set);
+        if (run_set(&set, ticks, seed) != 0)
+        {
+            return 2;
+        }
+    }
+    return 0;
+}
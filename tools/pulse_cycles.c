@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * pulse_cycles.c - Cycle counts of the tick ISR and dispatch on AVR and MSP430
+ *
+ * A bare-metal image that times the kernel with the target's own 16-bit
+ * timer clocked from the CPU clock, so one count is one CPU cycle. It runs
+ * unchanged on hardware and on a cycle-accurate simulator:
+ *
+ *   AVR (Timer1, clk/1):      simavr, output on the simavr console register
+ *   MSP430 (TA0, SMCLK/1):    mspdebug sim, output on a simio console at
+ *                             PULSE_CYCLES_CONSOLE; stops at
+ *                             pulse_cycles_done()
+ *
+ * This is the timer the port uses for the tick. The image never calls
+ * pulse_start(), so the kernel never programs it and its interrupt stays
+ * off. pulse_tick_isr() is called directly with interrupts masked, so the
+ * counts do not include interrupt entry and exit.
+ *
+ * PULSE_MAX_TASKS is set per build and every slot is used. Two task sets are
+ * timed, each over ROUNDS ticks, keeping the worst round:
+ *   all:  every task has period 1, so each tick releases all of them and the
+ *         poll after it dispatches all of them
+ *   one:  only the last task has period 1; the others never come due during
+ *         the run. Each tick releases one task, and the poll finds it in the
+ *         last slot, which is the longest search
+ *
+ * Prints one JSON object:
+ *   target, tasks, backend, ready    build configuration
+ *   tick_all, tick_one               pulse_tick_isr() with N and 1 releases
+ *   poll_all                         pulse_poll() dispatching all N tasks
+ *   dispatch_avg                     poll_all / N
+ *   poll_one                         pulse_poll() dispatching the last task
+ *   poll_idle                        pulse_poll() with nothing ready
+ *
+ * All figures are CPU cycles with the cost of reading the timer subtracted.
+ * A region longer than the 16-bit timer can count is reported as null.
+ */
+
+#include <stdint.h>
+
+#ifndef PULSE_MAX_TASKS
+#define PULSE_MAX_TASKS (8u)
+#endif
+
+#if defined(__AVR__)
+
+#include "../src/pulse_port_avr.h"
+#include <avr/sleep.h>
+#include "avr_mcu_section.h"
+
+#ifndef PULSE_CYCLES_MCU
+#define PULSE_CYCLES_MCU "atmega328p"
+#endif
+
+AVR_MCU(F_CPU, PULSE_CYCLES_MCU);
+AVR_MCU_SIMAVR_CONSOLE(&GPIOR0);
+
+static void cycles_timer_init(void)
+{
+    TIMSK1 = 0u;
+    TCCR1A = 0u;
+    TCCR1B = (uint8_t)(1u << CS10);
+}
+
+#define CYCLES_NOW()        (TCNT1)
+#define CYCLES_CLEAR_WRAP() do { TIFR1 = (uint8_t)(1u << TOV1); } while (0)
+#define CYCLES_WRAPPED()    ((TIFR1 & (uint8_t)(1u << TOV1)) != 0u)
+
+static void cycles_putc(char c)
+{
+    GPIOR0 = (uint8_t)c;
+}
+
+/* simavr exits when the core sleeps with interrupts off. */
+static void cycles_exit(void)
+{
+    cli();
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    sleep_enable();
+    for (;;)
+    {
+        sleep_cpu();
+    }
+}
+
+#elif defined(__MSP430__)
+
+#ifndef PULSE_MSP430_TICK_HZ
+#define PULSE_MSP430_TICK_HZ (32768u)
+#endif
+
+#include "../src/pulse_port_msp430.h"
+
+#ifndef PULSE_CYCLES_MCU
+#define PULSE_CYCLES_MCU "msp430g2553"
+#endif
+
+/* Must match the base address given to mspdebug's simio console. */
+#ifndef PULSE_CYCLES_CONSOLE
+#define PULSE_CYCLES_CONSOLE (0x01F0u)
+#endif
+
+static void cycles_timer_init(void)
+{
+    WDTCTL = (uint16_t)(WDTPW | WDTHOLD);
+    TA0CCTL0 = 0u;
+    TA0CTL = (uint16_t)(TASSEL__SMCLK | MC__CONTINUOUS | TACLR);
+}
+
+#define CYCLES_NOW()        (TA0R)
+#define CYCLES_CLEAR_WRAP() do { TA0CTL &= (uint16_t)~TAIFG; } while (0)
+#define CYCLES_WRAPPED()    ((TA0CTL & TAIFG) != 0u)
+
+static void cycles_putc(char c)
+{
+    *(volatile uint8_t *)PULSE_CYCLES_CONSOLE = (uint8_t)c;
+}
+
+/* The runner sets a breakpoint here. */
+void pulse_cycles_done(void) __attribute__((noinline));
+void pulse_cycles_done(void)
+{
+    for (;;)
+    {
+    }
+}
+
+static void cycles_exit(void)
+{
+    __disable_interrupt();
+    pulse_cycles_done();
+}
+
+#else
+#error "pulse_cycles.c: build with avr-gcc or msp430-elf-gcc"
+#endif
+
+#define PULSE_IMPLEMENTATION
+#include "../src/pulse.h"
+
+#define ROUNDS  (16u)
+#define NEVER   (30000u) /* period that does not come due during a run; fits a 16-bit tick */
+#define WRAPPED (0xFFFFFFFFu)
+
+typedef struct
+{
+    uint32_t tick_all;
+    uint32_t tick_one;
+    uint32_t poll_all;
+    uint32_t poll_one;
+    uint32_t poll_idle;
+} cycles_report_t;
+
+static cycles_report_t g_report;
+
+/* Cost of an empty timed region. */
+static uint16_t g_overhead = 0xFFFFu;
+
+static pulse_state_t task_body(pulse_state_t s)
+{
+    return s;
+}
+
+/* ---------------- Timing ---------------- */
+
+static uint16_t g_start;
+
+static inline void region_begin(void)
+{
+    CYCLES_CLEAR_WRAP();
+    g_start = CYCLES_NOW();
+}
+
+/* Cycles since region_begin(), net of g_overhead, or WRAPPED. */
+static inline uint32_t region_end(void)
+{
+    const uint16_t end = CYCLES_NOW();
+    const uint16_t raw = (uint16_t)(end - g_start);
+
+    if (CYCLES_WRAPPED() && (end >= g_start))
+    {
+        return WRAPPED;
+    }
+    return (raw > g_overhead) ? (uint32_t)(raw - g_overhead) : 0u;
+}
+
+static void calibrate(void)
+{
+    uint32_t i;
+
+    for (i = 0u; i < ROUNDS; i++)
+    {
+        uint16_t end;
+
+        g_start = CYCLES_NOW();
+        end = CYCLES_NOW();
+        if ((uint16_t)(end - g_start) < g_overhead)
+        {
+            g_overhead = (uint16_t)(end - g_start);
+        }
+    }
+}
+
+static void keep_max(uint32_t *max, uint32_t v)
+{
+    if ((*max != WRAPPED) && ((v == WRAPPED) || (v > *max)))
+    {
+        *max = v;
+    }
+}
+
+/* ---------------- Task sets ---------------- */
+
+static void run_all(void)
+{
+    uint32_t r;
+    uint8_t i;
+
+    pulse_init(1u);
+    for (i = 0u; i < PULSE_MAX_TASKS; i++)
+    {
+        (void)pulse_add_task(0, 1u, task_body);
+    }
+    pulse_poll();
+
+    for (r = 0u; r < ROUNDS; r++)
+    {
+        region_begin();
+        pulse_tick_isr();
+        keep_max(&g_report.tick_all, region_end());
+
+        region_begin();
+        pulse_poll();
+        keep_max(&g_report.poll_all, region_end());
+    }
+}
+
+static void run_one(void)
+{
+    uint32_t r;
+    uint8_t i;
+
+    pulse_init(1u);
+    for (i = 0u; i < (uint8_t)(PULSE_MAX_TASKS - 1u); i++)
+    {
+        (void)pulse_add_task(0, NEVER, task_body);
+    }
+    (void)pulse_add_task(0, 1u, task_body);
+    pulse_poll();
+
+    for (r = 0u; r < ROUNDS; r++)
+    {
+        region_begin();
+        pulse_tick_isr();
+        keep_max(&g_report.tick_one, region_end());
+
+        region_begin();
+        pulse_poll();
+        keep_max(&g_report.poll_one, region_end());
+
+        region_begin();
+        pulse_poll();
+        keep_max(&g_report.poll_idle, region_end());
+    }
+}
+
+/* ---------------- Output ---------------- */
+
+static void put_str(const char *s)
+{
+    while (*s != '\0')
+    {
+        cycles_putc(*s);
+        s++;
+    }
+}
+
+static void put_u32(uint32_t v)
+{
+    char buf[10];
+    uint8_t n = 0u;
+
+    do
+    {
+        buf[n] = (char)('0' + (char)(v % 10u));
+        n++;
+        v /= 10u;
+    } while (v != 0u);
+
+    while (n > 0u)
+    {
+        n--;
+        cycles_putc(buf[n]);
+    }
+}
+
+static void put_field(const char *name, uint32_t v)
+{
+    put_str(",\"");
+    put_str(name);
+    put_str("\":");
+    if (v == WRAPPED)
+    {
+        put_str("null");
+    }
+    else
+    {
+        put_u32(v);
+    }
+}
+
+static const char *backend_name(void)
+{
+#if (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_HEAP)
+    return "heap";
+#elif (PULSE_CFG_RELEASE_BACKEND == PULSE_RELEASE_WHEEL)
+    return "wheel";
+#else
+    return "scan";
+#endif
+}
+
+int main(void)
+{
+    PULSE_PORT_DISABLE_GLOBAL_IRQ();
+    cycles_timer_init();
+    calibrate();
+
+    run_all();
+    run_one();
+
+    put_str("{\"target\":\"");
+    put_str(PULSE_CYCLES_MCU);
+    put_str("\",\"tasks\":");
+    put_u32(PULSE_MAX_TASKS);
+    put_str(",\"backend\":\"");
+    put_str(backend_name());
+    put_str("\",\"ready\":\"");
+    put_str((PULSE_CFG_READY_BITMAP == 1u) ? "bitmap" : "flat");
+    put_str("\"");
+    put_field("tick_all", g_report.tick_all);
+    put_field("tick_one", g_report.tick_one);
+    put_field("poll_all", g_report.poll_all);
+    put_field("dispatch_avg", (g_report.poll_all == WRAPPED) ? WRAPPED : (g_report.poll_all / PULSE_MAX_TASKS));
+    put_field("poll_one", g_report.poll_one);
+    put_field("poll_idle", g_report.poll_idle);
+    put_str("}\n");
+
+    cycles_exit();
+    return 0;
+}
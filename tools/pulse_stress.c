@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * pulse_stress.c - Real-time stress run of the kernel on the POSIX port (C11, POSIX)
+ *
+ * Runs a task set for a number of seconds at a real tick rate under
+ * src/pulse_port_posix.h, so the tick arrives as a signal at any point of
+ * pulse_poll(), in the middle of a claim or a retire as much as of a task.
+ * Some tasks spin for part of a tick to widen those windows. Every run
+ * checks, from inside the task, that it is not already running, that it is
+ * out of the ready set, and that no tick released it again while it ran. At
+ * the end each task must have run no more often than its period allows and
+ * at least half as often, so a release is neither doubled nor lost.
+ *
+ * Usage: pulse_stress [seconds] [tick_us]
+ *
+ * Prints one JSON object on stdout:
+ *   lock_free                  PULSE_CFG_LOCK_FREE of this binary
+ *   tick_us, ticks             tick length and ticks handled
+ *   dispatches                 tasks run
+ *   criticals                  critical sections entered after start
+ *   criticals_per_tick         the same per tick
+ *   min_run_ratio              fewest runs of a task against its period
+ *   violations                 failed checks
+ *
+ * Exit status: 0 on success, 1 if a check failed, 2 for bad arguments.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "pulse_port_posix.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define PULSE_IMPLEMENTATION
+#define PULSE_MAX_TASKS (8u)
+#include "pulse.h"
+
+#define DEFAULT_SECONDS (2u)
+#define DEFAULT_TICK_US (100u)
+
+typedef struct
+{
+    uint32_t period;  /* ticks */
+    uint32_t spin_us; /* busy time per run */
+} stress_task_t;
+
+static const stress_task_t g_set[PULSE_MAX_TASKS] = {
+    { 2u, 0u }, { 3u, 20u }, { 4u, 0u }, { 5u, 30u }, { 7u, 0u }, { 11u, 50u }, { 13u, 0u }, { 17u, 80u }
+};
+
+static uint32_t g_runs[PULSE_MAX_TASKS];
+static uint8_t  g_busy[PULSE_MAX_TASKS];
+static uint32_t g_violations = 0u;
+
+static void check(int ok)
+{
+    if (ok == 0)
+    {
+        g_violations++;
+    }
+}
+
+/* Each task's state is its id. */
+static pulse_state_t stress_task(pulse_state_t s)
+{
+    const uint8_t id = (uint8_t)s;
+    const uint32_t start = pulse_port_posix_timestamp();
+
+    check(g_busy[id] == 0u);
+    check(pulse_ready_test(&pulse_kernel, id) == 0u);
+    g_busy[id] = 1u;
+
+    while ((uint32_t)(pulse_port_posix_timestamp() - start) < g_set[id].spin_us)
+    {
+    }
+
+    /* Ticks during the run left the task alone. */
+    check(pulse_ready_test(&pulse_kernel, id) == 0u);
+    g_busy[id] = 0u;
+    g_runs[id]++;
+    return s;
+}
+
+static int parse_u32(const char *s, uint32_t *out)
+{
+    char *end = NULL;
+    unsigned long v;
+
+    errno = 0;
+    v = strtoul(s, &end, 10);
+    if ((errno != 0) || (end == s) || (*end != '\0') || (s[0] == '-') || (v == 0u) || (v > 0xFFFFFFFFul))
+    {
+        return -1;
+    }
+    *out = (uint32_t)v;
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seconds = DEFAULT_SECONDS;
+    uint32_t tick_us = DEFAULT_TICK_US;
+    uint32_t total;
+    uint32_t ticks;
+    uint32_t criticals;
+    uint32_t dispatches = 0u;
+    double min_ratio = 0.0;
+    uint8_t i;
+
+    if ((argc > 3) ||
+        ((argc > 1) && (parse_u32(argv[1], &seconds) != 0)) ||
+        ((argc > 2) && ((parse_u32(argv[2], &tick_us) != 0) || (tick_us < PULSE_PORT_TICK_US_MIN) ||
+                        (tick_us > PULSE_PORT_TICK_US_MAX))))
+    {
+        fprintf(stderr, "usage: pulse_stress [seconds] [tick_us]\n");
+        return 2;
+    }
+    total = (uint32_t)(((uint64_t)seconds * 1000000u) / tick_us);
+
+    pulse_init_us(tick_us);
+    for (i = 0u; i < PULSE_MAX_TASKS; i++)
+    {
+        if (pulse_add_task((pulse_state_t)i, g_set[i].period, stress_task) != 0)
+        {
+            return 2;
+        }
+    }
+    /* pulse_start() without its endless loop, so the run can end. */
+    pulse_kernel_start(&pulse_kernel);
+    atomic_store(&pulse_port_posix_criticals, 0u);
+    PULSE_PORT_TIMER_INIT_US(tick_us);
+    PULSE_PORT_ENABLE_GLOBAL_IRQ();
+
+    while (atomic_load(&pulse_port_posix_ticks) < total)
+    {
+        pulse_poll();
+        PULSE_PORT_IDLE_HOOK();
+    }
+    pulse_port_posix_stop();
+    pulse_poll();
+
+    ticks = atomic_load(&pulse_port_posix_ticks);
+    criticals = atomic_load(&pulse_port_posix_criticals);
+    for (i = 0u; i < PULSE_MAX_TASKS; i++)
+    {
+        const double ratio = ((double)g_runs[i] * (double)g_set[i].period) / (double)ticks;
+
+        /* Runs are at least a period apart, from the first at tick 0. */
+        check(g_runs[i] <= ((ticks / g_set[i].period) + 1u));
+        check(ratio >= 0.5);
+        if ((i == 0u) || (ratio < min_ratio))
+        {
+            min_ratio = ratio;
+        }
+        dispatches += g_runs[i];
+    }
+
+    printf("{\"lock_free\":%u,\"tick_us\":%u,\"ticks\":%u,\"dispatches\":%u,\"criticals\":%u,"
+           "\"criticals_per_tick\":%.3f,\"min_run_ratio\":%.3f,\"violations\":%u}\n",
+           (unsigned)PULSE_CFG_LOCK_FREE, (unsigned)tick_us, (unsigned)ticks, (unsigned)dispatches,
+           (unsigned)criticals, (double)criticals / (double)ticks, min_ratio, (unsigned)g_violations);
+    return (g_violations == 0u) ? 0 : 1;
+}
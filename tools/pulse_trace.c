@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2026 Paolo Oliveira. All rights reserved.
+ * Licensed under the MIT License. See LICENSE file in the project root for details.
+ * pulse_trace.c - Host-side decoder from a Pulse trace dump to Chrome trace JSON (C11)
+ *
+ * Reads the byte stream written by pulse_trace_encode(), PULSE_TRACE_WIRE_SIZE
+ * little-endian bytes per record, from a file or stdin, and writes the Chrome
+ * trace event format ({"traceEvents": [...]}) to stdout. The output loads in
+ * chrome://tracing and in the Perfetto UI (ui.perfetto.dev), which imports it.
+ *
+ *   tid 0 "cpu"      one slice per dispatch ("task N", RUN to DONE) and per
+ *                    idle sleep ("idle", IDLE to WAKE)
+ *   tid 1+N "task N" instants for each release and overrun of task N
+ *   global           instants for pulse_start() and for records lost on a
+ *                    full ring
+ *
+ * Timestamps are microseconds: tick * tick length, plus the record's
+ * PULSE_PORT_SUBTICK() value scaled by -c, the number of sub-tick counts in
+ * one tick. Without -c the sub-tick value is ignored and events land on
+ * their tick. The tick length comes from the first START record in the
+ * input, or from -t in microseconds, and defaults to 1 ms. The tick may wrap during a
+ * capture; it is unwrapped on the assumption that records arrive in order.
+ * It wraps at 32 bits, or at the width of PULSE_CFG_TICK_T on the heap and
+ * wheel backends, which -w gives.
+ *
+ * Usage: pulse_trace [-c counts_per_tick] [-t tick_us] [-w tick_bits] [file]
+ *
+ * Exit status: 0 success, 2 bad arguments or I/O error.
+ */
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Must match src/pulse.h. */
+#define TRACE_START   (0u)
+#define TRACE_RELEASE (1u)
+#define TRACE_RUN     (2u)
+#define TRACE_DONE    (3u)
+#define TRACE_OVERRUN (4u)
+#define TRACE_IDLE    (5u)
+#define TRACE_WAKE    (6u)
+#define TRACE_LOST    (7u)
+#define TRACE_NO_TASK (0xFFu)
+#define TRACE_TICK_MS (0x8000u)
+#define WIRE_SIZE     (8u)
+
+#define MAX_IDS (256u)
+
+typedef struct
+{
+    uint64_t tick; /* unwrapped */
+    uint16_t sub;
+    uint8_t  event;
+    uint8_t  id;
+} record_t;
+
+static record_t *g_recs = NULL;
+static size_t g_count = 0u;
+
+static uint64_t g_counts = 0u;  /* sub-tick counts per tick, 0 = ignore */
+static uint64_t g_tick_us = 0u; /* 0 = not given */
+static uint64_t g_tick_bits = 32u;
+
+static uint8_t g_seen[MAX_IDS];
+
+/* Open slice on the cpu track. */
+static int g_open = 0;
+static uint8_t g_open_event = 0u;
+static uint8_t g_open_id = 0u;
+
+static int g_first = 1;
+
+static int parse_u64(const char *s, uint64_t *out)
+{
+    char *end = NULL;
+    unsigned long long v;
+
+    errno = 0;
+    v = strtoull(s, &end, 10);
+    if ((errno != 0) || (end == s) || (*end != '\0') || (s[0] == '-'))
+    {
+        return -1;
+    }
+    *out = (uint64_t)v;
+    return 0;
+}
+
+static int load(FILE *f, const char *name)
+{
+    uint8_t b[WIRE_SIZE];
+    size_t cap = 0u;
+    size_t got;
+    const uint64_t range = UINT64_C(1) << g_tick_bits;
+    uint64_t last = 0u;
+    uint64_t epoch = 0u;
+
+    while ((got = fread(b, 1u, WIRE_SIZE, f)) == WIRE_SIZE)
+    {
+        record_t *r;
+        const uint64_t tick = ((uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) |
+                               ((uint32_t)b[3] << 24)) & (range - 1u);
+
+        if (g_count == cap)
+        {
+            record_t *grown;
+
+            cap = (cap == 0u) ? 1024u : (cap * 2u);
+            grown = realloc(g_recs, cap * sizeof(*g_recs));
+            if (grown == NULL)
+            {
+                fprintf(stderr, "%s: out of memory\n", name);
+                return -1;
+            }
+            g_recs = grown;
+        }
+
+        /* A step back of more than half the range is a wrap. */
+        if ((g_count != 0u) && (tick < last) && ((last - tick) > (range / 2u)))
+        {
+            epoch += range;
+        }
+        last = tick;
+
+        r = &g_recs[g_count];
+        r->tick = epoch + tick;
+        r->sub = (uint16_t)((uint16_t)b[4] | (uint16_t)((uint16_t)b[5] << 8));
+        r->event = b[6];
+        r->id = b[7];
+        g_count++;
+    }
+
+    if (ferror(f) != 0)
+    {
+        fprintf(stderr, "%s: %s\n", name, strerror(errno));
+        return -1;
+    }
+    if (got != 0u)
+    {
+        fprintf(stderr, "%s: warning: ignoring %zu trailing bytes\n", name, got);
+    }
+    return 0;
+}
+
+/* START's sub is the tick in microseconds, or in milliseconds when flagged. */
+static uint64_t start_tick_us(uint16_t sub)
+{
+    if ((sub & TRACE_TICK_MS) != 0u)
+    {
+        return (uint64_t)(sub & (uint16_t)~TRACE_TICK_MS) * 1000u;
+    }
+    return sub;
+}
+
+static double timestamp_us(const record_t *r)
+{
+    const double tick_us = (double)g_tick_us;
+    double us = (double)r->tick * tick_us;
+
+    /* START carries the tick length in place of a sub-tick value. */
+    if ((g_counts != 0u) && (r->event != TRACE_START))
+    {
+        us += ((double)r->sub * tick_us) / (double)g_counts;
+    }
+    return us;
+}
+
+static void begin_event(void)
+{
+    printf("%s\n    ", (g_first != 0) ? "" : ",");
+    g_first = 0;
+}
+
+static void task_name(uint8_t id)
+{
+    printf("task %u", (unsigned)id);
+}
+
+static void slice(const char *ph, uint8_t event, uint8_t id, double ts)
+{
+    begin_event();
+    printf("{\"name\":\"");
+    if (event == TRACE_IDLE)
+    {
+        printf("idle");
+    }
+    else
+    {
+        task_name(id);
+    }
+    printf("\",\"ph\":\"%s\",\"ts\":%.3f,\"pid\":0,\"tid\":0}", ph, ts);
+}
+
+static void close_open(double ts)
+{
+    if (g_open != 0)
+    {
+        slice("E", g_open_event, g_open_id, ts);
+        g_open = 0;
+    }
+}
+
+static void open_slice(uint8_t event, uint8_t id, double ts)
+{
+    close_open(ts);
+    slice("B", event, id, ts);
+    g_open = 1;
+    g_open_event = event;
+    g_open_id = id;
+}
+
+static void instant(const char *name, const char *scope, unsigned tid, double ts,
+                    const char *arg, unsigned value)
+{
+    begin_event();
+    printf("{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"%s\",\"ts\":%.3f,\"pid\":0,\"tid\":%u", name,
+           scope, ts, tid);
+    if (arg != NULL)
+    {
+        printf(",\"args\":{\"%s\":%u}", arg, value);
+    }
+    printf("}");
+}
+
+static void thread_name(unsigned tid, uint8_t id)
+{
+    begin_event();
+    printf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"", tid);
+    if (tid == 0u)
+    {
+        printf("cpu");
+    }
+    else
+    {
+        task_name(id);
+    }
+    printf("\"}}");
+}
+
+static void emit(void)
+{
+    double ts = 0.0;
+    size_t i;
+    uint32_t id;
+
+    printf("{\"traceEvents\": [");
+    for (i = 0u; i < g_count; i++)
+    {
+        const record_t *r = &g_recs[i];
+
+        ts = timestamp_us(r);
+        switch (r->event)
+        {
+        case TRACE_START:
+            instant("start", "g", 0u, ts, "tick_us", (unsigned)start_tick_us(r->sub));
+            break;
+        case TRACE_RELEASE:
+            g_seen[r->id] = 1u;
+            instant("release", "t", 1u + r->id, ts, NULL, 0u);
+            break;
+        case TRACE_RUN:
+        case TRACE_IDLE:
+            open_slice(r->event, r->id, ts);
+            break;
+        case TRACE_DONE:
+            if ((g_open != 0) && (g_open_event == TRACE_RUN) && (g_open_id == r->id))
+            {
+                close_open(ts);
+            }
+            break;
+        case TRACE_WAKE:
+            if ((g_open != 0) && (g_open_event == TRACE_IDLE))
+            {
+                close_open(ts);
+            }
+            break;
+        case TRACE_OVERRUN:
+            g_seen[r->id] = 1u;
+            instant("overrun", "t", 1u + r->id, ts, "missed", r->sub);
+            break;
+        case TRACE_LOST:
+            instant("lost", "g", 0u, ts, "dropped", r->sub);
+            break;
+        default:
+            fprintf(stderr, "record %zu: unknown event %u\n", i, (unsigned)r->event);
+            break;
+        }
+    }
+    close_open(ts);
+
+    thread_name(0u, 0u);
+    for (id = 0u; id < MAX_IDS; id++)
+    {
+        if ((g_seen[id] != 0u) && (id != TRACE_NO_TASK))
+        {
+            thread_name(1u + id, (uint8_t)id);
+        }
+    }
+    printf("\n]}\n");
+}
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr, "usage: %s [-c counts_per_tick] [-t tick_us] [-w tick_bits] [file]\n", argv0);
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = NULL;
+    FILE *f = stdin;
+    size_t i;
+    int a;
+    int rc;
+
+    for (a = 1; a < argc; a++)
+    {
+        if (((strcmp(argv[a], "-c") == 0) || (strcmp(argv[a], "-t") == 0) || (strcmp(argv[a], "-w") == 0)) &&
+            ((a + 1) < argc))
+        {
+            uint64_t *dst = (argv[a][1] == 'c') ? &g_counts : ((argv[a][1] == 't') ? &g_tick_us : &g_tick_bits);
+
+            if ((parse_u64(argv[a + 1], dst) != 0) || (g_tick_bits < 8u) || (g_tick_bits > 32u))
+            {
+                usage(argv[0]);
+                return 2;
+            }
+            a++;
+        }
+        else if ((argv[a][0] != '-') && (path == NULL))
+        {
+            path = argv[a];
+        }
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (path != NULL)
+    {
+        f = fopen(path, "rb");
+        if (f == NULL)
+        {
+            fprintf(stderr, "%s: %s\n", path, strerror(errno));
+            return 2;
+        }
+    }
+
+    rc = load(f, (path != NULL) ? path : "<stdin>");
+    if (path != NULL)
+    {
+        (void)fclose(f);
+    }
+    if (rc != 0)
+    {
+        free(g_recs);
+        return 2;
+    }
+
+    for (i = 0u; (i < g_count) && (g_tick_us == 0u); i++)
+    {
+        if (g_recs[i].event == TRACE_START)
+        {
+            g_tick_us = start_tick_us(g_recs[i].sub);
+        }
+    }
+    if (g_tick_us == 0u)
+    {
+        g_tick_us = 1000u;
+    }
+
+    emit();
+    free(g_recs);
+    return 0;
+}